@@ -869,6 +869,26 @@ TEST(rfcMgrTest, set_RFCProperty) {
     delete rfcObj;
 }
 
+TEST(rfcMgrTest, set_RFCProperties) {
+    RuntimeFeatureControlProcessor *rfcObj = new RuntimeFeatureControlProcessor();
+    std::string name = "rfc";
+    std::vector<std::pair<std::string, std::string>> keyValues;
+    keyValues.emplace_back("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Control.XconfUrl", "https://rdkautotool.ccp.xcal.tv/featureControl/getSettings");
+    keyValues.emplace_back("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Control.XconfSelector", "automation");
+    writeToTr181storeFile(keyValues[0].first, keyValues[0].second, "/opt/secure/RFC/tr181store.ini", Quoted);
+    writeToTr181storeFile(keyValues[1].first, keyValues[1].second, "/opt/secure/RFC/tr181store.ini", Quoted);
+    std::vector<WDMP_STATUS> statuses;
+    rfcObj->set_RFCProperties(name, keyValues, statuses);
+    ASSERT_EQ(statuses.size(), 2);
+    EXPECT_EQ(statuses[0], WDMP_SUCCESS);
+    EXPECT_EQ(statuses[1], WDMP_SUCCESS);
+
+    keyValues.clear();
+    rfcObj->set_RFCProperties(name, keyValues, statuses);
+    EXPECT_TRUE(statuses.empty());
+    delete rfcObj;
+}
+
 TEST(rfcMgrTest, GetXconfSelect) {
     RuntimeFeatureControlProcessor *rfcObj = new RuntimeFeatureControlProcessor();
     rfcObj->_RFCKeyAndValueMap[XCONF_URL_KEY_STR] = "https://xconf.xdp.eu-1.xcal.tv";
@@ -21,14 +21,31 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <unistd.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <iostream>
 #include <cstdio>
 #include <fstream>
+#include <iterator>
 #include <string>
 #include <iostream>
+#include <vector>
+#include <utility>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <thread>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <curl/curl.h>
 #include "rfcapi.h"
+#include "rfcapi_hostif.h"
+#include "rfcapi_internal.h"
+#include "rfcflag.h"
 #include "tr181_store_writer.h"
 
 using namespace std;
@@ -37,6 +54,12 @@ using namespace std;
 #ifdef GTEST_ENABLE
 extern size_t (*getWriteCurlResponse(void))(void *ptr, size_t size, size_t nmemb, std::string stream);
 #endif
+extern std::string simulated_response_body;
+extern std::string simulated_request_body;
+extern std::string simulated_unix_socket_path;
+extern CURLcode simulated_unix_socket_result;
+extern CURLcode simulated_curl_result;
+extern long simulated_timeout_ms;
 
 TEST(rfcapiTest, init_rfcdefaults) {
     bool result = init_rfcdefaults();
@@ -80,6 +103,184 @@ TEST(rfcapiTest, getRFCParameter_rfcdefault) {
     EXPECT_STREQ(pstParamData.value, "12800");
 }
 
+TEST(rfcapiTest, getRFCParameter_fallbackChain) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.ChainTest.Url";
+    RFC_ParamData_t pstParamData;
+    // An empty override does not hide the bootstrap value.
+    writeToTr181storeFile(pcParameterName, "", "/opt/secure/RFC/tr181store.ini", Plain);
+    writeToTr181storeFile(pcParameterName, "https://bootstrap", "/opt/secure/RFC/bootstrap.ini", Plain);
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcParameterName, &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "https://bootstrap");
+    EXPECT_EQ(pstParamData.type, WDMP_NONE);
+
+    // Rewriting a store file is picked up by the next lookup.
+    writeToTr181storeFile(pcParameterName, "https://override", "/opt/secure/RFC/tr181store.ini", Plain);
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcParameterName, &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "https://override");
+
+    write_on_file(RFCVAR_FILE, "export RFC_ENABLE_CHAINTEST=true");
+    write_on_file(RFCVAR_FILE, "export RFC_EMPTY_CHAINTEST=");
+    EXPECT_EQ(getRFCParameter("rfcdefaults", "RFC_ENABLE_CHAINTEST", &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "true");
+    EXPECT_EQ(getRFCParameter("rfcdefaults", "RFC_EMPTY_CHAINTEST", &pstParamData), WDMP_ERR_VALUE_IS_EMPTY);
+    EXPECT_EQ(getRFCParameter("rfcdefaults", "RFC_MISSING_CHAINTEST", &pstParamData), WDMP_FAILURE);
+}
+
+TEST(rfcapiTest, getRFCParameters_fallback) {
+    const char* names[] = {
+        "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.LogUpload.LogServerUrl",
+        "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.SWDLSpLimit.LowSpeed",
+        "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.NotInAnyStore.Enable",
+        "Device.DeviceInfo."
+    };
+    RFC_ParamData_t params[4];
+    WDMP_STATUS status[4];
+    WDMP_STATUS result = getRFCParameters("rfcdefaults", names, 4, params, status);
+    EXPECT_EQ(status[0], WDMP_SUCCESS);
+    EXPECT_STREQ(params[0].value, "logs.xcal.tv");
+    EXPECT_EQ(status[1], WDMP_SUCCESS);
+    EXPECT_STREQ(params[1].value, "12800");
+    EXPECT_EQ(status[2], WDMP_FAILURE);
+    EXPECT_EQ(status[3], WDMP_FAILURE);
+    EXPECT_EQ(result, WDMP_FAILURE);
+    EXPECT_EQ(getRFCParameters("rfcdefaults", NULL, 4, params, status), WDMP_FAILURE);
+}
+
+static void collectRFCParam(const RFC_ParamData_t *pstParam, void *pUserData) {
+    static_cast<std::vector<std::pair<std::string, std::string>> *>(pUserData)->emplace_back(pstParam->name, pstParam->value);
+}
+
+TEST(rfcapiTest, getRFCParameterTree_fallback) {
+    const char* prefix = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.TreeTest.";
+    writeToTr181storeFile("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.TreeTest.Enable", "true", "/opt/secure/RFC/tr181store.ini", Plain);
+    writeToTr181storeFile("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.TreeTest.Url", "https://bootstrap", "/opt/secure/RFC/bootstrap.ini", Plain);
+    writeToTr181storeFile("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.TreeTestOther.Enable", "true", "/opt/secure/RFC/tr181store.ini", Plain);
+    std::vector<std::pair<std::string, std::string>> found;
+    EXPECT_EQ(getRFCParameterTree("rfcdefaults", prefix, collectRFCParam, &found), WDMP_SUCCESS);
+    ASSERT_EQ(found.size(), 2);
+    EXPECT_EQ(found[0].first, "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.TreeTest.Enable");
+    EXPECT_EQ(found[0].second, "true");
+    EXPECT_EQ(found[1].second, "https://bootstrap");
+
+    // tr181store.ini overrides bootstrap.ini, and file updates are picked up.
+    writeToTr181storeFile("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.TreeTest.Url", "https://override", "/opt/secure/RFC/tr181store.ini", Plain);
+    found.clear();
+    EXPECT_EQ(getRFCParameterTree("rfcdefaults", prefix, collectRFCParam, &found), WDMP_SUCCESS);
+    ASSERT_EQ(found.size(), 2);
+    EXPECT_EQ(found[1].second, "https://override");
+
+    found.clear();
+    EXPECT_EQ(getRFCParameterTree("rfcdefaults", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.NoSuchTree.", collectRFCParam, &found), WDMP_FAILURE);
+    EXPECT_EQ(getRFCParameterTree("rfcdefaults", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.TreeTest", collectRFCParam, &found), WDMP_FAILURE);
+    EXPECT_TRUE(found.empty());
+}
+
+TEST(rfcapiTest, getRFCDefaultValue_snapshot) {
+    const std::string name = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.SnapshotTest.Url";
+    RFC_ParamData_t pstParamData;
+    EXPECT_EQ(system((std::string("mkdir -p ") + RFCDEFAULTS_ETC_DIR).c_str()), 0);
+    write_on_file("/etc/rfcdefaults/zz_snapshot.ini", name + "=https://zz");
+    write_on_file("/etc/rfcdefaults/aa_snapshot.ini", name + "=https://aa two words");
+
+    // A name defined by two features resolves to the first file in sorted order.
+    EXPECT_EQ(getRFCParameter("rfcdefaults", name.c_str(), &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "https://aa two words");
+    EXPECT_EQ(getRFCDefaultValue(NULL, name.c_str(), &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "https://aa two words");
+    EXPECT_EQ(getRFCDefaultValue("zz_snapshot", name.c_str(), &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "https://zz");
+    EXPECT_EQ(pstParamData.type, WDMP_NONE);
+
+    EXPECT_EQ(getRFCDefaultValue("zz_snapshot", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.SnapshotTest.Missing", &pstParamData), WDMP_FAILURE);
+    EXPECT_EQ(getRFCDefaultValue("no_such_component", name.c_str(), &pstParamData), WDMP_ERR_UNKNOWN_COMPONENT);
+    EXPECT_EQ(access(RFCDEFAULTS_SNAPSHOT_FILE, F_OK), 0);
+
+    // A file the compiler never reads does not make every lookup recompile.
+    EXPECT_EQ(system((std::string("mkdir -p ") + RFCDEFAULTS_ETC_DIR + "sub").c_str()), 0);
+    write_on_file("/etc/rfcdefaults/sub/nested.ini", name + "=https://nested");
+    EXPECT_EQ(getRFCDefaultValue(NULL, name.c_str(), &pstParamData), WDMP_SUCCESS);
+    struct stat before, after;
+    ASSERT_EQ(stat(RFCDEFAULTS_SNAPSHOT_FILE, &before), 0);
+    EXPECT_EQ(getRFCDefaultValue("sub/nested", name.c_str(), &pstParamData), WDMP_ERR_UNKNOWN_COMPONENT);
+    EXPECT_EQ(getRFCDefaultValue("sub/nested", name.c_str(), &pstParamData), WDMP_ERR_UNKNOWN_COMPONENT);
+    ASSERT_EQ(stat(RFCDEFAULTS_SNAPSHOT_FILE, &after), 0);
+    EXPECT_EQ(before.st_ino, after.st_ino);
+
+    // A snapshot anybody but root could have planted is never mapped.
+    std::string forged;
+    {
+        std::ifstream ifs(RFCDEFAULTS_SNAPSHOT_FILE, std::ios::binary);
+        forged.assign((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    }
+    size_t at = forged.find("https://aa two words");
+    ASSERT_NE(at, std::string::npos);
+    forged.replace(at, 10, "https://xx");
+    {
+        std::ofstream ofs("/tmp/rfcdefaults_forged.bin", std::ios::binary | std::ios::trunc);
+        ofs << forged;
+    }
+    unlink(RFCDEFAULTS_SNAPSHOT_FILE);
+    ASSERT_EQ(symlink("/tmp/rfcdefaults_forged.bin", RFCDEFAULTS_SNAPSHOT_FILE), 0);
+    EXPECT_EQ(getRFCDefaultValue(NULL, name.c_str(), &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "https://aa two words");
+    unlink(RFCDEFAULTS_SNAPSHOT_FILE);
+    {
+        std::ofstream ofs(RFCDEFAULTS_SNAPSHOT_FILE, std::ios::binary | std::ios::trunc);
+        ofs << forged;
+    }
+    ASSERT_EQ(chmod(RFCDEFAULTS_SNAPSHOT_FILE, 0666), 0);
+    EXPECT_EQ(getRFCDefaultValue(NULL, name.c_str(), &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "https://aa two words");
+    // Root republished a good one in its place.
+    ASSERT_EQ(lstat(RFCDEFAULTS_SNAPSHOT_FILE, &after), 0);
+    EXPECT_TRUE(S_ISREG(after.st_mode));
+    EXPECT_EQ(after.st_mode & (S_IWGRP | S_IWOTH), 0u);
+    unlink("/tmp/rfcdefaults_forged.bin");
+    EXPECT_EQ(system((std::string("rm -rf ") + RFCDEFAULTS_ETC_DIR).c_str()), 0);
+}
+
+TEST(rfcapiTest, getRFCDefaultValue_compileRetry) {
+    const std::string name = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.CompileRetry.Url";
+    RFC_ParamData_t pstParamData;
+    EXPECT_EQ(system((std::string("rm -rf ") + RFCDEFAULTS_ETC_DIR).c_str()), 0);
+
+    // Sources that cannot be compiled fail the lookup, and are not retried until they change.
+    write_on_file("/etc/rfcdefaults", "not a directory");
+    EXPECT_EQ(getRFCDefaultValue(NULL, name.c_str(), &pstParamData), WDMP_FAILURE);
+    EXPECT_EQ(getRFCDefaultValue(NULL, name.c_str(), &pstParamData), WDMP_FAILURE);
+
+    // Changing them retries at once rather than after the backoff.
+    unlink("/etc/rfcdefaults");
+    EXPECT_EQ(system((std::string("mkdir -p ") + RFCDEFAULTS_ETC_DIR).c_str()), 0);
+    write_on_file("/etc/rfcdefaults/retry.ini", name + "=https://retry");
+    EXPECT_EQ(getRFCDefaultValue(NULL, name.c_str(), &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "https://retry");
+    EXPECT_EQ(system((std::string("rm -rf ") + RFCDEFAULTS_ETC_DIR).c_str()), 0);
+}
+
+TEST(rfcapiTest, getRFCParameterValue_fallback) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.SWDLSpLimit.LowSpeed";
+    char value[8];
+    size_t len = sizeof(value);
+    DATA_TYPE type = WDMP_STRING;
+    EXPECT_EQ(getRFCParameterValue("rfcdefaults", pcParameterName, value, &len, &type), WDMP_SUCCESS);
+    EXPECT_STREQ(value, "12800");
+    EXPECT_EQ(len, 5u);
+    EXPECT_EQ(type, WDMP_NONE);
+
+    // Too small: truncated, and the length needed is reported.
+    char small[4];
+    len = sizeof(small);
+    EXPECT_EQ(getRFCParameterValue("rfcdefaults", pcParameterName, small, &len, NULL), WDMP_STATUS_RESOURCES);
+    EXPECT_EQ(len, 5u);
+    EXPECT_STREQ(small, "128");
+
+    len = sizeof(value);
+    EXPECT_EQ(getRFCParameterValue("rfcdefaults", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.NotInAnyStore.Enable", value, &len, NULL), WDMP_FAILURE);
+    len = 0;
+    EXPECT_EQ(getRFCParameterValue("rfcdefaults", pcParameterName, value, &len, NULL), WDMP_ERR_INVALID_PARAM);
+}
+
 TEST(rfcapiTest, getRFCParameter_HTTP) {
     const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
     char *pcCallerID = "rfcdefaults";
@@ -90,6 +291,759 @@ TEST(rfcapiTest, getRFCParameter_HTTP) {
     EXPECT_EQ(result, WDMP_SUCCESS);
 }
 
+TEST(rfcapiTest, getRFCParameterValue_HTTP) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    char value[8];
+    size_t len = sizeof(value);
+    DATA_TYPE type = WDMP_NONE;
+    EXPECT_EQ(getRFCParameterValue("rfcdefaults", pcParameterName, value, &len, &type), WDMP_SUCCESS);
+    EXPECT_STREQ(value, "true");
+    EXPECT_EQ(len, 4u);
+    EXPECT_EQ(type, WDMP_BOOLEAN);
+
+    char small[2];
+    len = sizeof(small);
+    EXPECT_EQ(getRFCParameterValue("rfcdefaults", pcParameterName, small, &len, NULL), WDMP_STATUS_RESOURCES);
+    EXPECT_EQ(len, 4u);
+    EXPECT_STREQ(small, "t");
+}
+
+TEST(rfcapiTest, getRFCParameter_unixSocket) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    const char* socketPath = "/tmp/rfcapi_gtest.sock";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    RFC_ParamData_t pstParamData;
+
+    // Configured but not created yet: TCP.
+    unlink(socketPath);
+    setRFCHostifSocket(socketPath);
+    simulated_unix_socket_path.clear();
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcParameterName, &pstParamData), WDMP_SUCCESS);
+    EXPECT_TRUE(simulated_unix_socket_path.empty());
+
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(fd, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketPath, sizeof(addr.sun_path) - 1);
+    ASSERT_EQ(bind(fd, (struct sockaddr *)&addr, sizeof(addr)), 0);
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcParameterName, &pstParamData), WDMP_SUCCESS);
+    EXPECT_EQ(simulated_unix_socket_path, socketPath);
+    EXPECT_STREQ(pstParamData.value, "true");
+
+    // A refused connection is retried over TCP, and TCP stays in use for a while.
+    simulated_unix_socket_result = CURLE_COULDNT_CONNECT;
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcParameterName, &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "true");
+    simulated_unix_socket_path.clear();
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcParameterName, &pstParamData), WDMP_SUCCESS);
+    EXPECT_TRUE(simulated_unix_socket_path.empty());
+    simulated_unix_socket_result = CURLE_OK;
+
+    setRFCHostifSocket(NULL);
+    close(fd);
+    unlink(socketPath);
+}
+
+TEST(rfcapiTest, getRFCParameter_hostifRestart) {
+    const char* pcStoreName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.LogUpload.LogServerUrl";
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    ASSERT_TRUE(waitForRFCHostifReady(0));
+    RFC_ParamData_t pstParamData;
+
+    // A refused connection falls back to the store files for this and later calls.
+    simulated_curl_result = CURLE_COULDNT_CONNECT;
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcStoreName, &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "logs.xcal.tv");
+    simulated_curl_result = CURLE_OK;
+    EXPECT_FALSE(waitForRFCHostifReady(0));
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcStoreName, &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "logs.xcal.tv");
+    EXPECT_EQ(pstParamData.type, WDMP_NONE);
+
+    // hostif rewriting its marker after the restart makes it usable again.
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcParameterName, &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "true");
+    EXPECT_EQ(pstParamData.type, WDMP_BOOLEAN);
+}
+
+TEST(rfcapiTest, setRFCParameter_writeBehind) {
+    const char* pcFirst = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.WriteBehindA.Enable";
+    const char* pcSecond = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.WriteBehindB.Enable";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    ASSERT_TRUE(waitForRFCHostifReady(0));
+    setRFCWriteBehindEnabled(true);
+    RFC_ParamData_t pstParamData;
+
+    // A refused set is queued, and so is every set until hostif is back.
+    simulated_curl_result = CURLE_COULDNT_CONNECT;
+    EXPECT_EQ(setRFCParameter("rfcwritebehind", pcFirst, "true", WDMP_BOOLEAN), WDMP_SUCCESS);
+    simulated_curl_result = CURLE_OK;
+    EXPECT_FALSE(waitForRFCHostifReady(0));
+    simulated_request_body.clear();
+    EXPECT_EQ(setRFCParameter("rfcwritebehind", pcSecond, "false", WDMP_BOOLEAN), WDMP_SUCCESS);
+    EXPECT_TRUE(simulated_request_body.empty());
+    EXPECT_EQ(getRFCWriteBehindPending(), 2u);
+
+    // Queued values are read back before the store files.
+    EXPECT_EQ(getRFCParameter("rfcwritebehind", pcSecond, &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "false");
+    EXPECT_EQ(pstParamData.type, WDMP_BOOLEAN);
+    const char* names[] = { pcFirst, pcSecond };
+    RFC_ParamData_t params[2];
+    WDMP_STATUS status[2];
+    EXPECT_EQ(getRFCParameters("rfcwritebehind", names, 2, params, status), WDMP_SUCCESS);
+    EXPECT_STREQ(params[0].value, "true");
+    EXPECT_STREQ(params[1].value, "false");
+    EXPECT_EQ(params[1].type, WDMP_BOOLEAN);
+
+    // Once hostif is ready both go out in one request, in order.
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    EXPECT_TRUE(flushRFCWriteBehind(5000));
+    EXPECT_EQ(getRFCWriteBehindPending(), 0u);
+    size_t first = simulated_request_body.find(pcFirst);
+    size_t second = simulated_request_body.find(pcSecond);
+    EXPECT_NE(first, std::string::npos);
+    EXPECT_NE(second, std::string::npos);
+    EXPECT_LT(first, second);
+
+    // A damaged tail is dropped without losing the records before it.
+    setRFCWriteBehindEnabled(false);
+    simulated_curl_result = CURLE_COULDNT_CONNECT;
+    EXPECT_NE(setRFCParameter("rfcwritebehind", pcFirst, "true", WDMP_BOOLEAN), WDMP_SUCCESS);
+    simulated_curl_result = CURLE_OK;
+    EXPECT_EQ(getRFCWriteBehindPending(), 0u);
+    setRFCWriteBehindEnabled(true);
+    EXPECT_EQ(setRFCParameter("rfcwritebehind", pcFirst, "true", WDMP_BOOLEAN), WDMP_SUCCESS);
+    write_on_file("/opt/secure/RFC/rfcapi_setjournal.bin", "torn");
+    EXPECT_EQ(getRFCWriteBehindPending(), 1u);
+    // A set queued after the damage is neither hidden behind it nor lost by the replay.
+    EXPECT_FALSE(waitForRFCHostifReady(0));
+    EXPECT_EQ(setRFCParameter("rfcwritebehind", pcSecond, "true", WDMP_BOOLEAN), WDMP_SUCCESS);
+    EXPECT_EQ(getRFCWriteBehindPending(), 2u);
+    EXPECT_EQ(getRFCParameter("rfcwritebehind", pcSecond, &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "true");
+    simulated_request_body.clear();
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    EXPECT_TRUE(flushRFCWriteBehind(5000));
+    EXPECT_EQ(getRFCWriteBehindPending(), 0u);
+    EXPECT_NE(simulated_request_body.find(pcSecond), std::string::npos);
+    setRFCWriteBehindEnabled(false);
+}
+
+TEST(rfcapiTest, setRFCParameter_writeBehindAfterFork) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.WriteBehindFork.Enable";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    ASSERT_TRUE(waitForRFCHostifReady(0));
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        // The parent's replay thread is gone: the child's queued set is sent by one of its own.
+        setRFCWriteBehindEnabled(true);
+        simulated_curl_result = CURLE_COULDNT_CONNECT;
+        if (setRFCParameter("rfcwritebehind", pcParameterName, "true", WDMP_BOOLEAN) != WDMP_SUCCESS)
+            _exit(2);
+        simulated_curl_result = CURLE_OK;
+        write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+        for (int i = 0; i < 100 && getRFCWriteBehindPending() != 0; i++)
+            usleep(100 * 1000);
+        _exit(getRFCWriteBehindPending() == 0 ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_EQ(getRFCWriteBehindPending(), 0u);
+}
+
+TEST(rfcapiTest, waitForRFCHostifReady) {
+    RFC_ParamData_t pstParamData;
+    simulated_curl_result = CURLE_COULDNT_CONNECT;
+    getRFCParameter("rfcdefaults", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable", &pstParamData);
+    simulated_curl_result = CURLE_OK;
+    unlink("/tmp/.tr69hostif_http_server_ready");
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    EXPECT_FALSE(waitForRFCHostifReady(50));
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(50));
+
+    std::thread hostif([]() {
+        usleep(100000);
+        write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    });
+    EXPECT_TRUE(waitForRFCHostifReady(5000));
+    hostif.join();
+}
+
+TEST(rfcapiTest, waitForRFCHostifReady_afterFork) {
+    RFC_ParamData_t pstParamData;
+    simulated_curl_result = CURLE_COULDNT_CONNECT;
+    getRFCParameter("rfcdefaults", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable", &pstParamData);
+    simulated_curl_result = CURLE_OK;
+    unlink("/tmp/.tr69hostif_http_server_ready");
+    ASSERT_FALSE(waitForRFCHostifReady(0));
+
+    int gate[2];
+    ASSERT_EQ(pipe(gate), 0);
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        close(gate[1]);
+        char c;
+        if (read(gate[0], &c, 1) != 1)
+            _exit(2);
+        // The parent has already read the marker event from the queue it shared with us.
+        _exit(waitForRFCHostifReady(1000) ? 0 : 1);
+    }
+    close(gate[0]);
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    EXPECT_TRUE(waitForRFCHostifReady(5000));
+    EXPECT_EQ(write(gate[1], "x", 1), 1);
+    close(gate[1]);
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
+TEST(rfcapiTest, getRFCParameterWithDeadline) {
+    const char* pcStoreName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.LogUpload.LogServerUrl";
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    ASSERT_TRUE(waitForRFCHostifReady(0));
+    RFC_ParamData_t pstParamData;
+    bool stale = true;
+
+    EXPECT_EQ(getRFCParameterWithDeadline("rfcdefaults", pcParameterName, &pstParamData, 50, &stale), WDMP_SUCCESS);
+    EXPECT_FALSE(stale);
+    EXPECT_STREQ(pstParamData.value, "true");
+    EXPECT_EQ(pstParamData.type, WDMP_BOOLEAN);
+    EXPECT_GT(simulated_timeout_ms, 0);
+    EXPECT_LE(simulated_timeout_ms, 50);
+
+    // A missed deadline returns the persisted value, marked stale.
+    simulated_curl_result = CURLE_OPERATION_TIMEDOUT;
+    EXPECT_EQ(getRFCParameterWithDeadline("rfcdefaults", pcStoreName, &pstParamData, 50, &stale), WDMP_ERR_TIMEOUT);
+    EXPECT_TRUE(stale);
+    EXPECT_STREQ(pstParamData.value, "logs.xcal.tv");
+    EXPECT_EQ(pstParamData.type, WDMP_NONE);
+    EXPECT_EQ(getRFCParameterWithDeadline("rfcdefaults", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.NotInAnyStore.Enable", &pstParamData, 50, &stale), WDMP_ERR_TIMEOUT);
+    EXPECT_FALSE(stale);
+    simulated_curl_result = CURLE_OK;
+
+    // A slow hostif is still a live one.
+    EXPECT_TRUE(waitForRFCHostifReady(0));
+}
+
+static void warmRFCCache(const char *pcParameterName, RFC_ParamData_t *pstParamData, RFC_CacheStats_t *stats) {
+    RFC_CacheStats_t before;
+    getRFCCacheStats(&before);
+    *stats = before;
+    // The store watcher arms asynchronously; until then every lookup is a miss.
+    for (int i = 0; i < 200 && stats->hits == before.hits; i++) {
+        getRFCParameter("rfcdefaults", pcParameterName, pstParamData);
+        getRFCParameter("rfcdefaults", pcParameterName, pstParamData);
+        getRFCCacheStats(stats);
+        if (stats->hits == before.hits)
+            usleep(10000);
+    }
+}
+
+TEST(rfcapiTest, getRFCParameter_cache) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    setRFCCacheTTL(60000);
+    RFC_ParamData_t pstParamData;
+    RFC_CacheStats_t stats;
+    warmRFCCache(pcParameterName, &pstParamData, &stats);
+    EXPECT_GT(stats.hits, 0UL);
+    EXPECT_GT(stats.misses, 0UL);
+    EXPECT_EQ(stats.entries, 1UL);
+    EXPECT_STREQ(pstParamData.value, "true");
+
+    // A successful set from this process invalidates the cache.
+    EXPECT_EQ(setRFCParameter("rfcdefaults", pcParameterName, "false", WDMP_BOOLEAN), WDMP_SUCCESS);
+    RFC_CacheStats_t afterSet;
+    getRFCParameter("rfcdefaults", pcParameterName, &pstParamData);
+    getRFCCacheStats(&afterSet);
+    EXPECT_EQ(afterSet.hits, stats.hits);
+    EXPECT_EQ(afterSet.misses, stats.misses + 1);
+
+    setRFCCacheTTL(0);
+    getRFCCacheStats(&stats);
+    EXPECT_EQ(stats.entries, 0UL);
+}
+
+TEST(rfcapiTest, getRFCParameter_cacheStoreFileChange) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    setRFCCacheTTL(60000);
+    RFC_ParamData_t pstParamData;
+    RFC_CacheStats_t stats;
+    warmRFCCache(pcParameterName, &pstParamData, &stats);
+    ASSERT_GT(stats.entries, 0UL);
+
+    // rfcMgr/hostif rewriting tr181store.ini must drop the cached entries.
+    writeToTr181storeFile(pcParameterName, "false", "/opt/secure/RFC/tr181store.ini", Plain);
+    RFC_CacheStats_t after = stats;
+    for (int i = 0; i < 200 && after.invalidations == stats.invalidations; i++) {
+        getRFCParameter("rfcdefaults", pcParameterName, &pstParamData);
+        getRFCCacheStats(&after);
+        if (after.invalidations == stats.invalidations)
+            usleep(10000);
+    }
+    EXPECT_GT(after.invalidations, stats.invalidations);
+    setRFCCacheTTL(0);
+}
+
+static std::string airplayModeBody(const char *value) {
+    return std::string(R"({
+  "parameters": [{
+    "name": "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable",
+    "value": "true",
+    "dataType": 3,
+    "parameterCount": 2,
+    "message": "Success"
+  }, {
+    "name": "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Mode",
+    "value": ")") + value + R"(",
+    "dataType": 0,
+    "parameterCount": 2,
+    "message": "Success"
+  }],
+  "statusCode": 0
+})";
+}
+
+static void waitForRFCValue(const char *pcParameterName, const char *expected, RFC_ParamData_t *pstParamData) {
+    // The store watcher arms and reports changes asynchronously.
+    for (int i = 0; i < 200; i++) {
+        getRFCParameter("rfcdefaults", pcParameterName, pstParamData);
+        if (strcmp(pstParamData->value, expected) == 0)
+            return;
+        usleep(10000);
+    }
+}
+
+TEST(rfcapiTest, publishRFCSnapshot_plantedFile) {
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    std::string saved = simulated_response_body;
+    simulated_response_body = airplayModeBody("auto");
+    mkdir("/run/rfc", 0755);
+    const std::string junk(256, 'x');
+    auto readFile = [](const char *path) {
+        std::ifstream ifs(path);
+        return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+    };
+
+    // A symlink at the snapshot path is replaced, never written through.
+    write_on_file("/tmp/rfcsnapshot_victim", junk.c_str());
+    std::string victimBefore = readFile("/tmp/rfcsnapshot_victim");
+    unlink("/run/rfc/rfcsnapshot.bin");
+    ASSERT_EQ(symlink("/tmp/rfcsnapshot_victim", "/run/rfc/rfcsnapshot.bin"), 0);
+    ASSERT_EQ(publishRFCSnapshot("rfcdefaults"), WDMP_SUCCESS);
+    EXPECT_EQ(readFile("/tmp/rfcsnapshot_victim"), victimBefore);
+    struct stat st;
+    ASSERT_EQ(lstat("/run/rfc/rfcsnapshot.bin", &st), 0);
+    EXPECT_TRUE(S_ISREG(st.st_mode));
+
+    // A file that is not a snapshot is not flagged as superseded.
+    unlink("/run/rfc/rfcsnapshot.bin");
+    write_on_file("/run/rfc/rfcsnapshot.bin", junk.c_str());
+    unlink("/run/rfc/planted");
+    ASSERT_EQ(link("/run/rfc/rfcsnapshot.bin", "/run/rfc/planted"), 0);
+    std::string plantedBefore = readFile("/run/rfc/planted");
+    ASSERT_EQ(publishRFCSnapshot("rfcdefaults"), WDMP_SUCCESS);
+    EXPECT_EQ(readFile("/run/rfc/planted"), plantedBefore);
+
+    unlink("/run/rfc/planted");
+    unlink("/tmp/rfcsnapshot_victim");
+    unlink("/run/rfc/rfcsnapshot.bin");
+    simulated_response_body = saved;
+}
+
+TEST(rfcapiTest, getRFCParameter_snapshot) {
+    const char* pcModeName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Mode";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    std::string saved = simulated_response_body;
+    unlink("/run/rfc/rfcsnapshot.bin");
+    simulated_response_body = airplayModeBody("auto");
+    ASSERT_EQ(publishRFCSnapshot("rfcdefaults"), WDMP_SUCCESS);
+    setRFCSnapshotEnabled(true);
+
+    // hostif now answers differently, so a value of "auto" can only come from the snapshot.
+    simulated_response_body = airplayModeBody("hostif");
+    RFC_ParamData_t pstParamData;
+    waitForRFCValue(pcModeName, "auto", &pstParamData);
+    EXPECT_STREQ(pstParamData.value, "auto");
+    EXPECT_EQ(pstParamData.type, WDMP_STRING);
+    const char* names[] = { pcModeName };
+    WDMP_STATUS status[1];
+    EXPECT_EQ(getRFCParameters("rfcdefaults", names, 1, &pstParamData, status), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "auto");
+
+    // Names outside the snapshot still go to hostif.
+    EXPECT_EQ(getRFCParameter("rfcdefaults", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Other.Mode", &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "hostif");
+
+    // A newer snapshot replaces the mapped one.
+    simulated_response_body = airplayModeBody("manual");
+    ASSERT_EQ(publishRFCSnapshot("rfcdefaults"), WDMP_SUCCESS);
+    simulated_response_body = airplayModeBody("hostif");
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcModeName, &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "manual");
+
+    // Once the store changes after the snapshot was taken, hostif is asked again.
+    writeToTr181storeFile(pcModeName, "local", "/opt/secure/RFC/tr181store.ini", Plain);
+    waitForRFCValue(pcModeName, "hostif", &pstParamData);
+    EXPECT_STREQ(pstParamData.value, "hostif");
+
+    setRFCSnapshotEnabled(false);
+    simulated_response_body = saved;
+    unlink("/run/rfc/rfcsnapshot.bin");
+}
+
+static std::string singleParamBody(const char *name, const char *value, int dataType) {
+    return std::string(R"({"parameters": [{"name": ")") + name + R"(", "value": ")" + value +
+           R"(", "dataType": )" + std::to_string(dataType) + R"(, "parameterCount": 1, "message": "Success"}], "statusCode": 0})";
+}
+
+TEST(rfcapiTest, rfcFlag) {
+    constexpr rfc::Name airplayName("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable");
+    static_assert(airplayName.key == rfc::hash("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable"), "key is a constant");
+    static_assert(rfc::hash("") == RFC_HASH_SEED, "FNV-1a offset basis");
+    EXPECT_EQ(airplayName.key, rfcHash(airplayName.str, strlen(airplayName.str)));
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    std::string saved = simulated_response_body;
+    for (int i = 0; i < 200 && getRFCStoreGeneration() == 0; i++)
+        usleep(10000);
+    ASSERT_NE(getRFCStoreGeneration(), 0UL);
+
+    static rfc::Flag<> airplay(airplayName);
+    EXPECT_EQ(airplay.key(), airplayName.key);
+    simulated_response_body = singleParamBody(airplayName.str, "true", 3);
+    EXPECT_TRUE(airplay);
+
+    // Served from the parsed value until the store generation moves.
+    simulated_response_body = singleParamBody(airplayName.str, "false", 3);
+    EXPECT_TRUE(airplay.get());
+    EXPECT_EQ(setRFCParameter("rfcdefaults", airplayName.str, "false", WDMP_BOOLEAN), WDMP_SUCCESS);
+    EXPECT_FALSE(airplay.get());
+
+    const char *retriesName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Retries";
+    rfc::Param<int> retries(retriesName, 3);
+    simulated_response_body = singleParamBody(retriesName, "42", 1);
+    EXPECT_EQ(retries.get(), 42);
+    rfc::Param<unsigned char> small(retriesName, 7);
+    simulated_response_body = singleParamBody(retriesName, "300", 1);
+    EXPECT_EQ(small.get(), 7);
+    rfc::Param<int> malformed(retriesName, 3);
+    simulated_response_body = singleParamBody(retriesName, "12abc", 1);
+    EXPECT_EQ(malformed.get(), 3);
+
+    const char *modeName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Mode";
+    rfc::Param<std::string> mode(modeName, "off");
+    rfc::Param<double> ratio(modeName, 0.5);
+    simulated_response_body = singleParamBody(modeName, "1.25", 0);
+    EXPECT_EQ(mode.get(), "1.25");
+    EXPECT_DOUBLE_EQ(ratio.get(), 1.25);
+
+    // A failed read is retried shortly instead of keeping the fallback until the generation moves.
+    const char *timeoutName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Timeout";
+    rfc::Param<int> timeout(timeoutName, 5);
+    rfc::Param<std::string> timeoutText(timeoutName, "none");
+    simulated_curl_result = CURLE_OPERATION_TIMEDOUT;
+    EXPECT_EQ(timeout.get(), 5);
+    EXPECT_EQ(timeoutText.get(), "none");
+    simulated_curl_result = CURLE_OK;
+    simulated_response_body = singleParamBody(timeoutName, "9", 1);
+    usleep((RFCFLAG_RETRY_INTERVAL + 100) * 1000);
+    EXPECT_EQ(timeout.get(), 9);
+    EXPECT_EQ(timeoutText.get(), "9");
+
+    simulated_response_body = saved;
+}
+
+TEST(rfcapiTest, getRFCParameter_negativeCache) {
+    const char* pcUnknownName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.NotOnThisBuild.Enable";
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    std::string saved = simulated_response_body;
+    setRFCNegativeCacheTTL(60000);
+    for (int i = 0; i < 200 && getRFCStoreGeneration() == 0; i++)
+        usleep(10000);
+    RFC_ParamData_t pstParamData;
+    std::string unknownBody = std::string(R"({"parameters": [{"name": ")") + pcUnknownName +
+                              R"(", "value": "", "dataType": 0, "parameterCount": 1, "message": "Invalid Parameter Name"}], "statusCode": 4})";
+    simulated_response_body = unknownBody;
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcUnknownName, &pstParamData), WDMP_ERR_INVALID_PARAMETER_NAME);
+
+    // Replayed without asking hostif, which would now answer differently.
+    simulated_response_body = singleParamBody(pcUnknownName, "true", 3);
+    RFC_CacheStats_t before, after;
+    getRFCCacheStats(&before);
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcUnknownName, &pstParamData), WDMP_ERR_INVALID_PARAMETER_NAME);
+    const char* names[] = { pcUnknownName };
+    WDMP_STATUS status[1];
+    EXPECT_EQ(getRFCParameters("rfcdefaults", names, 1, &pstParamData, status), WDMP_ERR_INVALID_PARAMETER_NAME);
+    getRFCCacheStats(&after);
+    EXPECT_EQ(after.hits, before.hits + 2);
+
+    // Values themselves are not cached unless setRFCCacheTTL() is used.
+    simulated_response_body = singleParamBody(pcParameterName, "true", 3);
+    getRFCParameter("rfcdefaults", pcParameterName, &pstParamData);
+    simulated_response_body = singleParamBody(pcParameterName, "false", 3);
+    getRFCParameter("rfcdefaults", pcParameterName, &pstParamData);
+    EXPECT_STREQ(pstParamData.value, "false");
+
+    // A store change drops negative results too.
+    simulated_response_body = singleParamBody(pcUnknownName, "true", 3);
+    clearRFCCache();
+    EXPECT_EQ(getRFCParameter("rfcdefaults", pcUnknownName, &pstParamData), WDMP_SUCCESS);
+    EXPECT_STREQ(pstParamData.value, "true");
+
+    setRFCNegativeCacheTTL(0);
+    simulated_response_body = saved;
+}
+
+struct ChangeLog {
+    std::mutex mutex;
+    std::vector<std::pair<std::string, std::string> > changes;   // "<removed>" for a NULL value
+};
+
+static void recordChange(RFC_SubscriptionHandle_t handle, const char *pcName, const char *pcValue, void *pUserData) {
+    ChangeLog *log = (ChangeLog *)pUserData;
+    std::lock_guard<std::mutex> lock(log->mutex);
+    log->changes.push_back(std::make_pair(std::string(pcName), std::string(pcValue ? pcValue : "<removed>")));
+}
+
+static bool waitForChange(ChangeLog &log, const std::string &name, const std::string &value) {
+    for (int i = 0; i < 500; i++) {
+        {
+            std::lock_guard<std::mutex> lock(log.mutex);
+            for (size_t j = 0; j < log.changes.size(); j++) {
+                if (log.changes[j].first == name && log.changes[j].second == value)
+                    return true;
+            }
+        }
+        usleep(10000);
+    }
+    return false;
+}
+
+TEST(rfcapiTest, subscribeRFCParameter) {
+    std::string prefix = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.SubscribeTest.";
+    std::string enableName = prefix + "Enable";
+    std::string modeName = prefix + "Mode";
+    writeToTr181storeFile(enableName, "false", "/opt/secure/RFC/tr181store.ini", Plain);
+    for (int i = 0; i < 200 && getRFCStoreGeneration() == 0; i++)
+        usleep(10000);
+
+    ChangeLog log;
+    RFC_SubscriptionHandle_t handle = subscribeRFCParameter(prefix.c_str(), recordChange, &log);
+    ASSERT_NE(handle, 0UL);
+    EXPECT_EQ(subscribeRFCParameter(NULL, recordChange, &log), 0UL);
+
+    writeToTr181storeFile(enableName, "true", "/opt/secure/RFC/tr181store.ini", Plain);
+    writeToTr181storeFile("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.SubscribeTestOther.Enable", "true", "/opt/secure/RFC/tr181store.ini", Plain);
+    EXPECT_TRUE(waitForChange(log, enableName, "true"));
+
+    // setLocalParam() writes tr181localstore.ini.
+    writeToTr181storeFile(modeName, "local", "/opt/secure/RFC/tr181localstore.ini", Plain);
+    EXPECT_TRUE(waitForChange(log, modeName, "local"));
+
+    writeToTr181storeFile(enableName, "", "/opt/secure/RFC/tr181store.ini", Plain);
+    EXPECT_TRUE(waitForChange(log, enableName, "<removed>"));
+
+    EXPECT_TRUE(unsubscribeRFCParameter(handle));
+    EXPECT_FALSE(unsubscribeRFCParameter(handle));
+    size_t reported;
+    {
+        std::lock_guard<std::mutex> lock(log.mutex);
+        reported = log.changes.size();
+    }
+    writeToTr181storeFile(enableName, "false", "/opt/secure/RFC/tr181store.ini", Plain);
+    usleep(500000);
+
+    std::lock_guard<std::mutex> lock(log.mutex);
+    EXPECT_EQ(log.changes.size(), reported);
+    // Each real change is reported once; names outside the prefix never are.
+    EXPECT_EQ(reported, 3u);
+}
+
+TEST(rfcapiTest, subscribeRFCParameter_afterFork) {
+    std::string prefix = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.SubscribeFork.";
+    std::string enableName = prefix + "Enable";
+    writeToTr181storeFile(enableName, "false", "/opt/secure/RFC/tr181store.ini", Plain);
+    ChangeLog parentLog;
+    RFC_SubscriptionHandle_t parentHandle = subscribeRFCParameter(prefix.c_str(), recordChange, &parentLog);
+    ASSERT_NE(parentHandle, 0UL);
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        // The parent's dispatcher is gone: the child's subscription is served by one of its own.
+        ChangeLog log;
+        if (subscribeRFCParameter(prefix.c_str(), recordChange, &log) == 0)
+            _exit(2);
+        for (int i = 0; i < 200 && getRFCStoreGeneration() == 0; i++)
+            usleep(10000);
+        writeToTr181storeFile(enableName, "true", "/opt/secure/RFC/tr181store.ini", Plain);
+        _exit(waitForChange(log, enableName, "true") ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    EXPECT_TRUE(waitForChange(parentLog, enableName, "true"));
+    EXPECT_TRUE(unsubscribeRFCParameter(parentHandle));
+}
+
+static void collectCallerStats(const RFC_CallerStats_t *pstStats, void *pUserData) {
+    RFC_CallerStats_t *wanted = (RFC_CallerStats_t *)pUserData;
+    if (strcmp(pstStats->callerID, wanted->callerID) == 0 && pstStats->op == wanted->op)
+        *wanted = *pstStats;
+}
+
+TEST(rfcapiTest, getRFCCallerStats) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    std::string saved = simulated_response_body;
+    // The segment outlives this process, so count under an ID of our own.
+    std::string callerID = "statsTest" + std::to_string(getpid());
+    simulated_response_body = singleParamBody(pcParameterName, "true", 3);
+
+    setRFCStatsEnabled(true);
+    RFC_ParamData_t pstParamData;
+    for (int i = 0; i < 3; i++)
+        EXPECT_EQ(getRFCParameter(callerID.c_str(), pcParameterName, &pstParamData), WDMP_SUCCESS);
+    char value[16];
+    size_t len = sizeof(value);
+    EXPECT_EQ(getRFCParameterValue(callerID.c_str(), pcParameterName, value, &len, NULL), WDMP_SUCCESS);
+    EXPECT_EQ(setRFCParameter(callerID.c_str(), "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.", NULL, WDMP_STRING), WDMP_FAILURE);
+    setRFCStatsEnabled(false);
+    getRFCParameter(callerID.c_str(), pcParameterName, &pstParamData);
+
+    RFC_CallerStats_t get;
+    memset(&get, 0, sizeof(get));
+    strncpy(get.callerID, callerID.c_str(), sizeof(get.callerID) - 1);
+    get.op = RFC_STATS_GET;
+    ASSERT_EQ(getRFCCallerStats(collectCallerStats, &get), WDMP_SUCCESS);
+    // Callers running as other uids count into the same segment.
+    struct stat st;
+    ASSERT_EQ(stat("/dev/shm/rfcapi_stats", &st), 0);
+    EXPECT_EQ(st.st_mode & 0777, 0666u);
+    EXPECT_EQ(get.calls, 4ULL);
+    EXPECT_EQ(get.hostif + get.file + get.memory, get.calls);
+    EXPECT_EQ(get.errors, 0ULL);
+    unsigned long long histogram = 0;
+    for (int i = 0; i < RFC_STATS_LATENCY_BUCKETS; i++)
+        histogram += get.latency[i];
+    EXPECT_EQ(histogram, get.calls);
+
+    RFC_CallerStats_t set;
+    memset(&set, 0, sizeof(set));
+    strncpy(set.callerID, callerID.c_str(), sizeof(set.callerID) - 1);
+    set.op = RFC_STATS_SET;
+    ASSERT_EQ(getRFCCallerStats(collectCallerStats, &set), WDMP_SUCCESS);
+    EXPECT_EQ(set.calls, 1ULL);
+    EXPECT_EQ(set.errors, 1ULL);
+    EXPECT_STREQ(getRFCStatsOpName(RFC_STATS_SET), "set");
+
+    simulated_response_body = saved;
+}
+
+TEST(rfcapiTest, getRFCParameter_threads) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    setRFCCacheTTL(0);
+    // Every thread reuses its own handle across calls; none of the answers may be lost or mixed up.
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 8; t++) {
+        threads.push_back(std::thread([&failures, pcParameterName]() {
+            for (int i = 0; i < 50; i++) {
+                RFC_ParamData_t param;
+                if (getRFCParameter("rfcthreads", pcParameterName, &param) != WDMP_SUCCESS || strcmp(param.value, "true") != 0)
+                    failures++;
+            }
+        }));
+    }
+    for (size_t t = 0; t < threads.size(); t++)
+        threads[t].join();
+    EXPECT_EQ(failures.load(), 0);
+}
+
+TEST(rfcapiTest, getRFCParameters_HTTP) {
+    const char* names[] = {
+        "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable",
+        "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Unknown.Enable",
+        "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Missing.Enable"
+    };
+    std::string saved = simulated_response_body;
+    // Reply out of order and without the third name.
+    simulated_response_body = R"({
+  "parameters": [{
+    "name": "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Unknown.Enable",
+    "value": "",
+    "dataType": 0,
+    "parameterCount": 1,
+    "message": "Invalid Parameter Name"
+  }, {
+    "name": "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable",
+    "value": "true",
+    "dataType": 3,
+    "parameterCount": 1,
+    "message": "Success"
+  }],
+  "statusCode": 0
+})";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    RFC_ParamData_t params[3];
+    WDMP_STATUS status[3];
+    WDMP_STATUS result = getRFCParameters("rfcdefaults", names, 3, params, status);
+    simulated_response_body = saved;
+    EXPECT_EQ(status[0], WDMP_SUCCESS);
+    EXPECT_STREQ(params[0].value, "true");
+    EXPECT_EQ(params[0].type, WDMP_BOOLEAN);
+    EXPECT_EQ(status[1], WDMP_ERR_INVALID_PARAMETER_NAME);
+    EXPECT_EQ(status[2], WDMP_FAILURE);
+    EXPECT_EQ(result, WDMP_ERR_INVALID_PARAMETER_NAME);
+}
+
+TEST(rfcapiTest, getRFCParameterTree_HTTP) {
+    std::string saved = simulated_response_body;
+    simulated_response_body = R"({
+  "parameters": [{
+    "name": "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable",
+    "value": "true",
+    "dataType": 3,
+    "parameterCount": 2,
+    "message": "Success"
+  }, {
+    "name": "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Mode",
+    "value": "auto",
+    "dataType": 0,
+    "parameterCount": 2,
+    "message": "Success"
+  }],
+  "statusCode": 0
+})";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    std::vector<std::pair<std::string, std::string>> found;
+    WDMP_STATUS result = getRFCParameterTree("rfcdefaults", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.", collectRFCParam, &found);
+    std::string request = simulated_request_body;
+    simulated_response_body = saved;
+    EXPECT_EQ(result, WDMP_SUCCESS);
+    ASSERT_EQ(found.size(), 2);
+    EXPECT_EQ(found[1].first, "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Mode");
+    EXPECT_EQ(found[1].second, "auto");
+    EXPECT_NE(request.find("\"Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.\""), std::string::npos);
+}
+
 TEST(rfcapiTest, getRFCParameter_wildcard) {
     const char* pcParameterName = "Device.DeviceInfo.";
     char *pcCallerID = "rfcdefaults";
@@ -105,6 +1059,11 @@ TEST(rfcapiTest, setRFCParameter_wildcard) {
     RFC_ParamData_t pstParamData;
     WDMP_STATUS result = setRFCParameter(pcCallerID, pcParameterName, pcParameterValue, WDMP_STRING);
     EXPECT_EQ(result, WDMP_FAILURE);
+
+    // A wildcard with a value is still hostif's to accept or refuse.
+    simulated_request_body.clear();
+    setRFCParameter(pcCallerID, pcParameterName, "x", WDMP_STRING);
+    EXPECT_NE(simulated_request_body.find("\"name\":\"Device.DeviceInfo.\""), std::string::npos);
 }
 
 TEST(rfcapiTest, setRFCParameter) {
@@ -116,6 +1075,136 @@ TEST(rfcapiTest, setRFCParameter) {
     EXPECT_EQ(result, WDMP_SUCCESS);
 }
 
+TEST(rfcapiTest, setRFCParameters) {
+    RFC_SetParamData_t params[] = {
+        { "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable", "true", WDMP_BOOLEAN },
+        { "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Banner.Text", "say \"hi\"\n", WDMP_STRING },
+        { "Device.DeviceInfo.", "x", WDMP_STRING }
+    };
+    WDMP_STATUS status[3];
+    WDMP_STATUS result = setRFCParameters("rfcdefaults", params, 3, status);
+    EXPECT_EQ(status[0], WDMP_SUCCESS);
+    EXPECT_EQ(status[1], WDMP_SUCCESS);
+    EXPECT_EQ(status[2], WDMP_FAILURE);
+    EXPECT_EQ(result, WDMP_FAILURE);
+    // Both valid entries go out in one escaped request body.
+    EXPECT_NE(simulated_request_body.find("\"value\":\"say \\\"hi\\\"\\n\""), std::string::npos);
+    EXPECT_NE(simulated_request_body.find("Airplay.Enable\",\"value\":\"true\",\"dataType\":3}"), std::string::npos);
+    EXPECT_EQ(simulated_request_body.find("\"Device.DeviceInfo.\""), std::string::npos);
+    EXPECT_EQ(setRFCParameters("rfcdefaults", NULL, 1, status), WDMP_FAILURE);
+}
+
+struct AsyncResult {
+    std::atomic<int> calls{0};
+    RFC_AsyncHandle_t handle = 0;
+    WDMP_STATUS status = WDMP_FAILURE;
+    std::string value;
+    DATA_TYPE type = WDMP_NONE;
+};
+
+static void onAsyncGet(RFC_AsyncHandle_t handle, WDMP_STATUS status, const RFC_ParamData_t *pstParam, void *userData) {
+    AsyncResult *result = static_cast<AsyncResult *>(userData);
+    result->handle = handle;
+    result->status = status;
+    result->value = pstParam->value;
+    result->type = pstParam->type;
+    result->calls++;
+}
+
+static void onAsyncSet(RFC_AsyncHandle_t handle, WDMP_STATUS status, void *userData) {
+    AsyncResult *result = static_cast<AsyncResult *>(userData);
+    result->handle = handle;
+    result->status = status;
+    result->calls++;
+}
+
+static bool waitForAsync(const AsyncResult &result, int calls) {
+    for (int i = 0; i < 200 && result.calls < calls; i++)
+        usleep(10000);
+    return result.calls == calls;
+}
+
+TEST(rfcapiTest, getRFCParameterAsync) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    AsyncResult results[4];
+    RFC_AsyncHandle_t handles[4];
+    for (int i = 0; i < 4; i++) {
+        handles[i] = getRFCParameterAsync("rfcdefaults", pcParameterName, onAsyncGet, &results[i]);
+        EXPECT_NE(handles[i], 0UL);
+    }
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(waitForAsync(results[i], 1));
+        EXPECT_EQ(results[i].handle, handles[i]);
+        EXPECT_EQ(results[i].status, WDMP_SUCCESS);
+        EXPECT_EQ(results[i].value, "true");
+        EXPECT_EQ(results[i].type, WDMP_BOOLEAN);
+    }
+    EXPECT_FALSE(cancelRFCAsync(handles[0]));
+
+    AsyncResult wildcard;
+    EXPECT_NE(getRFCParameterAsync("rfcdefaults", "Device.DeviceInfo.", onAsyncGet, &wildcard), 0UL);
+    ASSERT_TRUE(waitForAsync(wildcard, 1));
+    EXPECT_EQ(wildcard.status, WDMP_FAILURE);
+    EXPECT_EQ(getRFCParameterAsync("rfcdefaults", pcParameterName, NULL, NULL), 0UL);
+}
+
+TEST(rfcapiTest, setRFCParameterAsync) {
+    AsyncResult result;
+    RFC_AsyncHandle_t handle = setRFCParameterAsync("rfcdefaults", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Banner.Text", "async", WDMP_STRING, onAsyncSet, &result);
+    EXPECT_NE(handle, 0UL);
+    ASSERT_TRUE(waitForAsync(result, 1));
+    EXPECT_EQ(result.handle, handle);
+    EXPECT_EQ(result.status, WDMP_SUCCESS);
+    EXPECT_NE(simulated_request_body.find("Banner.Text\",\"value\":\"async\",\"dataType\":0}"), std::string::npos);
+    EXPECT_EQ(setRFCParameterAsync("rfcdefaults", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Banner.Text", NULL, WDMP_STRING, onAsyncSet, &result), 0UL);
+}
+
+TEST(rfcapiTest, getRFCParameterAsync_fd) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    int fd = getRFCAsyncFd();
+    ASSERT_GE(fd, 0);
+    AsyncResult kept, cancelled;
+    RFC_AsyncHandle_t keptHandle = getRFCParameterAsync("rfcdefaults", pcParameterName, onAsyncGet, &kept);
+    RFC_AsyncHandle_t cancelledHandle = getRFCParameterAsync("rfcdefaults", pcParameterName, onAsyncGet, &cancelled);
+    EXPECT_TRUE(cancelRFCAsync(cancelledHandle));
+    EXPECT_FALSE(cancelRFCAsync(cancelledHandle));
+
+    // Completions wait for the caller's loop: nothing runs until dispatch.
+    struct pollfd pfd = { fd, POLLIN, 0 };
+    size_t dispatched = 0;
+    for (int i = 0; i < 20 && kept.calls == 0; i++) {
+        if (poll(&pfd, 1, 100) > 0)
+            dispatched += dispatchRFCAsync();
+    }
+    EXPECT_EQ(dispatched, 1u);
+    EXPECT_EQ(kept.calls, 1);
+    EXPECT_EQ(kept.handle, keptHandle);
+    EXPECT_EQ(kept.value, "true");
+    EXPECT_EQ(cancelled.calls, 0);
+}
+
+TEST(rfcapiTest, getRFCParameterAsync_afterFork) {
+    const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    write_on_file("/tmp/.tr69hostif_http_server_ready", ".tr69hostif_http_server_ready");
+    ASSERT_GE(getRFCAsyncFd(), 0);
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        // The parent's worker thread is gone: the child starts its own, and its
+        // completions run there until it asks for a completion fd of its own.
+        AsyncResult result;
+        if (getRFCParameterAsync("rfcdefaults", pcParameterName, onAsyncGet, &result) == 0)
+            _exit(2);
+        _exit(waitForAsync(result, 1) && result.status == WDMP_SUCCESS && result.value == "true" ? 0 : 1);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+}
+
 TEST(rfcapiTest, getRFCErrorString) {
     EXPECT_STREQ(getRFCErrorString(WDMP_SUCCESS), " Success");
     EXPECT_STREQ(getRFCErrorString(WDMP_FAILURE), " Request Failed");
@@ -161,6 +1250,203 @@ TEST(rfcapiTest, isRFCEnabled) {
     EXPECT_EQ(result, false);
 }
 
+TEST(rfcapiTest, isRFCEnabledMulti) {
+    const char* features[] = { "MultiTestOn", "MultiTestOff", NULL };
+    bool enabled[3];
+    write_on_file("/opt/secure/RFC/.RFC_MultiTestOn.ini", "export RFC_ENABLE_MULTITESTON=true");
+    // The feature set follows the marker files through the store watcher.
+    for (int i = 0; i < 100 && !isRFCEnabled("MultiTestOn"); i++)
+        usleep(10000);
+    EXPECT_TRUE(isRFCEnabled("MultiTestOn"));
+    EXPECT_EQ(isRFCEnabledMulti(features, 3, enabled), 1u);
+    EXPECT_TRUE(enabled[0]);
+    EXPECT_FALSE(enabled[1]);
+    EXPECT_FALSE(enabled[2]);
+
+    EXPECT_EQ(unlink("/opt/secure/RFC/.RFC_MultiTestOn.ini"), 0);
+    for (int i = 0; i < 100 && isRFCEnabled("MultiTestOn"); i++)
+        usleep(10000);
+    EXPECT_FALSE(isRFCEnabled("MultiTestOn"));
+    EXPECT_EQ(isRFCEnabledMulti(features, 3, enabled), 0u);
+    EXPECT_EQ(isRFCEnabledMulti(NULL, 3, enabled), 0u);
+}
+
+TEST(rfcapiTest, isRFCEnabled_afterFork) {
+    // Arm the watcher and build the feature set in the parent first.
+    for (int i = 0; i < 200 && getRFCStoreGeneration() == 0; i++)
+        usleep(10000);
+    ASSERT_NE(getRFCStoreGeneration(), 0UL);
+    EXPECT_FALSE(isRFCEnabled("ForkTest"));
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        // No watcher thread came across: the marker must be seen at once, not from the parent's set.
+        write_on_file("/opt/secure/RFC/.RFC_ForkTest.ini", "export RFC_ENABLE_FORKTEST=true");
+        if (!isRFCEnabled("ForkTest"))
+            _exit(1);
+        // The child arms a watcher of its own.
+        for (int i = 0; i < 200 && getRFCStoreGeneration() == 0; i++)
+            usleep(10000);
+        _exit(getRFCStoreGeneration() != 0 ? 0 : 2);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    EXPECT_TRUE(WIFEXITED(status));
+    EXPECT_EQ(WEXITSTATUS(status), 0);
+    unlink("/opt/secure/RFC/.RFC_ForkTest.ini");
+}
+
+static std::string parsedSummary(const char *body) {
+    RfcHostifResponse parsed;
+    if (!rfcHostifParseJson(body, strlen(body), &parsed))
+        return "invalid";
+    std::string out = parsed.hasStatusCode ? std::to_string(parsed.statusCode) : "-";
+    for (size_t i = 0; i < parsed.parameters.size(); i++) {
+        const RfcHostifEntry &entry = parsed.parameters[i];
+        out += " [" + (entry.hasName ? entry.name : std::string("-")) + "|" + (entry.hasValue ? entry.value : std::string("-")) + "|" +
+               (entry.hasType ? std::to_string(entry.dataType) : std::string("-")) + "|" + (entry.hasMessage ? entry.message : std::string("-")) + "]";
+    }
+    return out;
+}
+
+TEST(rfcapiTest, rfcHostifGetBody) {
+    EXPECT_EQ(rfcHostifGetBody("Device.DeviceInfo.SerialNumber"), "{\"names\" : [\"Device.DeviceInfo.SerialNumber\"]}");
+    // The name is escaped, so it cannot add fields or names to the request.
+    EXPECT_EQ(rfcHostifGetBody("a\"],\"b\\\n"), "{\"names\" : [\"a\\\"],\\\"b\\\\\\n\"]}");
+}
+
+TEST(rfcapiTest, rfcHostifParseJson) {
+    // What the default build reads from the same bodies with cJSON.
+    EXPECT_EQ(parsedSummary("{\"parameters\":[{\"name\":\"Device.A\",\"dataType\":3,\"parameterCount\":1,\"value\":\"true\"}],\"statusCode\":0}"),
+              "0 [Device.A|true|3|-]");
+    EXPECT_EQ(parsedSummary(" { \"parameters\" : [ {\"name\":\"Device.A\",\"value\":\"x\",\"dataType\":0,\"message\":\"Invalid Parameter Name\"} ,"
+                            "{\"name\":\"Device.B\",\"value\":\"\"} ] , \"statusCode\" : 6 } "),
+              "6 [Device.A|x|0|Invalid Parameter Name] [Device.B||-|-]");
+    EXPECT_EQ(parsedSummary("{\"parameters\":[{\"name\":\"a\\\"b\\\\c\\/d\\b\\f\\n\\r\\te\\u00e9\\u20ac\\ud83d\\ude00\"}]}"),
+              "- [a\"b\\c/d\b\f\n\r\te\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80|-|-|-]");
+    // Member names match case-insensitively and the first occurrence wins, even when it is not a string.
+    EXPECT_EQ(parsedSummary("{\"PARAMETERS\":[{\"Name\":\"Device.D\",\"VALUE\":\"v\"}],\"StatusCode\":2.9}"), "2 [Device.D|v|-|-]");
+    EXPECT_EQ(parsedSummary("{\"parameters\":[{\"name\":\"first\",\"name\":\"second\",\"value\":1,\"value\":\"later\",\"dataType\":\"3\"}]}"),
+              "- [first|-|0|-]");
+    EXPECT_EQ(parsedSummary("{\"statusCode\":1,\"statusCode\":2,\"parameters\":[],\"parameters\":[{\"name\":\"ignored\"}]}"), "1");
+    EXPECT_EQ(parsedSummary("{\"statusCode\":true,\"parameters\":[{\"dataType\":99999999999},{\"dataType\":-1e12}]}"),
+              "1 [-|-|2147483647|-] [-|-|-2147483648|-]");
+    // Unknown members are skipped, however deep; elements that are not objects are empty entries.
+    EXPECT_EQ(parsedSummary("{\"extra\":{\"parameters\":[{\"name\":\"no\"}]},\"parameters\":[{\"name\":\"Device.G\",\"x\":[1,{\"name\":\"no\"},null,false]},7],"
+                            "\"statusCode\":1e1}"),
+              "10 [Device.G|-|-|-] [-|-|-|-]");
+    EXPECT_EQ(parsedSummary("\xEF\xBB\xBF{\"statusCode\":0} trailing"), "0");
+    EXPECT_EQ(parsedSummary("[1,2]"), "-");
+    EXPECT_EQ(parsedSummary(""), "invalid");
+    EXPECT_EQ(parsedSummary("{\"parameters\":[{\"name\":\"Device.A\"}"), "invalid");
+    EXPECT_EQ(parsedSummary("{\"parameters\":[{\"name\":\"bad \\q escape\"}]}"), "invalid");
+    EXPECT_EQ(parsedSummary("{\"parameters\":[{\"name\":\"lone \\udc00\"}]}"), "invalid");
+    EXPECT_EQ(parsedSummary("{\"parameters\":[{\"name\":\"Device.A\",}]}"), "invalid");
+    EXPECT_EQ(parsedSummary("{\"statusCode\":tru}"), "invalid");
+}
+
+/* Stand-in hostif for rfcHttpRequest(): answers each request with the next scripted reply. */
+struct ScriptedHostif {
+    int listenFd;
+    std::vector<std::string> replies;
+    std::vector<std::string> requests;
+    int accepted;
+    std::thread thread;
+
+    void serve() {
+        size_t next = 0;
+        while (next < replies.size()) {
+            int fd = accept(listenFd, NULL, NULL);
+            if (fd < 0)
+                return;
+            accepted++;
+            std::string buffer;
+            bool open = true;
+            while (open && next < replies.size()) {
+                size_t headEnd;
+                while ((headEnd = buffer.find("\r\n\r\n")) == std::string::npos) {
+                    char chunk[1024];
+                    ssize_t n = read(fd, chunk, sizeof(chunk));
+                    if (n <= 0) { open = false; break; }
+                    buffer.append(chunk, n);
+                }
+                if (!open)
+                    break;
+                size_t length = 0;
+                size_t pos = buffer.find("Content-Length: ");
+                if (pos != std::string::npos && pos < headEnd)
+                    length = strtoul(buffer.c_str() + pos + 16, NULL, 10);
+                while (buffer.size() < headEnd + 4 + length) {
+                    char chunk[1024];
+                    ssize_t n = read(fd, chunk, sizeof(chunk));
+                    if (n <= 0) { open = false; break; }
+                    buffer.append(chunk, n);
+                }
+                if (!open)
+                    break;
+                requests.push_back(buffer.substr(0, headEnd + 4 + length));
+                buffer.erase(0, headEnd + 4 + length);
+                const std::string &reply = replies[next++];
+                EXPECT_EQ(write(fd, reply.data(), reply.size()), (ssize_t)reply.size());
+                if (reply.find("Connection: close") != std::string::npos)
+                    open = false;
+            }
+            close(fd);
+        }
+    }
+};
+
+TEST(rfcapiTest, rfcHttpRequest) {
+    const char *socketPath = "/tmp/rfcapi_gtest_http.sock";
+    unlink(socketPath);
+    ScriptedHostif hostif;
+    hostif.accepted = 0;
+    hostif.listenFd = socket(AF_UNIX, SOCK_STREAM, 0);
+    ASSERT_GE(hostif.listenFd, 0);
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, socketPath, sizeof(addr.sun_path) - 1);
+    ASSERT_EQ(bind(hostif.listenFd, (struct sockaddr *)&addr, sizeof(addr)), 0);
+    ASSERT_EQ(listen(hostif.listenFd, 4), 0);
+
+    std::string body = "{\"statusCode\":0}";
+    hostif.replies.push_back("HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body);
+    // Interim answer, then a chunked body split across chunks.
+    hostif.replies.push_back("HTTP/1.1 100 Continue\r\n\r\nHTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+                             "5\r\n{\"sta\r\nB;ext=1\r\ntusCode\":0}\r\n0\r\n\r\n");
+    hostif.replies.push_back("HTTP/1.1 200 OK\r\nConnection: close\r\nContent-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body);
+    hostif.replies.push_back("HTTP/1.0 200 OK\r\n\r\n" + body);
+    hostif.thread = std::thread(&ScriptedHostif::serve, &hostif);
+
+    setRFCHostifSocket(socketPath);
+    std::string get = "{\"names\" : [\"Device.A\"]}";
+    std::string response;
+    EXPECT_EQ(rfcHttpRequest("gtest", get, false, &response, 0), RFC_HOSTIF_OK);
+    EXPECT_EQ(response, body);
+    EXPECT_EQ(rfcHttpRequest("gtest", get, true, &response, 0), RFC_HOSTIF_OK);
+    EXPECT_EQ(response, body);
+    EXPECT_EQ(rfcHttpRequest("gtest", get, false, &response, 2000), RFC_HOSTIF_OK);
+    EXPECT_EQ(response, body);
+    // The server closed the connection, so this needs a new one; its body runs to the end of it.
+    EXPECT_EQ(rfcHttpRequest(NULL, get, false, &response, 0), RFC_HOSTIF_OK);
+    EXPECT_EQ(response, body);
+    hostif.thread.join();
+
+    EXPECT_EQ(hostif.accepted, 2);
+    ASSERT_EQ(hostif.requests.size(), 4u);
+    EXPECT_EQ(hostif.requests[0].compare(0, 16, "GET / HTTP/1.1\r\n"), 0);
+    EXPECT_NE(hostif.requests[0].find("\r\nCallerID: gtest\r\n"), std::string::npos);
+    EXPECT_EQ(hostif.requests[0].substr(hostif.requests[0].size() - get.size()), get);
+    EXPECT_EQ(hostif.requests[1].compare(0, 17, "POST / HTTP/1.1\r\n"), 0);
+    EXPECT_NE(hostif.requests[3].find("\r\nCallerID: Unknown\r\n"), std::string::npos);
+
+    setRFCHostifSocket(NULL);
+    close(hostif.listenFd);
+    unlink(socketPath);
+}
+
 GTEST_API_ int main(int argc, char *argv[]){
     ::testing::InitGoogleTest(&argc, argv);
 
@@ -27,12 +27,24 @@
 #include <cstdio>
 #include <fstream>
 #include <string>
+#include <iterator>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
 #include "tr181api.h"
 #include "tr181_store_writer.h"
+#include "rfcapi_localstore.h"
 
 using namespace std;
 
 #define TR181_LOCAL_STORE_FILE "/opt/secure/RFC/tr181localstore.ini"
+#define TR181_LOCAL_STORE_INDEX "/opt/secure/RFC/tr181localstore.bin"
+#define TR181_LOCAL_STORE_JOURNAL "/opt/secure/RFC/tr181localstore.journal"
+#define TR181_LOCAL_STORE_LOCK "/opt/secure/RFC/tr181localstore.lock"
 #define RFCDEFAULTS_ETC_DIR "/etc/rfcdefaults/"
 
 TEST(tr181apiTest, getTR181ErrorString) {
@@ -98,6 +110,17 @@ TEST(tr181apiTest, getDefaultValue_callerIDNULL) {
     EXPECT_EQ(status, tr181Failure);
 }
 
+TEST(tr181apiTest, getDefaultValue_updatedFile) {
+    const char* pcParameterName ="Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable";
+    char *pcCallerID = "rfcdefaults";
+    TR181_ParamData_t pstParamData;
+    // Editing a defaults file recompiles the snapshot on the next lookup.
+    writeToTr181storeFile(pcParameterName, "true", "/etc/rfcdefaults/rfcdefaults.ini", Plain);
+    EXPECT_EQ(getDefaultValue(pcCallerID, pcParameterName, &pstParamData), tr181Success);
+    EXPECT_STREQ(pstParamData.value, "true");
+    EXPECT_EQ(getDefaultValue(pcCallerID, "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Missing", &pstParamData), tr181Failure);
+}
+
 TEST(tr181apiTest, getValue) {
     writeToTr181storeFile("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.SWDLSpLimit.Enable", "true", TR181_LOCAL_STORE_FILE, Plain);
     const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.SWDLSpLimit.Enable";
@@ -171,6 +194,327 @@ TEST(tr181apiTest, getLocalParamDefault) {
     EXPECT_EQ(status, tr181Success);
 }
 
+static std::string readWholeFile(const char *path) {
+    std::ifstream ifs(path);
+    return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+}
+
+static off_t fileSize(const char *path) {
+    struct stat st;
+    return stat(path, &st) == 0 ? st.st_size : -1;
+}
+
+TEST(tr181apiTest, localStoreJournal) {
+    char *pcCallerID = (char *)"rfcdefaults";
+    const std::string prefix = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.JournalTest.";
+    const std::string a = prefix + "A", b = prefix + "B", other = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.JournalTestOther.C";
+    ASSERT_TRUE(rfcLocalStoreCompact());
+    std::string snapshot = readWholeFile(TR181_LOCAL_STORE_FILE);
+
+    // Sets and clears go to the journal; the snapshot is not rewritten.
+    EXPECT_EQ(setLocalParam(pcCallerID, a.c_str(), "1"), tr181Success);
+    EXPECT_EQ(setLocalParam(pcCallerID, b.c_str(), "2"), tr181Success);
+    EXPECT_EQ(setLocalParam(pcCallerID, other.c_str(), "3"), tr181Success);
+    EXPECT_EQ(setLocalParam(pcCallerID, a.c_str(), "4"), tr181Success);
+    EXPECT_EQ(readWholeFile(TR181_LOCAL_STORE_FILE), snapshot);
+    off_t journalSize = fileSize(TR181_LOCAL_STORE_JOURNAL);
+    EXPECT_GT(journalSize, 0);
+
+    TR181_ParamData_t param;
+    EXPECT_EQ(getLocalParam(pcCallerID, a.c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "4");
+    EXPECT_EQ(getLocalParam(pcCallerID, b.c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "2");
+
+    // Setting the current value writes nothing.
+    EXPECT_EQ(setLocalParam(pcCallerID, b.c_str(), "2"), tr181Success);
+    EXPECT_EQ(fileSize(TR181_LOCAL_STORE_JOURNAL), journalSize);
+
+    // A torn record at the end is ignored, and dropped by the next write.
+    {
+        std::ofstream journal(TR181_LOCAL_STORE_JOURNAL, std::ios::app | std::ios::binary);
+        journal << "\x31\x4a\x4c\x54torn";
+    }
+    EXPECT_EQ(getLocalParam(pcCallerID, a.c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "4");
+    EXPECT_EQ(clearLocalParam(pcCallerID, prefix.c_str()), tr181Success);
+    EXPECT_NE(getLocalParam(pcCallerID, a.c_str(), &param), tr181Success);
+    EXPECT_NE(getLocalParam(pcCallerID, b.c_str(), &param), tr181Success);
+    EXPECT_EQ(getLocalParam(pcCallerID, other.c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "3");
+    EXPECT_EQ(readWholeFile(TR181_LOCAL_STORE_FILE), snapshot);
+
+    // A direct edit of the snapshot is picked up for names the journal does not touch.
+    const std::string external = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.JournalTestExternal.D";
+    writeToTr181storeFile(external, "5", TR181_LOCAL_STORE_FILE, Plain);
+    EXPECT_EQ(getLocalParam(pcCallerID, external.c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "5");
+    EXPECT_EQ(clearLocalParam(pcCallerID, external.c_str()), tr181Success);
+    EXPECT_EQ(clearLocalParam(pcCallerID, other.c_str()), tr181Success);
+}
+
+TEST(tr181apiTest, localStoreCompaction) {
+    char *pcCallerID = (char *)"rfcdefaults";
+    const std::string prefix = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.CompactTest.";
+    ASSERT_TRUE(rfcLocalStoreCompact());
+    EXPECT_EQ(fileSize(TR181_LOCAL_STORE_JOURNAL), -1);
+
+    // Enough sets to pass the record threshold: the journal is folded into the snapshot on the way.
+    for (int i = 0; i < 300; i++) {
+        std::string name = prefix + "P" + std::to_string(i % 20);
+        EXPECT_EQ(setLocalParam(pcCallerID, name.c_str(), std::to_string(i).c_str()), tr181Success);
+    }
+    EXPECT_LT(fileSize(TR181_LOCAL_STORE_JOURNAL), 300 * 80);
+    EXPECT_NE(readWholeFile(TR181_LOCAL_STORE_FILE).find(prefix + "P0=240\n"), std::string::npos);
+
+    EXPECT_EQ(clearLocalParam(pcCallerID, (prefix + "P1").c_str()), tr181Success);
+    ASSERT_TRUE(rfcLocalStoreCompact());
+    EXPECT_EQ(fileSize(TR181_LOCAL_STORE_JOURNAL), -1);
+    std::string snapshot = readWholeFile(TR181_LOCAL_STORE_FILE);
+    EXPECT_NE(snapshot.find(prefix + "P19=299\n"), std::string::npos);
+    EXPECT_EQ(snapshot.find(prefix + "P1="), std::string::npos);
+
+    TR181_ParamData_t param;
+    EXPECT_EQ(getLocalParam(pcCallerID, (prefix + "P5").c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "285");
+    EXPECT_EQ(clearLocalParam(pcCallerID, prefix.c_str()), tr181Success);
+}
+
+TEST(tr181apiTest, syncLocalParams) {
+    char *pcCallerID = (char *)"rfcdefaults";
+    const char *pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.SyncTest.Value";
+    EXPECT_EQ(setLocalParam(pcCallerID, pcParameterName, "synced"), tr181Success);
+    EXPECT_EQ(readWholeFile(TR181_LOCAL_STORE_FILE).find(std::string(pcParameterName) + "=synced\n"), std::string::npos);
+    EXPECT_EQ(syncLocalParams(pcCallerID), tr181Success);
+    EXPECT_EQ(fileSize(TR181_LOCAL_STORE_JOURNAL), -1);
+    EXPECT_NE(readWholeFile(TR181_LOCAL_STORE_FILE).find(std::string(pcParameterName) + "=synced\n"), std::string::npos);
+    // Nothing pending: nothing is rewritten.
+    EXPECT_EQ(syncLocalParams(pcCallerID), tr181Success);
+    EXPECT_EQ(clearLocalParam(pcCallerID, pcParameterName), tr181Success);
+}
+
+TEST(tr181apiTest, localStoreFlushedAtExit) {
+    char *pcCallerID = (char *)"rfcdefaults";
+    const char *pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.ExitTest.Value";
+    ASSERT_TRUE(rfcLocalStoreCompact());
+
+    // A process that only set one value leaves tr181localstore.ini current when it exits.
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0)
+        exit(setLocalParam(pcCallerID, pcParameterName, "exited") == tr181Success ? 0 : 1);
+    int childStatus;
+    ASSERT_EQ(waitpid(pid, &childStatus, 0), pid);
+    ASSERT_TRUE(WIFEXITED(childStatus) && WEXITSTATUS(childStatus) == 0);
+    EXPECT_EQ(fileSize(TR181_LOCAL_STORE_JOURNAL), -1);
+    EXPECT_NE(readWholeFile(TR181_LOCAL_STORE_FILE).find(std::string(pcParameterName) + "=exited\n"), std::string::npos);
+    EXPECT_EQ(clearLocalParam(pcCallerID, pcParameterName), tr181Success);
+}
+
+TEST(tr181apiTest, localStoreIndex) {
+    char *pcCallerID = (char *)"rfcdefaults";
+    const std::string prefix = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.IndexTest.";
+    for (int i = 0; i < 50; i++) {
+        std::string name = prefix + "P" + std::to_string(i);
+        EXPECT_EQ(setLocalParam(pcCallerID, name.c_str(), std::to_string(i * 3).c_str()), tr181Success);
+    }
+    ASSERT_TRUE(rfcLocalStoreCompact());
+    EXPECT_EQ(readWholeFile(TR181_LOCAL_STORE_INDEX).compare(0, 4, "TLSI"), 0);
+
+    // Lookups come from the index, with the journal on top.
+    TR181_ParamData_t param;
+    EXPECT_EQ(getLocalParam(pcCallerID, (prefix + "P17").c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "51");
+    EXPECT_EQ(setLocalParam(pcCallerID, (prefix + "P17").c_str(), "x"), tr181Success);
+    EXPECT_EQ(clearLocalParam(pcCallerID, (prefix + "P18").c_str()), tr181Success);
+    EXPECT_EQ(getLocalParam(pcCallerID, (prefix + "P17").c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "x");
+    EXPECT_NE(getLocalParam(pcCallerID, (prefix + "P18").c_str(), &param), tr181Success);
+    EXPECT_NE(getLocalParam(pcCallerID, (prefix + "P50").c_str(), &param), tr181Success);
+
+    // A direct edit of the snapshot outdates the index; the text wins.
+    ASSERT_TRUE(rfcLocalStoreCompact());
+    writeToTr181storeFile(prefix + "P20", "edited", TR181_LOCAL_STORE_FILE, Plain);
+    EXPECT_EQ(getLocalParam(pcCallerID, (prefix + "P20").c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "edited");
+
+    // A damaged index is ignored, and the next write publishes a new one.
+    {
+        std::ofstream index(TR181_LOCAL_STORE_INDEX, std::ios::trunc | std::ios::binary);
+        index << "TLSI damaged";
+    }
+    EXPECT_EQ(getLocalParam(pcCallerID, (prefix + "P21").c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "63");
+    EXPECT_EQ(setLocalParam(pcCallerID, (prefix + "P22").c_str(), "y"), tr181Success);
+    EXPECT_GT(fileSize(TR181_LOCAL_STORE_INDEX), 64);
+    EXPECT_EQ(fileSize(TR181_LOCAL_STORE_JOURNAL), -1);
+    EXPECT_EQ(getLocalParam(pcCallerID, (prefix + "P20").c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "edited");
+    EXPECT_EQ(getLocalParam(pcCallerID, (prefix + "P22").c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "y");
+    EXPECT_EQ(clearLocalParam(pcCallerID, prefix.c_str()), tr181Success);
+}
+
+TEST(tr181apiTest, localParamsBatch) {
+    char *pcCallerID = (char *)"rfcdefaults";
+    const std::string prefix = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.BatchTest.";
+    std::vector<std::string> names;
+    std::vector<std::string> values;
+    for (int i = 0; i < 10; i++) {
+        names.push_back(prefix + "P" + std::to_string(i));
+        values.push_back(std::to_string(i * 7));
+    }
+    std::vector<const char *> pNames, pValues;
+    for (size_t i = 0; i < names.size(); i++) {
+        pNames.push_back(names[i].c_str());
+        pValues.push_back(values[i].c_str());
+    }
+    ASSERT_TRUE(rfcLocalStoreCompact());
+
+    // A change that cannot be stored fails the whole batch.
+    const std::string bad = prefix + "Bad=Name";
+    pNames.push_back(bad.c_str());
+    pValues.push_back("1");
+    EXPECT_EQ(setLocalParams(pcCallerID, pNames.data(), pValues.data(), pNames.size()), tr181Failure);
+    EXPECT_EQ(fileSize(TR181_LOCAL_STORE_JOURNAL), -1);
+    pNames.pop_back();
+    pValues.pop_back();
+
+    // One record for the batch, and the snapshot is not rewritten; a torn copy of it shows none of the changes.
+    struct stat before, after;
+    ASSERT_EQ(stat(TR181_LOCAL_STORE_FILE, &before), 0);
+    EXPECT_EQ(setLocalParams(pcCallerID, pNames.data(), pValues.data(), pNames.size()), tr181Success);
+    ASSERT_EQ(stat(TR181_LOCAL_STORE_FILE, &after), 0);
+    EXPECT_EQ(before.st_ino, after.st_ino);
+    off_t journalSize = fileSize(TR181_LOCAL_STORE_JOURNAL);
+    ASSERT_GT(journalSize, 0);
+    std::vector<TR181_ParamData_t> params(pNames.size());
+    std::vector<tr181ErrorCode_t> status(pNames.size());
+    EXPECT_EQ(getLocalParams(pcCallerID, pNames.data(), pNames.size(), params.data(), status.data()), tr181Success);
+    for (size_t i = 0; i < pNames.size(); i++) {
+        EXPECT_EQ(status[i], tr181Success);
+        EXPECT_STREQ(params[i].value, pValues[i]);
+    }
+    ASSERT_EQ(truncate(TR181_LOCAL_STORE_JOURNAL, journalSize - 1), 0);
+    EXPECT_EQ(getLocalParams(pcCallerID, pNames.data(), pNames.size(), params.data(), status.data()), tr181Failure);
+    for (size_t i = 0; i < pNames.size(); i++)
+        EXPECT_EQ(status[i], tr181Failure);
+
+    // Sets and clears apply in order; misses fall back to the defaults.
+    EXPECT_EQ(setLocalParams(pcCallerID, pNames.data(), pValues.data(), pNames.size()), tr181Success);
+    const char *edits[][2] = {
+        { "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.ClearParam", prefix.c_str() },
+        { pNames[3], "again" },
+    };
+    const char *editNames[] = { edits[0][0], edits[1][0] };
+    const char *editValues[] = { edits[0][1], edits[1][1] };
+    EXPECT_EQ(setLocalParams(pcCallerID, editNames, editValues, 2), tr181Success);
+    const char *mixed[] = { pNames[3], pNames[4], NULL, "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable" };
+    EXPECT_EQ(getLocalParams(pcCallerID, mixed, 4, params.data(), status.data()), tr181Failure);
+    EXPECT_EQ(status[0], tr181Success);
+    EXPECT_STREQ(params[0].value, "again");
+    EXPECT_EQ(status[1], tr181Failure);
+    EXPECT_EQ(status[2], tr181InvalidParameterName);
+    TR181_ParamData_t single;
+    EXPECT_EQ(status[3], getLocalParam(pcCallerID, mixed[3], &single));
+    EXPECT_STREQ(params[3].value, single.value);
+    EXPECT_EQ(clearLocalParam(pcCallerID, prefix.c_str()), tr181Success);
+}
+
+static void collectLocalParam(const char *pcParameterName, const TR181_ParamData_t *pstParamData, void *pUserData) {
+    std::vector<std::string> *out = (std::vector<std::string> *)pUserData;
+    out->push_back(std::string(pcParameterName) + "=" + pstParamData->value);
+}
+
+TEST(tr181apiTest, localParamTree) {
+    char *pcCallerID = (char *)"rfcdefaults";
+    const std::string prefix = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.TreeTest.";
+    const std::string mirror = "Mirror." + prefix + "D";                                         // Contains the prefix, not under it.
+    const std::string sibling = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.TreeTestX.E";
+    EXPECT_EQ(setLocalParam(pcCallerID, (prefix + "B").c_str(), "2"), tr181Success);
+    EXPECT_EQ(setLocalParam(pcCallerID, (prefix + "Sub.C").c_str(), "3"), tr181Success);
+    EXPECT_EQ(setLocalParam(pcCallerID, (prefix + "A").c_str(), "1"), tr181Success);
+    EXPECT_EQ(setLocalParam(pcCallerID, mirror.c_str(), "4"), tr181Success);
+    EXPECT_EQ(setLocalParam(pcCallerID, sibling.c_str(), "5"), tr181Success);
+
+    std::vector<std::string> tree;
+    EXPECT_EQ(getLocalParamTree(pcCallerID, prefix.c_str(), collectLocalParam, &tree), tr181Success);
+    std::vector<std::string> expected = { prefix + "A=1", prefix + "B=2", prefix + "Sub.C=3" };
+    EXPECT_EQ(tree, expected);
+
+    // The same from the index, with journaled changes merged in name order.
+    ASSERT_TRUE(rfcLocalStoreCompact());
+    EXPECT_EQ(setLocalParam(pcCallerID, (prefix + "AA").c_str(), "6"), tr181Success);
+    EXPECT_EQ(clearLocalParam(pcCallerID, (prefix + "B").c_str()), tr181Success);
+    tree.clear();
+    EXPECT_EQ(getLocalParamTree(pcCallerID, prefix.c_str(), collectLocalParam, &tree), tr181Success);
+    expected = { prefix + "A=1", prefix + "AA=6", prefix + "Sub.C=3" };
+    EXPECT_EQ(tree, expected);
+    tree.clear();
+    EXPECT_EQ(getLocalParamTree(pcCallerID, (prefix + "Sub.").c_str(), collectLocalParam, &tree), tr181Success);
+    EXPECT_EQ(tree, std::vector<std::string>(1, prefix + "Sub.C=3"));
+
+    // A wildcard clear takes the subtree only.
+    EXPECT_EQ(clearLocalParam(pcCallerID, prefix.c_str()), tr181Success);
+    tree.clear();
+    EXPECT_EQ(getLocalParamTree(pcCallerID, prefix.c_str(), collectLocalParam, &tree), tr181Failure);
+    EXPECT_TRUE(tree.empty());
+    TR181_ParamData_t param;
+    EXPECT_EQ(getLocalParam(pcCallerID, mirror.c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "4");
+    EXPECT_EQ(getLocalParam(pcCallerID, sibling.c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "5");
+    EXPECT_EQ(clearLocalParam(pcCallerID, mirror.c_str()), tr181Success);
+    EXPECT_EQ(clearLocalParam(pcCallerID, sibling.c_str()), tr181Success);
+}
+
+static bool lockLocalStore(int fd, short type) {
+    struct flock fl;
+    memset(&fl, 0, sizeof(fl));
+    fl.l_type = type;
+    fl.l_whence = SEEK_SET;
+    return fcntl(fd, F_OFD_SETLK, &fl) == 0;
+}
+
+TEST(tr181apiTest, localStoreLock) {
+    char *pcCallerID = (char *)"rfcdefaults";
+    const std::string name = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.LockTest.Value";
+    TR181_ParamData_t param;
+
+    // A writer that died holding the lock does not block the others.
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        int fd = open(TR181_LOCAL_STORE_LOCK, O_RDWR | O_CREAT, 0666);
+        _exit(fd >= 0 && lockLocalStore(fd, F_WRLCK) ? 0 : 1);
+    }
+    int childStatus;
+    ASSERT_EQ(waitpid(pid, &childStatus, 0), pid);
+    ASSERT_TRUE(WIFEXITED(childStatus) && WEXITSTATUS(childStatus) == 0);
+    EXPECT_EQ(setLocalParam(pcCallerID, name.c_str(), "1"), tr181Success);
+
+    // While another writer holds the lock, a set waits and reads go on.
+    int fd = open(TR181_LOCAL_STORE_LOCK, O_RDWR);
+    ASSERT_GE(fd, 0);
+    ASSERT_TRUE(lockLocalStore(fd, F_WRLCK));
+    std::atomic<bool> done(false);
+    std::thread writer([&]() {
+        EXPECT_EQ(setLocalParam(pcCallerID, name.c_str(), "2"), tr181Success);
+        done = true;
+    });
+    usleep(200000);
+    EXPECT_FALSE(done);
+    EXPECT_EQ(getLocalParam(pcCallerID, name.c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "1");
+    EXPECT_TRUE(lockLocalStore(fd, F_UNLCK));
+    writer.join();
+    EXPECT_TRUE(done);
+    close(fd);
+    EXPECT_EQ(getLocalParam(pcCallerID, name.c_str(), &param), tr181Success);
+    EXPECT_STREQ(param.value, "2");
+    EXPECT_EQ(clearLocalParam(pcCallerID, name.c_str()), tr181Success);
+}
+
 TEST(tr181apiTest, getParam) {
     writeToTr181storeFile("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.IncrementalCDL.Enable", "true", "/opt/secure/RFC/tr181store.ini", Plain);
     const char* pcParameterName = "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.IncrementalCDL.Enable";
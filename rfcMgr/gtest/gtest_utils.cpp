@@ -26,6 +26,7 @@
 #include <iostream>
 #include <cstdio>
 #include <fstream>
+#include <iterator>
 #include <string>
 #include <iostream>
 #include "tr181api.h"
@@ -44,6 +45,7 @@ extern int (*getSetAttributeFunc())(char * const, char, char *);
 extern int (*getGetAttributeFunc())(char * const);
 extern size_t (*getWriteCurlResponse(void))(void *ptr, size_t size, size_t nmemb, std::string stream);
 extern int (*getparseargsFunc())(int argc, char * argv[]);
+extern int (*getShowStatsFunc())();
 #endif
 
 TEST(utilsTest, getParamType) {
@@ -107,6 +109,10 @@ TEST(utilsTest, CallsetAttribute_args) {
     int args_status = getparseargsFunc()(argc, argv);
     int status = getSetAttributeFunc()(pcParameterName, 'b', value);
     EXPECT_EQ(status, 0);
+    // Scripts reading the file see the set once the command returns.
+    std::ifstream store("/opt/secure/RFC/tr181localstore.ini");
+    std::string content((std::istreambuf_iterator<char>(store)), std::istreambuf_iterator<char>());
+    EXPECT_NE(content.find(std::string(pcParameterName) + "=false\n"), std::string::npos);
 }
 
 TEST(utilsTest, CallgetAttribute_args) {
@@ -121,6 +127,16 @@ TEST(utilsTest, CallgetAttribute_args) {
     EXPECT_EQ(status, 0);
 }
 
+TEST(utilsTest, CallshowStats) {
+    char* argv[] = { (char*)"tr181", (char*)"--stats" };
+    EXPECT_EQ(getparseargsFunc()(2, argv), 0);
+    setRFCStatsEnabled(true);
+    RFC_ParamData_t param;
+    getRFCParameter("utilsTest", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.MOCASSH.Enable", &param);
+    setRFCStatsEnabled(false);
+    EXPECT_EQ(getShowStatsFunc()(), 0);
+}
+
 TEST(utilsTest, CallreadFromFile) {
     std::string jsonString = R"({"jsonrpc":"2.0","id":3,"result":{"experience":"X1","success":true}})";
     write_on_file("/tmp/test.json", jsonString);    	
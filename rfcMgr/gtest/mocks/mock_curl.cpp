@@ -2,6 +2,10 @@
 #include <curl/curl.h>
 #include <cstdarg>
 #include <string>
+#include <map>
+#include <mutex>
+#include <vector>
+#include <poll.h>
 
 long simulated_http_code = 200;
 CURLcode simulated_curl_result = CURLE_OK;
@@ -15,11 +19,53 @@ std::string simulated_response_body = R"({
   }],
   "statusCode": 0
 })";
+std::string simulated_request_body;
+// Last CURLOPT_UNIX_SOCKET_PATH seen, and the result of transfers that used one.
+std::string simulated_unix_socket_path;
+CURLcode simulated_unix_socket_result = CURLE_OK;
+// Last CURLOPT_TIMEOUT_MS seen.
+long simulated_timeout_ms = 0;
 
 // Globals to store the user-provided write callback and userdata
 static curl_write_callback g_write_callback = nullptr;
 static void* g_write_data = nullptr;
 
+// Per-handle callbacks so concurrent transfers on the multi handle do not mix.
+struct MockTransfer {
+    curl_write_callback callback = nullptr;
+    void* data = nullptr;
+    bool unixSocket = false;
+};
+static std::mutex g_mock_mutex;
+static std::map<CURL*, MockTransfer> g_transfers;
+static std::vector<CURL*> g_multi_pending;
+static std::vector<std::pair<CURL*, CURLcode>> g_multi_done;
+static CURLMsg g_multi_msg;
+static int g_multi_dummy;
+
+static CURLcode deliver_response(CURL* curl) {
+    MockTransfer t;
+    {
+        std::lock_guard<std::mutex> lock(g_mock_mutex);
+        std::map<CURL*, MockTransfer>::iterator it = g_transfers.find(curl);
+        if (it != g_transfers.end()) {
+            t = it->second;
+            it->second.unixSocket = false;
+        }
+    }
+    if (t.unixSocket && simulated_unix_socket_result != CURLE_OK)
+        return simulated_unix_socket_result;
+    if (!t.callback) {
+        std::lock_guard<std::mutex> lock(g_mock_mutex);
+        t.callback = g_write_callback;
+        t.data = g_write_data;
+    }
+    if (t.callback && !simulated_response_body.empty()) {
+        t.callback(const_cast<char*>(simulated_response_body.c_str()), 1, simulated_response_body.size(), t.data);
+    }
+    return simulated_curl_result;
+}
+
 extern "C" {
 
 CURLcode curl_easy_setopt(CURL* curl, CURLoption option, ...) {
@@ -27,9 +73,26 @@ CURLcode curl_easy_setopt(CURL* curl, CURLoption option, ...) {
     va_start(args, option);
 
     if (option == CURLOPT_WRITEFUNCTION) {
-        g_write_callback = va_arg(args, curl_write_callback);
+        curl_write_callback callback = va_arg(args, curl_write_callback);
+        std::lock_guard<std::mutex> lock(g_mock_mutex);
+        g_write_callback = callback;
+        g_transfers[curl].callback = callback;
     } else if (option == CURLOPT_WRITEDATA) {
-        g_write_data = va_arg(args, void*);
+        void* data = va_arg(args, void*);
+        std::lock_guard<std::mutex> lock(g_mock_mutex);
+        g_write_data = data;
+        g_transfers[curl].data = data;
+    } else if (option == CURLOPT_UNIX_SOCKET_PATH) {
+        const char* path = va_arg(args, const char*);
+        std::lock_guard<std::mutex> lock(g_mock_mutex);
+        simulated_unix_socket_path = path ? path : "";
+        g_transfers[curl].unixSocket = path != nullptr;
+    } else if (option == CURLOPT_TIMEOUT_MS) {
+        simulated_timeout_ms = va_arg(args, long);
+    } else if (option == CURLOPT_POSTFIELDS) {
+        const char* body = va_arg(args, const char*);
+        std::lock_guard<std::mutex> lock(g_mock_mutex);
+        simulated_request_body = body ? body : "";
     } else {
         // Ignore other options for now
         (void)va_arg(args, void*);
@@ -40,12 +103,9 @@ CURLcode curl_easy_setopt(CURL* curl, CURLoption option, ...) {
 }
 
 CURLcode curl_easy_perform(CURL* curl) {
-    if (g_write_callback && !simulated_response_body.empty()) {
-        // Call the write callback exactly like libcurl would:
-        // size=1, nmemb=length of data
-	 g_write_callback(const_cast<char*>(simulated_response_body.c_str()), 1, simulated_response_body.size(), g_write_data);
-    }
-    return simulated_curl_result;
+    // Call the write callback exactly like libcurl would:
+    // size=1, nmemb=length of data
+    return deliver_response(curl);
 }
 
 CURLcode curl_easy_getinfo(CURL* curl, CURLINFO info, ...) {
@@ -61,4 +121,81 @@ CURLcode curl_easy_getinfo(CURL* curl, CURLINFO info, ...) {
     return CURLE_OK;
 }
 
+// Multi interface: every added transfer completes on the next curl_multi_perform().
+CURLM* curl_multi_init(void) {
+    return reinterpret_cast<CURLM*>(&g_multi_dummy);
+}
+
+CURLMcode curl_multi_add_handle(CURLM* multi, CURL* curl) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
+    g_multi_pending.push_back(curl);
+    return CURLM_OK;
+}
+
+CURLMcode curl_multi_remove_handle(CURLM* multi, CURL* curl) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
+    for (size_t i = 0; i < g_multi_pending.size(); i++) {
+        if (g_multi_pending[i] == curl) {
+            g_multi_pending.erase(g_multi_pending.begin() + i);
+            break;
+        }
+    }
+    g_transfers.erase(curl);
+    return CURLM_OK;
+}
+
+CURLMcode curl_multi_perform(CURLM* multi, int* running_handles) {
+    std::vector<CURL*> pending;
+    {
+        std::lock_guard<std::mutex> lock(g_mock_mutex);
+        pending.swap(g_multi_pending);
+    }
+    std::vector<std::pair<CURL*, CURLcode>> done;
+    for (size_t i = 0; i < pending.size(); i++)
+        done.push_back(std::make_pair(pending[i], deliver_response(pending[i])));
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
+    g_multi_done.insert(g_multi_done.end(), done.begin(), done.end());
+    *running_handles = 0;
+    return CURLM_OK;
+}
+
+CURLMsg* curl_multi_info_read(CURLM* multi, int* msgs_in_queue) {
+    std::lock_guard<std::mutex> lock(g_mock_mutex);
+    if (g_multi_done.empty()) {
+        *msgs_in_queue = 0;
+        return nullptr;
+    }
+    memset(&g_multi_msg, 0, sizeof(g_multi_msg));
+    g_multi_msg.msg = CURLMSG_DONE;
+    g_multi_msg.easy_handle = g_multi_done.front().first;
+    g_multi_msg.data.result = g_multi_done.front().second;
+    g_multi_done.erase(g_multi_done.begin());
+    *msgs_in_queue = (int)g_multi_done.size();
+    return &g_multi_msg;
+}
+
+CURLMcode curl_multi_wait(CURLM* multi, struct curl_waitfd extra_fds[], unsigned int extra_nfds, int timeout_ms, int* numfds) {
+    {
+        std::lock_guard<std::mutex> lock(g_mock_mutex);
+        if (!g_multi_pending.empty() || !g_multi_done.empty())
+            timeout_ms = 0;
+    }
+    std::vector<struct pollfd> fds(extra_nfds);
+    for (unsigned int i = 0; i < extra_nfds; i++) {
+        fds[i].fd = extra_fds[i].fd;
+        fds[i].events = POLLIN;
+        fds[i].revents = 0;
+    }
+    int n = poll(fds.data(), extra_nfds, timeout_ms);
+    for (unsigned int i = 0; i < extra_nfds; i++)
+        extra_fds[i].revents = (fds[i].revents & POLLIN) ? CURL_WAIT_POLLIN : 0;
+    if (numfds)
+        *numfds = n > 0 ? n : 0;
+    return CURLM_OK;
+}
+
+CURLMcode curl_multi_cleanup(CURLM* multi) {
+    return CURLM_OK;
+}
+
 }
@@ -185,24 +185,25 @@ int read_RFCProperty(const char* type, const char* key, char *out_value, int dat
 
     rbus_close(handle);
 #else
-    RFC_ParamData_t param;
-    memset(&param, 0, sizeof(RFC_ParamData_t));
-
-    int data_len;
-    WDMP_STATUS status = getRFCParameter(type, key, &param);
-    if(status == WDMP_SUCCESS || status == WDMP_ERR_DEFAULT_VALUE)
+    size_t data_len = (size_t)datasize;
+    DATA_TYPE data_type = WDMP_NONE;
+    // Read straight into out_value, without a 4 KiB RFC_ParamData_t on the stack.
+    WDMP_STATUS status = getRFCParameterValue(type, key, out_value, &data_len, &data_type);
+    bool truncated = (status == WDMP_STATUS_RESOURCES && data_len >= (size_t)datasize);
+    if(status == WDMP_SUCCESS || status == WDMP_ERR_DEFAULT_VALUE || truncated)
     {
-        data_len = strlen(param.value);
-        if(data_len >= 2 && (param.value[0] == '"') && (param.value[data_len - 1] == '"'))
+        if (truncated)
         {
-            snprintf(out_value, datasize, "%s", &param.value[1]);
-            *(out_value + data_len - 2) = 0;
+            RDK_LOG(RDK_LOG_DEBUG, LOG_RFCMGR, "[%s][%d] RFC value of %s truncated to %d bytes\n", __FUNCTION__, __LINE__, key, datasize);
+            data_len = strlen(out_value);
         }
-        else
+        if(data_len >= 2 && (out_value[0] == '"') && (truncated || out_value[data_len - 1] == '"'))
         {
-            snprintf(out_value, datasize, "%s", param.value);
+            size_t unquoted_len = truncated ? data_len - 1 : data_len - 2;
+            memmove(out_value, out_value + 1, unquoted_len);
+            out_value[unquoted_len] = 0;
         }
-        RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s][%d] RFC name=%s,type=%d,value=%s,status=%d\n", __FUNCTION__, __LINE__, param.name, param.type, param.value, status);
+        RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s][%d] RFC name=%s,type=%d,value=%s,status=%d\n", __FUNCTION__, __LINE__, key, data_type, out_value, status);
         ret = READ_RFC_SUCCESS;
     }
     else
@@ -2499,6 +2499,8 @@ void RuntimeFeatureControlProcessor::processXconfResponseConfigDataPart(JSON *fe
     std::string newKey;
     std::string newValue;
     std::string currentValue;
+    std::vector<std::pair<std::string, std::string>> pendingSets;
+    std::vector<std::string> pendingCurrentValues;
    
      // Iterating through the map
     for (const auto& pair : _RFCKeyAndValueMap) {
@@ -2535,65 +2537,82 @@ void RuntimeFeatureControlProcessor::processXconfResponseConfigDataPart(JSON *fe
     	        }
 	    }
 		
-            WDMP_STATUS status = set_RFCProperty(name, newKey, newValue);
-            if (status != WDMP_SUCCESS)
-            {
+            pendingSets.emplace_back(newKey, newValue);
+            pendingCurrentValues.push_back(currentValue);
+        }
+        std::string data = "TR181: " + newKey + " " + newValue;
+
+        paramList.push_back(std::move(data));
+    }
+
+    // Apply every changed key with one batched hostif request instead of one round trip per key.
+    std::vector<WDMP_STATUS> statuses;
+    set_RFCProperties(name, pendingSets, statuses);
+    for (size_t i = 0; i < pendingSets.size(); i++)
+    {
+        newKey = pendingSets[i].first;
+        newValue = pendingSets[i].second;
+        currentValue = pendingCurrentValues[i];
+        WDMP_STATUS status = statuses[i];
+        if (status != WDMP_SUCCESS)
+        {
 #if !defined(RDKB_SUPPORT) && !defined(RDKC)
-                RDK_LOG(RDK_LOG_DEBUG, LOG_RFCMGR,"[%s][%d] SET failed for key=%s with status=%s\n", __FUNCTION__, __LINE__, newKey.c_str(), getRFCErrorString(status));
+            RDK_LOG(RDK_LOG_DEBUG, LOG_RFCMGR,"[%s][%d] SET failed for key=%s with status=%s\n", __FUNCTION__, __LINE__, newKey.c_str(), getRFCErrorString(status));
 #else	
-                RDK_LOG(RDK_LOG_DEBUG, LOG_RFCMGR,"[%s][%d] SET failed for key=%s with status=%d\n", __FUNCTION__, __LINE__, newKey.c_str(), status);
+            RDK_LOG(RDK_LOG_DEBUG, LOG_RFCMGR,"[%s][%d] SET failed for key=%s with status=%d\n", __FUNCTION__, __LINE__, newKey.c_str(), status);
 #endif			    
-            }
-            else
+        }
+        else
+        {
+            if (newValue != currentValue)
             {
-                if (newValue != currentValue)
-                {
-                    RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s][%d] updated for %s from value old=%s, to new=%s\n", __FUNCTION__, __LINE__,newKey.c_str(), currentValue.c_str(), newValue.c_str());
-                    if(newKey == TELEMETRY_CONFIG_URL){
-    	                if (!newValue.empty() && newValue.find("https://") == 0) {
-                            RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s:%d] Notifying Telemetry of Config URL update.\n", __FUNCTION__, __LINE__);
-                            int systemRet = v_secure_system("killall -12 telemetry2_0");
-                            if (systemRet == -1) {
-                                RDK_LOG(RDK_LOG_ERROR, LOG_RFCMGR, "[%s:%d] Notification to Telemetry failed.\n", __FUNCTION__, __LINE__);
-                            } else {
-                                RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s:%d]  Notification to Telemetry success, return code = %d\n", __FUNCTION__, __LINE__, systemRet);
-                            }
+                RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s][%d] updated for %s from value old=%s, to new=%s\n", __FUNCTION__, __LINE__,newKey.c_str(), currentValue.c_str(), newValue.c_str());
+                if(newKey == TELEMETRY_CONFIG_URL){
+	                if (!newValue.empty() && newValue.find("https://") == 0) {
+                        RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s:%d] Notifying Telemetry of Config URL update.\n", __FUNCTION__, __LINE__);
+                        int systemRet = v_secure_system("killall -12 telemetry2_0");
+                        if (systemRet == -1) {
+                            RDK_LOG(RDK_LOG_ERROR, LOG_RFCMGR, "[%s:%d] Notification to Telemetry failed.\n", __FUNCTION__, __LINE__);
+                        } else {
+                            RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s:%d]  Notification to Telemetry success, return code = %d\n", __FUNCTION__, __LINE__, systemRet);
                         }
-    		        else{
+                    }
+		        else{
 		            RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s:%d] Invalid Telemetry Config URL.\n", __FUNCTION__, __LINE__);
-    		         }
+		         }
   		    }
-                    std::string account_key_str = RFC_ACCOUNT_ID_KEY_STR;
-                    bool isAccountKey = (newKey.find(account_key_str) != std::string::npos) ? true : false;
-                    if(isAccountKey == true)
-                    {
-                        NotifyTelemetry2Count("SYST_INFO_ACCID_set");
-                    }
+                std::string account_key_str = RFC_ACCOUNT_ID_KEY_STR;
+                bool isAccountKey = (newKey.find(account_key_str) != std::string::npos) ? true : false;
+                if(isAccountKey == true)
+                {
+                    NotifyTelemetry2Count("SYST_INFO_ACCID_set");
+                }
 #if !defined(RDKB_SUPPORT) && !defined(RDKC)
-                    if (isMaintenanceEnabled())
-                    {
-                        isRebootRequired = true;
-                    }
+                if (isMaintenanceEnabled())
+                {
+                    isRebootRequired = true;
+                }
 #endif
 #ifdef RDKC
-                    if (shouldScheduleCameraReboot(newKey, _effectiveImmediateParams, currentValue, newValue))
-                        _rfcRebootCronNeeded = true;
+                if (shouldScheduleCameraReboot(newKey, _effectiveImmediateParams, currentValue, newValue))
+                    _rfcRebootCronNeeded = true;
 #endif		    
-                }
-                else
-                {
-                    RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s][%d] reapplied for %s the same value old=%s, new=%s\n", __FUNCTION__, __LINE__,newKey.c_str(), currentValue.c_str(), newValue.c_str());
-                }
-            }    
-        }
-        std::string data = "TR181: " + newKey + " " + newValue;
-
-        paramList.push_back(std::move(data));
+            }
+            else
+            {
+                RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s][%d] reapplied for %s the same value old=%s, new=%s\n", __FUNCTION__, __LINE__,newKey.c_str(), currentValue.c_str(), newValue.c_str());
+            }
+        }    
     }
 
     updateTR181File(TR181_FILE_LIST, paramList);
 #if !defined(RDKB_SUPPORT) && !defined(RDKC)
     clearDBEnd();
+    // Let librfcapi clients read the applied parameters without a hostif round trip.
+    if (publishRFCSnapshot(name.c_str()) != WDMP_SUCCESS)
+    {
+        RDK_LOG(RDK_LOG_INFO, LOG_RFCMGR, "[%s][%d] RFC snapshot not published\n", __FUNCTION__, __LINE__);
+    }
 #endif
 
 #ifdef RDKC
@@ -2844,6 +2863,65 @@ WDMP_STATUS RuntimeFeatureControlProcessor::set_RFCProperty(std::string name, st
 #endif
 }
 
+void RuntimeFeatureControlProcessor::set_RFCProperties(std::string name, const std::vector<std::pair<std::string, std::string>> &keyValues, std::vector<WDMP_STATUS> &statuses)
+{
+    statuses.assign(keyValues.size(), WDMP_FAILURE);
+    if (keyValues.empty())
+    {
+        return;
+    }
+#if defined(RDKB_SUPPORT) || defined(RDKC)
+    for (size_t i = 0; i < keyValues.size(); i++)
+    {
+        statuses[i] = set_RFCProperty(name, keyValues[i].first, keyValues[i].second);
+    }
+#else
+    // hostif needs each parameter's current type: fetch all of them in one request, then set all of them in one request.
+    std::vector<const char *> keys;
+    for (const auto& kv : keyValues)
+    {
+        keys.push_back(kv.first.c_str());
+    }
+    std::vector<RFC_ParamData_t> params(keyValues.size());
+    std::vector<WDMP_STATUS> getStatus(keyValues.size(), WDMP_FAILURE);
+    getRFCParameters(NULL, keys.data(), keys.size(), params.data(), getStatus.data());
+
+    std::vector<RFC_SetParamData_t> setParams;
+    std::vector<size_t> setIndex;
+    for (size_t i = 0; i < keyValues.size(); i++)
+    {
+        if (params[i].type != WDMP_NONE)
+        {
+            RDK_LOG(RDK_LOG_DEBUG, LOG_RFCMGR, "[%s][%d] key=%s Parameter Type=%d\n", __FUNCTION__, __LINE__, keys[i], params[i].type);
+            RFC_SetParamData_t param = { keys[i], keyValues[i].second.c_str(), params[i].type };
+            setParams.push_back(param);
+            setIndex.push_back(i);
+        }
+        else
+        {
+            RDK_LOG(RDK_LOG_ERROR, LOG_RFCMGR, "[%s][%d] Failed to retrieve %s : Reason:%s\n", __FUNCTION__, __LINE__, keys[i], getRFCErrorString(getStatus[i]));
+            statuses[i] = getStatus[i];
+        }
+    }
+    if (setParams.empty())
+    {
+        return;
+    }
+
+    std::vector<WDMP_STATUS> setStatus(setParams.size(), WDMP_FAILURE);
+    setRFCParameters(name.c_str(), setParams.data(), setParams.size(), setStatus.data());
+    for (size_t j = 0; j < setParams.size(); j++)
+    {
+        statuses[setIndex[j]] = setStatus[j];
+        if (setStatus[j] != WDMP_SUCCESS)
+        {
+            RDK_LOG(RDK_LOG_DEBUG, LOG_RFCMGR,"[%s][%d] setRFCParameters failed. key=%s and status=%s\n", __FUNCTION__, __LINE__, setParams[j].name, getRFCErrorString(setStatus[j]));
+        }
+    }
+    RDK_LOG(RDK_LOG_DEBUG, LOG_RFCMGR,"[%s][%d] setRFCParameters applied %zu parameters\n", __FUNCTION__, __LINE__, setParams.size());
+#endif
+}
+
 void RuntimeFeatureControlProcessor::updateTR181File(const std::string& filename, std::list<std::string>& paramList) 
 {
     std::string fullPath = std::string(DIRECTORY_PATH) + filename;
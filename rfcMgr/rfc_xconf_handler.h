@@ -270,6 +270,7 @@ class RuntimeFeatureControlProcessor : public xconf::XconfHandler
         void CreateConfigDataValueMap(JSON *features);
         bool isConfigValueChange(std ::string name, std ::string key, std ::string &value, std ::string &paramValue);
         WDMP_STATUS set_RFCProperty(std ::string name, std ::string key, std ::string value);
+        void set_RFCProperties(std::string name, const std::vector<std::pair<std::string, std::string>> &keyValues, std::vector<WDMP_STATUS> &statuses);
         void updateTR181File(const std::string& filename, std::list<std::string>& paramList); 
 	void NotifyTelemetry2RemoteFeatures(const char *rfcFeatureList, std ::string rfcstatus);
         void WriteFile(const std::string& filename, const std::string& data); 
@@ -312,6 +313,7 @@ class RuntimeFeatureControlProcessor : public xconf::XconfHandler
     FRIEND_TEST(rfcMgrTest, isMaintenanceEnabled);
     FRIEND_TEST(rfcMgrTest, GetOsClass);
     FRIEND_TEST(rfcMgrTest, set_RFCProperty);
+    FRIEND_TEST(rfcMgrTest, set_RFCProperties);
     FRIEND_TEST(rfcMgrTest, GetValidPartnerId);
     FRIEND_TEST(rfcMgrTest, GetValidAccountId);
     FRIEND_TEST(rfcMgrTest, CreateXconfHTTPUrl);
@@ -0,0 +1,138 @@
+/**
+ * @file bench_server.h
+ * @brief Stand-in hostif HTTP server shared by the librfcapi benchmarks.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Every request is answered with the same get response for BENCH_PARAM.
+ * Each connection is served on its own thread, so concurrent clients do not
+ * queue behind each other.
+ */
+
+#ifndef RFCAPI_BENCH_SERVER_H_
+#define RFCAPI_BENCH_SERVER_H_
+
+#include <string>
+#include <thread>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#define BENCH_TCP_PORT 11999
+#define BENCH_SOCKET_PATH "/tmp/rfcapi_bench.sock"
+#define BENCH_READY_FILE "/tmp/.tr69hostif_http_server_ready"
+#define BENCH_PARAM "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Bench.Enable"
+
+static const char benchBody[] =
+   "{\"parameters\":[{\"name\":\"" BENCH_PARAM "\",\"value\":\"true\",\"dataType\":3,"
+   "\"parameterCount\":1,\"message\":\"Success\"}],\"statusCode\":0}";
+
+/** @brief Answer every request on one connection with benchBody until the client closes it. */
+static void serveConnection(int fd)
+{
+   char reply[512];
+   int replyLen = snprintf(reply, sizeof(reply),
+                           "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: %zu\r\n\r\n%s",
+                           sizeof(benchBody) - 1, benchBody);
+   std::string request;
+   char buf[4096];
+   for (;;)
+   {
+      ssize_t n = read(fd, buf, sizeof(buf));
+      if (n <= 0)
+         break;
+      request.append(buf, n);
+
+      // One request is the header block plus Content-Length bytes of body.
+      size_t end;
+      while ((end = request.find("\r\n\r\n")) != std::string::npos)
+      {
+         size_t bodyLen = 0;
+         size_t pos = request.find("Content-Length:");
+         if (pos != std::string::npos && pos < end)
+            bodyLen = strtoul(request.c_str() + pos + 15, NULL, 10);
+         if (request.size() < end + 4 + bodyLen)
+            break;
+         request.erase(0, end + 4 + bodyLen);
+         if (write(fd, reply, replyLen) != replyLen)
+            return;
+      }
+   }
+}
+
+static void serve(int listenFd)
+{
+   for (;;)
+   {
+      int fd = accept(listenFd, NULL, NULL);
+      if (fd < 0)
+      {
+         if (errno == EINTR)
+            continue;
+         return;
+      }
+      std::thread([fd]() {
+         serveConnection(fd);
+         close(fd);
+      }).detach();
+   }
+}
+
+static int listenTcp()
+{
+   int fd = socket(AF_INET, SOCK_STREAM, 0);
+   int on = 1;
+   setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+   struct sockaddr_in addr;
+   memset(&addr, 0, sizeof(addr));
+   addr.sin_family = AF_INET;
+   addr.sin_port = htons(BENCH_TCP_PORT);
+   addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+   if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 64) != 0)
+   {
+      fprintf(stderr, "cannot listen on 127.0.0.1:%d: %s (is tr69hostif running?)\n", BENCH_TCP_PORT, strerror(errno));
+      close(fd);
+      return -1;
+   }
+   return fd;
+}
+
+static int listenUnix()
+{
+   int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+   struct sockaddr_un addr;
+   memset(&addr, 0, sizeof(addr));
+   addr.sun_family = AF_UNIX;
+   strncpy(addr.sun_path, BENCH_SOCKET_PATH, sizeof(addr.sun_path) - 1);
+   unlink(BENCH_SOCKET_PATH);
+   if (bind(fd, (struct sockaddr *)&addr, sizeof(addr)) != 0 || listen(fd, 64) != 0)
+   {
+      fprintf(stderr, "cannot listen on %s: %s\n", BENCH_SOCKET_PATH, strerror(errno));
+      close(fd);
+      return -1;
+   }
+   return fd;
+}
+
+#endif
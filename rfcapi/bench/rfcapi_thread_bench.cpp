@@ -0,0 +1,146 @@
+/**
+ * @file rfcapi_thread_bench.cpp
+ * @brief Aggregate getRFCParameter() throughput from 1, 4 and 16 threads
+ *        against a local stand-in hostif server.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Build with "make rfcapi_thread_bench" and run on a development host, or
+ * on a box with tr69hostif stopped: the stand-in server needs port 11999.
+ * The cache is disabled, so every call is a hostif request.
+ *
+ * Usage: rfcapi_thread_bench [seconds per run] [thread counts...]
+ */
+
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "rfcapi.h"
+#include "bench_server.h"
+
+#define BENCH_WARMUP 20
+
+static std::atomic<bool> running(false);
+
+static double nowSeconds()
+{
+   struct timespec ts;
+   clock_gettime(CLOCK_MONOTONIC, &ts);
+   return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/** @brief Call getRFCParameter() until running is cleared. */
+static void worker(long *calls, long *failures)
+{
+   RFC_ParamData_t param;
+   for (int i = 0; i < BENCH_WARMUP; i++)
+      getRFCParameter("rfcbench", BENCH_PARAM, &param);
+   while (!running.load(std::memory_order_acquire))
+      std::this_thread::yield();
+   long n = 0, failed = 0;
+   while (running.load(std::memory_order_relaxed))
+   {
+      if (getRFCParameter("rfcbench", BENCH_PARAM, &param) != WDMP_SUCCESS)
+         failed++;
+      n++;
+   }
+   *calls = n;
+   *failures = failed;
+}
+
+/** @brief Run @p threads workers for @p seconds and print the aggregate rate. */
+static bool run(const char *label, int threads, double seconds)
+{
+   std::vector<long> calls(threads), failures(threads);
+   std::vector<std::thread> pool;
+   for (int i = 0; i < threads; i++)
+      pool.push_back(std::thread(worker, &calls[i], &failures[i]));
+
+   // Let every worker warm up its connection before the clock starts.
+   usleep(200 * 1000);
+   double start = nowSeconds();
+   running.store(true, std::memory_order_release);
+   usleep((useconds_t)(seconds * 1e6));
+   running.store(false, std::memory_order_relaxed);
+   double wall = nowSeconds() - start;
+   for (size_t i = 0; i < pool.size(); i++)
+      pool[i].join();
+
+   long total = 0, failed = 0;
+   for (int i = 0; i < threads; i++)
+   {
+      total += calls[i];
+      failed += failures[i];
+   }
+   printf("%-4s %3d threads  %10.0f gets/s  %8.1f us/call/thread  %ld failures\n",
+          label, threads, total / wall, threads * wall * 1e6 / (total ? total : 1), failed);
+   return failed == 0;
+}
+
+int main(int argc, char *argv[])
+{
+   double seconds = argc > 1 ? strtod(argv[1], NULL) : 2.0;
+   if (seconds <= 0)
+      seconds = 2.0;
+   std::vector<int> counts;
+   for (int i = 2; i < argc; i++)
+   {
+      int n = atoi(argv[i]);
+      if (n > 0)
+         counts.push_back(n);
+   }
+   if (counts.empty())
+      counts = {1, 4, 16};
+
+   int tcpFd = listenTcp();
+   int unixFd = listenUnix();
+   if (tcpFd < 0 || unixFd < 0)
+      return 1;
+   std::thread(serve, tcpFd).detach();
+   std::thread(serve, unixFd).detach();
+
+   struct stat st;
+   bool createdReady = stat(BENCH_READY_FILE, &st) != 0;
+   if (createdReady)
+   {
+      FILE *fp = fopen(BENCH_READY_FILE, "w");
+      if (fp)
+         fclose(fp);
+   }
+   setRFCCacheTTL(0);
+   setRFCNegativeCacheTTL(0);
+
+   printf("The stand-in server runs in this process and shares its CPUs.\n");
+   bool ok = true;
+   setRFCHostifSocket(NULL);
+   for (size_t i = 0; i < counts.size(); i++)
+      ok = run("TCP", counts[i], seconds) && ok;
+   setRFCHostifSocket(BENCH_SOCKET_PATH);
+   for (size_t i = 0; i < counts.size(); i++)
+      ok = run("UDS", counts[i], seconds) && ok;
+
+   if (createdReady)
+      unlink(BENCH_READY_FILE);
+   unlink(BENCH_SOCKET_PATH);
+   return ok ? 0 : 1;
+}
@@ -0,0 +1,132 @@
+/**
+ * @file rfcapi_transport_bench.cpp
+ * @brief Per-call latency and CPU of getRFCParameter() over loopback TCP and
+ *        over the hostif Unix domain socket, against a local stand-in server.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Build with "make rfcapi_transport_bench" and run on a development host, or
+ * on a box with tr69hostif stopped: the stand-in server needs port 11999.
+ * Run it with LD_DEBUG=statistics to also see the dynamic linker's startup
+ * cost, e.g. to compare a --enable-rfcapi-lite build with the default one.
+ *
+ * Usage: rfcapi_transport_bench [iterations]
+ */
+
+#include <thread>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include "rfcapi.h"
+#include "bench_server.h"
+
+#define BENCH_WARMUP 100
+
+static double elapsedUs(const struct timespec &start, const struct timespec &end)
+{
+   return (end.tv_sec - start.tv_sec) * 1e6 + (end.tv_nsec - start.tv_nsec) / 1e3;
+}
+
+/** @brief Print the resident set size, now and at its peak, from /proc/self/status. */
+static void printRss()
+{
+   FILE *fp = fopen("/proc/self/status", "r");
+   if (fp == NULL)
+      return;
+   long rss = -1, hwm = -1;
+   char line[128];
+   while (fgets(line, sizeof(line), fp) != NULL)
+   {
+      sscanf(line, "VmRSS: %ld", &rss);
+      sscanf(line, "VmHWM: %ld", &hwm);
+   }
+   fclose(fp);
+   printf("RSS %ld kB, peak %ld kB\n", rss, hwm);
+}
+
+static double cpuUs()
+{
+   struct rusage ru;
+   getrusage(RUSAGE_SELF, &ru);
+   return (ru.ru_utime.tv_sec + ru.ru_stime.tv_sec) * 1e6 + ru.ru_utime.tv_usec + ru.ru_stime.tv_usec;
+}
+
+/** @brief Time @p iterations getRFCParameter() calls over the currently configured transport. */
+static bool run(const char *label, long iterations)
+{
+   RFC_ParamData_t param;
+   for (int i = 0; i < BENCH_WARMUP; i++)
+      getRFCParameter("rfcbench", BENCH_PARAM, &param);
+
+   long failures = 0;
+   struct timespec start, end;
+   double cpuStart = cpuUs();
+   clock_gettime(CLOCK_MONOTONIC, &start);
+   for (long i = 0; i < iterations; i++)
+   {
+      if (getRFCParameter("rfcbench", BENCH_PARAM, &param) != WDMP_SUCCESS)
+         failures++;
+   }
+   clock_gettime(CLOCK_MONOTONIC, &end);
+   double cpu = cpuUs() - cpuStart;
+   double wall = elapsedUs(start, end);
+
+   printf("%-4s %8ld calls  %8.1f us/call  %8.1f us CPU/call  %ld failures\n",
+          label, iterations, wall / iterations, cpu / iterations, failures);
+   return failures == 0;
+}
+
+int main(int argc, char *argv[])
+{
+   long iterations = argc > 1 ? strtol(argv[1], NULL, 10) : 2000;
+   if (iterations <= 0)
+      iterations = 2000;
+
+   int tcpFd = listenTcp();
+   int unixFd = listenUnix();
+   if (tcpFd < 0 || unixFd < 0)
+      return 1;
+   std::thread(serve, tcpFd).detach();
+   std::thread(serve, unixFd).detach();
+
+   struct stat st;
+   bool createdReady = stat(BENCH_READY_FILE, &st) != 0;
+   if (createdReady)
+   {
+      FILE *fp = fopen(BENCH_READY_FILE, "w");
+      if (fp)
+         fclose(fp);
+   }
+   // Measure the transport, not the in-process cache.
+   setRFCCacheTTL(0);
+
+   printf("CPU includes the in-process stand-in server.\n");
+   setRFCHostifSocket(NULL);
+   bool ok = run("TCP", iterations);
+   setRFCHostifSocket(BENCH_SOCKET_PATH);
+   ok = run("UDS", iterations) && ok;
+   printRss();
+
+   if (createdReady)
+      unlink(BENCH_READY_FILE);
+   unlink(BENCH_SOCKET_PATH);
+   return ok ? 0 : 1;
+}
@@ -20,9 +20,13 @@
  * limitations under the License.
  */
 
+#include <algorithm>
+#include <chrono>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <sstream>
-#if !defined(RDKB_SUPPORT) && !defined(RDKC)
+#if !defined(RDKB_SUPPORT) && !defined(RDKC) && !defined(RFCAPI_LITE_CLIENT)
 #include <curl/curl.h>
 #include "cJSON.h"
 #endif
@@ -30,29 +34,39 @@
 #include <vector>
 #include <sys/stat.h>
 #include <unistd.h>
-#include <dirent.h>
+#include <strings.h>
 #include "rfcapi.h"
+#include "rfcapi_internal.h"
+#include "rfcapi_defaults.h"
+#if !defined(RDKB_SUPPORT) && !defined(RDKC)
+#include "rfcapi_cache.h"
+#include "rfcapi_features.h"
+#include "rfcapi_hostif.h"
+#include "rfcapi_ready.h"
+#include "rfcapi_snapshot.h"
+#include "rfcapi_stats.h"
+#include "rfcapi_store.h"
+#include "rfcapi_transport.h"
+#include "rfcapi_watch.h"
+#include "rfcapi_writebehind.h"
+#endif
 #include "rdk_debug.h"
 using namespace std;
 
-#define LOG_RFCAPI  "LOG.RDK.RFCAPI"  /**< RDK Logger module name for rfcapi. */
-#define TR181_RFC_PREFIX   "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC"
-#define BOOTSTRAP_FILE "/opt/secure/RFC/bootstrap.ini"
-#define RFCDEFAULTS_FILE "/tmp/rfcdefaults.ini"
-#define RFCDEFAULTS_ETC_DIR "/etc/rfcdefaults/"
-#define RFC_FEATURE_DIR "/opt/secure/RFC/"
-
 #define CONNECTION_TIMEOUT 5
 #define TRANSFER_TIMEOUT 10
 
+#ifndef RFCAPI_LITE_CLIENT
 static const char *url = "http://127.0.0.1:11999";
-static bool tr69hostif_http_server_ready = false;
+#endif
 
 #ifdef TEMP_LOGGING
+static mutex logMutex;   /**< Serialises opening and writing logofs. */
 static ofstream logofs;
 
 static void openLogFile()
 {
+   lock_guard<mutex> lock(logMutex);
    if (!logofs.is_open())
       logofs.open("/opt/logs/rfcscript.log", ios_base::app); 
 }
@@ -61,441 +75,1237 @@ static string prefix()
 {
     time_t timer;
     char buffer[50];
-    struct tm* tm_info;
+    struct tm tm_info;
     time(&timer);
-    tm_info = localtime(&timer);
-    strftime(buffer, 50, "rfcapi:%Y-%m-%d %H:%M:%S ", tm_info);
+    localtime_r(&timer, &tm_info);
+    strftime(buffer, 50, "rfcapi:%Y-%m-%d %H:%M:%S ", &tm_info);
     return string(buffer);
 }
+
+/** Format one line outside the lock, then append it whole. */
+#define TEMP_LOG(expr) \
+   do { \
+      ostringstream tempLogLine; \
+      tempLogLine << prefix() << expr << '\n'; \
+      lock_guard<mutex> tempLogLock(logMutex); \
+      logofs << tempLogLine.str() << flush; \
+   } while (0)
 #endif
 
 /**
- * @brief Merge per-feature rfcdefaults ini files into a single combined file.
- * @retval true   Merge succeeded.
- * @retval false  /etc/rfcdefaults/ could not be opened.
+ * @brief Compile the per-feature rfcdefaults ini files.
+ *
+ * Publishes the sorted binary snapshot (RFCDEFAULTS_SNAPSHOT_FILE) and the
+ * merged text file (RFCDEFAULTS_FILE), each via a temp file and rename().
+ * Files are merged in sorted name order, so a name defined by several
+ * features always resolves to the first file. The snapshot is only
+ * published when running as root.
+ * @retval true   Compile succeeded.
+ * @retval false  /etc/rfcdefaults/ could not be opened or an output could not be written.
  */
 bool init_rfcdefaults()
 {
-   DIR *dir;
-   struct dirent *ent;
-   if ((dir = opendir ( RFCDEFAULTS_ETC_DIR )) != NULL)
+   return rfcDefaultsCompile(RFCDEFAULTS_ETC_DIR, RFCDEFAULTS_SNAPSHOT_FILE, RFCDEFAULTS_FILE);
+}
+
+#ifndef RFCAPI_LITE_CLIENT
+/** @brief cURL write callback — appends received data to a std::string. */
+static size_t writeCurlResponse(void *ptr, size_t size, size_t nmemb, string stream)
+{
+   size_t realsize = size * nmemb;
+   string temp(static_cast<const char*>(ptr), realsize);
+   stream.append(temp);
+   return realsize;
+}
+#endif
+
+#if !defined(RDKB_SUPPORT) && !defined(RDKC)
+#ifndef RFCAPI_LITE_CLIENT
+/**
+ * @brief Run curl_global_init() once per process, before the first handle is created.
+ *
+ * Left to curl_easy_init(), the global init is not thread-safe on older
+ * libcurl releases, so two threads making their first request together
+ * could both run it.
+ */
+void rfcCurlGlobalInit()
+{
+   static once_flag curlOnce;
+   call_once(curlOnce, []() {
+      CURLcode res = curl_global_init(CURL_GLOBAL_DEFAULT);
+      if (res != CURLE_OK)
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "rfcCurlGlobalInit: curl_global_init failed: %d\n", res);
+   });
+}
+
+/**
+ * @brief Easy handle kept by each thread for its synchronous requests.
+ *
+ * libcurl keeps the connection to hostif in the handle, so reusing it saves
+ * a connect and accept per call. A handle inherited across fork() shares its
+ * socket with the parent and is replaced.
+ */
+struct ThreadCurlHandle
+{
+   CURL *curl;
+   pid_t pid;
+
+   ThreadCurlHandle() : curl(NULL), pid(0) {}
+   ~ThreadCurlHandle()
    {
-      std::ofstream combined_file( RFCDEFAULTS_FILE ) ;
-      while ((ent = readdir (dir)) != NULL )
-      {
-         if (strstr(ent->d_name, ".ini"))
-         {
-            RDK_LOG (RDK_LOG_DEBUG, LOG_RFCAPI,"rfcdefaults file: %s\n", ent->d_name);
-            string filepath = RFCDEFAULTS_ETC_DIR;
-            std::ifstream file1( filepath.append(ent->d_name) ) ;
-            combined_file << file1.rdbuf();
-	    combined_file << "\n" ;
-         }
-      }
-      closedir (dir);
+      if (curl != NULL && pid == getpid())
+         curl_easy_cleanup(curl);
    }
+};
+
+static thread_local ThreadCurlHandle threadCurl;
+
+/** @brief This thread's handle with its options reset, or NULL if curl could not be initialised. */
+static CURL *threadCurlHandle()
+{
+   pid_t pid = getpid();
+   if (threadCurl.curl != NULL && threadCurl.pid != pid)
+   {
+      // Only the child's copy of the connection is closed.
+      curl_easy_cleanup(threadCurl.curl);
+      threadCurl.curl = NULL;
+   }
+   if (threadCurl.curl == NULL)
+   {
+      rfcCurlGlobalInit();
+      threadCurl.curl = curl_easy_init();
+      threadCurl.pid = pid;
+   }
+   else
+   {
+      // Clears the options but keeps the open connection.
+      curl_easy_reset(threadCurl.curl);
+   }
+   return threadCurl.curl;
+}
+
+/**
+ * @brief Create a hostif request handle with the CallerID header, URL, body and timeouts set.
+ * @param[in]  pcCallerID  Caller identifier, sent as the CallerID header.
+ * @param[in]  data        JSON request body; must outlive the transfer.
+ * @param[in]  isSet       true for a set (POST), false for a get.
+ * @param[out] response    Receives the response body during the transfer.
+ * @param[out] headers     Header list to release with rfcHostifRequestDone().
+ * @param[out] viaSocket   Set to true when the request goes over the hostif Unix domain socket.
+ * @param[in]  reuse       Use this thread's handle, keeping its connection to hostif open.
+ * @return Easy handle, or NULL if curl could not be initialised.
+ */
+CURL *rfcHostifRequestCreate(const char *pcCallerID, const string &data, bool isSet, string *response, struct curl_slist **headers, bool *viaSocket, bool reuse)
+{
+   rfcStatsNote(RFC_STATS_FROM_HOSTIF);
+   CURL *curl_handle = NULL;
+   if (reuse)
+      curl_handle = threadCurlHandle();
    else
    {
-      RDK_LOG (RDK_LOG_ERROR, LOG_RFCAPI,"Could not open dir %s \n", RFCDEFAULTS_ETC_DIR) ;
+      rfcCurlGlobalInit();
+      curl_handle = curl_easy_init();
+   }
+   if (!curl_handle)
+   {
+#ifdef TEMP_LOGGING
+      TEMP_LOG("Could not perform curl");
+#endif
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"Could not perform curl \n");
+      return NULL;
+   }
+
+   char pcCallerIDHeader[128];
+   if(pcCallerID)
+       snprintf(pcCallerIDHeader, sizeof(pcCallerIDHeader), "CallerID: %s", pcCallerID);
+   else
+       sprintf(pcCallerIDHeader, "CallerID: Unknown");
+   struct curl_slist *customHeadersList = NULL;
+   customHeadersList = curl_slist_append(customHeadersList, pcCallerIDHeader);
+   if(curl_easy_setopt(curl_handle, CURLOPT_HTTPHEADER, customHeadersList) != CURLE_OK){
+       RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_HTTPHEADER\n", __FUNCTION__, __LINE__);
+   }
+   if(curl_easy_setopt(curl_handle, CURLOPT_URL, url) != CURLE_OK){
+       RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_URL\n", __FUNCTION__, __LINE__);
+   }
+   if (isSet)
+   {
+       if(curl_easy_setopt(curl_handle, CURLOPT_HTTPPOST, 1L) != CURLE_OK){
+           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_HTTPPOST\n", __FUNCTION__, __LINE__);
+       }
+   }
+   else
+   {
+       if(curl_easy_setopt(curl_handle, CURLOPT_CUSTOMREQUEST, "GET") != CURLE_OK){
+           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_CUSTOMREQUEST\n", __FUNCTION__, __LINE__);
+       }
+   }
+   if(curl_easy_setopt(curl_handle, CURLOPT_POSTFIELDSIZE, (long) data.length()) != CURLE_OK){
+       RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_POSTFIELDSIZE\n", __FUNCTION__, __LINE__);
+   }
+   if(curl_easy_setopt(curl_handle, CURLOPT_POSTFIELDS, data.c_str()) != CURLE_OK){
+       RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_POSTFIELDS\n", __FUNCTION__, __LINE__);
+   }
+   if(curl_easy_setopt(curl_handle, CURLOPT_FOLLOWLOCATION, 1) != CURLE_OK){
+       RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_FOLLOWLOCATION\n", __FUNCTION__, __LINE__);
+   }
+   if(curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, writeCurlResponse) != CURLE_OK){
+       RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_WRITEFUNCTION\n", __FUNCTION__, __LINE__);
+   }
+   if(curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, response) != CURLE_OK){
+       RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_WRITEDATA\n", __FUNCTION__, __LINE__);
+   }
+   if (!isSet)
+   {
+       if(curl_easy_setopt(curl_handle, CURLOPT_CONNECTTIMEOUT, CONNECTION_TIMEOUT) != CURLE_OK){
+           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_CONNECTTIMEOUT\n", __FUNCTION__, __LINE__);
+       }
+       if(curl_easy_setopt(curl_handle, CURLOPT_TIMEOUT, TRANSFER_TIMEOUT) != CURLE_OK){
+           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_TIMEOUT\n", __FUNCTION__, __LINE__);
+       }
+   }
+   string socketPath;
+   *viaSocket = rfcTransportSocket(&socketPath);
+   if (*viaSocket)
+   {
+       if(curl_easy_setopt(curl_handle, CURLOPT_UNIX_SOCKET_PATH, socketPath.c_str()) != CURLE_OK){
+           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_UNIX_SOCKET_PATH\n", __FUNCTION__, __LINE__);
+       }
+   }
+   *headers = customHeadersList;
+   return curl_handle;
+}
+
+/**
+ * @brief Log the outcome of a hostif request and release its handle and headers.
+ *
+ * The calling thread's reusable handle is kept for its next request.
+ * @param[in] curl_handle  Handle from rfcHostifRequestCreate().
+ * @param[in] headers      Header list from rfcHostifRequestCreate().
+ * @param[in] res          Transfer result.
+ * @param[in] response     Response body.
+ */
+void rfcHostifRequestDone(CURL *curl_handle, struct curl_slist *headers, CURLcode res, const string &response)
+{
+   long http_code = 0;
+   curl_easy_getinfo(curl_handle, CURLINFO_RESPONSE_CODE, &http_code);
+#ifdef TEMP_LOGGING
+   TEMP_LOG("curl response = " << res << "http response code = " << http_code);
+#endif
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"curl response : %d http response code: %ld\n", res, http_code);
+   if (curl_handle != threadCurl.curl)
+      curl_easy_cleanup(curl_handle);
+   curl_slist_free_all(headers);
+
+   if (res == CURLE_OK)
+   {
+#ifdef TEMP_LOGGING
+      TEMP_LOG("curl response: " << response);
+#endif
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"Curl response: %s\n", response.c_str());
+   }
+}
+
+/**
+ * @brief Map a cURL result code onto a hostif request outcome.
+ * @param[in] res  Transfer result.
+ */
+RfcHostifResult rfcHostifResultFromCurl(CURLcode res)
+{
+   switch (res)
+   {
+   case CURLE_OK:
+      return RFC_HOSTIF_OK;
+   case CURLE_COULDNT_CONNECT:
+      return RFC_HOSTIF_UNREACHABLE;
+   case CURLE_OPERATION_TIMEDOUT:
+      return RFC_HOSTIF_TIMEOUT;
+   default:
+      return RFC_HOSTIF_ERROR;
+   }
+}
+
+/**
+ * @brief Bound a transfer by what is left of the caller's deadline.
+ * @param[in] curl_handle  Handle from rfcHostifRequestCreate().
+ * @param[in] deadline     Point in time the whole request must finish by.
+ * @retval false  The deadline has already passed.
+ */
+static bool applyDeadline(CURL *curl_handle, chrono::steady_clock::time_point deadline)
+{
+   long remainingMs = (long)chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+   if (remainingMs <= 0)
       return false;
+   // Millisecond timeouts must not rely on SIGALRM.
+   if(curl_easy_setopt(curl_handle, CURLOPT_NOSIGNAL, 1L) != CURLE_OK){
+       RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_NOSIGNAL\n", __FUNCTION__, __LINE__);
+   }
+   if(curl_easy_setopt(curl_handle, CURLOPT_CONNECTTIMEOUT_MS, remainingMs) != CURLE_OK){
+       RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_CONNECTTIMEOUT_MS\n", __FUNCTION__, __LINE__);
+   }
+   if(curl_easy_setopt(curl_handle, CURLOPT_TIMEOUT_MS, remainingMs) != CURLE_OK){
+       RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_TIMEOUT_MS\n", __FUNCTION__, __LINE__);
    }
    return true;
 }
 
-#if !defined(RDKB_SUPPORT) && !defined(RDKC)
 /**
- * @brief Look up a parameter by name in an ini-style file (WDMP path).
- * @param[in]  fileName         Path to the ini file.
- * @param[in]  pcParameterName  Parameter name to search for.
- * @param[out] pstParam         Filled with name/value/type on success.
- * @return WDMP_SUCCESS, WDMP_ERR_VALUE_IS_EMPTY, or WDMP_FAILURE.
- */
-WDMP_STATUS getValue(const char* fileName, const char* pcParameterName, RFC_ParamData_t *pstParam)
+ * @brief Send one JSON request to the hostif HTTP server and wait for the answer.
+ * @param[in]  pcCallerID  Caller identifier, sent as the CallerID header.
+ * @param[in]  data        JSON request body.
+ * @param[in]  isSet       true for a set (POST), false for a get.
+ * @param[out] response    Response body.
+ * @param[in]  deadlineMs  Bound on the whole request, retries included; 0 keeps the default timeouts.
+ * @return Outcome of the request; RFC_HOSTIF_TIMEOUT when @p deadlineMs ran out.
+ */
+static RfcHostifResult sendHostifRequest(const char *pcCallerID, const string &data, bool isSet, string &response, unsigned int deadlineMs = 0)
 {
-    ifstream ifs_rfcVar(fileName);
-    if (!ifs_rfcVar.is_open())
-    {
-        RDK_LOG (RDK_LOG_ERROR, LOG_RFCAPI, "%s: Trying to open a non-existent file %s \n", __FUNCTION__, fileName);
-        if ( strcmp(fileName, RFCDEFAULTS_FILE) == 0 && init_rfcdefaults() )
-        {
-            RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "Trying to open %s after newly creating\n", RFCDEFAULTS_FILE);
-            ifs_rfcVar.open(RFCDEFAULTS_FILE, ifstream::in);
-            if (!ifs_rfcVar.is_open())
-                return WDMP_FAILURE;
-        }
-        else
-            return WDMP_FAILURE;
-    }
-    {
-        string line;
-        while (getline(ifs_rfcVar, line))
-        {
-            line=line.substr(line.find_first_of(" \t")+1);//Remove any export word that maybe before the key(for rfcVariable.ini)
-            size_t splitterPos = line.find('=');
-            if (splitterPos < line.length())
-            {
-                string key = line.substr(0, splitterPos);
-                if ( !key.compare(pcParameterName) )
-                {
-                   ifs_rfcVar.close();
-                   string value = line.substr(splitterPos+1, line.length());
-                   RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "Found Key = %s : Value = %s\n", key.c_str(), value.c_str());
-                   if(value.length() > 0)
-                   {
-                      strncpy(pstParam->name, pcParameterName, MAX_PARAM_LEN);
-                      pstParam->name[MAX_PARAM_LEN - 1] = '\0';
+   chrono::steady_clock::time_point deadline = chrono::steady_clock::now() + chrono::milliseconds(deadlineMs);
+   struct curl_slist *headers = NULL;
+   bool viaSocket = false;
+   CURL *curl_handle = rfcHostifRequestCreate(pcCallerID, data, isSet, &response, &headers, &viaSocket, true);
+   if (curl_handle == NULL)
+      return RFC_HOSTIF_ERROR;
+
+   CURLcode res = CURLE_OPERATION_TIMEDOUT;
+   if (deadlineMs == 0 || applyDeadline(curl_handle, deadline))
+      res = curl_easy_perform(curl_handle);
+   rfcHostifRequestDone(curl_handle, headers, res, response);
+   if (viaSocket && res == CURLE_COULDNT_CONNECT)
+   {
+      // Nothing reached hostif, so the request can be repeated over TCP.
+      rfcTransportSocketFailed();
+      response.clear();
+      curl_handle = rfcHostifRequestCreate(pcCallerID, data, isSet, &response, &headers, &viaSocket, true);
+      if (curl_handle == NULL)
+         return RFC_HOSTIF_ERROR;
+      res = CURLE_OPERATION_TIMEDOUT;
+      if (deadlineMs == 0 || applyDeadline(curl_handle, deadline))
+         res = curl_easy_perform(curl_handle);
+      rfcHostifRequestDone(curl_handle, headers, res, response);
+   }
+   if (res == CURLE_COULDNT_CONNECT)
+      rfcHostifUnreachable();
+   return rfcHostifResultFromCurl(res);
+}
 
-                      pstParam->type = WDMP_NONE; //The caller must know what type they are expecting if they are requesting a param before the hostif is ready.
+/**
+ * @brief Parse a hostif answer with cJSON.
+ * @param[in]  response  Response body.
+ * @param[out] parsed    Receives the members found.
+ * @retval false  @p response is not valid JSON.
+ */
+static bool parseHostifResponse(const string &response, RfcHostifResponse *parsed)
+{
+   cJSON *response_json = cJSON_Parse(response.c_str());
+   if (!response_json)
+      return false;
 
-                      strncpy(pstParam->value, value.c_str(), MAX_PARAM_LEN);
-                      pstParam->value[MAX_PARAM_LEN - 1] = '\0';
-                      return WDMP_SUCCESS;
-                   }
-                   return WDMP_ERR_VALUE_IS_EMPTY;
-                }
+   cJSON* statusCode = cJSON_GetObjectItem(response_json, "statusCode");
+   parsed->hasStatusCode = statusCode != NULL;
+   parsed->statusCode = statusCode ? statusCode->valueint : 0;
+   parsed->parameters.clear();
+   cJSON *items = cJSON_GetObjectItem(response_json, "parameters");
+   int size = cJSON_GetArraySize(items);
+   parsed->parameters.resize(size);
+   for (int i = 0 ; i < size ; i++)
+   {
+      cJSON* subitem = cJSON_GetArrayItem(items, i);
+      RfcHostifEntry &entry = parsed->parameters[i];
+      cJSON* name = cJSON_GetObjectItem(subitem, "name");
+      if ((entry.hasName = name && name->valuestring))
+         entry.name = name->valuestring;
+      cJSON* dataType = cJSON_GetObjectItem(subitem, "dataType");
+      entry.hasType = dataType != NULL;
+      entry.dataType = dataType ? dataType->valueint : 0;
+      cJSON* value = cJSON_GetObjectItem(subitem, "value");
+      if ((entry.hasValue = value && value->valuestring))
+         entry.value = value->valuestring;
+      cJSON* message = cJSON_GetObjectItem(subitem, "message");
+      if ((entry.hasMessage = message && message->valuestring))
+         entry.message = message->valuestring;
+   }
+   cJSON_Delete(response_json);
+   return true;
+}
+#else
+/**
+ * @brief Send one JSON request to the hostif HTTP server and wait for the answer.
+ * @param[in]  pcCallerID  Caller identifier, sent as the CallerID header.
+ * @param[in]  data        JSON request body.
+ * @param[in]  isSet       true for a set (POST), false for a get.
+ * @param[out] response    Response body.
+ * @param[in]  deadlineMs  Bound on the whole request, retries included; 0 keeps the default timeouts.
+ * @return Outcome of the request; RFC_HOSTIF_TIMEOUT when @p deadlineMs ran out.
+ */
+static RfcHostifResult sendHostifRequest(const char *pcCallerID, const string &data, bool isSet, string &response, unsigned int deadlineMs = 0)
+{
+   RfcHostifResult res = rfcHttpRequest(pcCallerID, data, isSet, &response, deadlineMs);
+   if (res == RFC_HOSTIF_OK)
+   {
+#ifdef TEMP_LOGGING
+      TEMP_LOG("hostif response: " << response);
+#endif
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"hostif response: %s\n", response.c_str());
+   }
+   else if (res == RFC_HOSTIF_UNREACHABLE)
+      rfcHostifUnreachable();
+   return res;
+}
+
+/** @brief Parse a hostif answer with the built-in parser. */
+static bool parseHostifResponse(const string &response, RfcHostifResponse *parsed)
+{
+   return rfcHostifParseJson(response.data(), response.size(), parsed);
+}
+#endif
+
+/**
+ * @brief Copy one entry of a hostif "parameters" array into separate outputs.
+ * @param[in]  entry     Entry with name/dataType/value/message members.
+ * @param[out] pcName    Receives the name (MAX_PARAM_LEN bytes), or NULL to skip it.
+ * @param[out] pcValue   Receives the value, NUL-terminated and truncated to @p capacity.
+ * @param[in]  capacity  Size of @p pcValue.
+ * @param[out] pLength   Full value length, excluding the NUL.
+ * @param[out] peType    Receives the data type.
+ * @return The name hostif answered with (owned by @p entry), or NULL.
+ * Outputs whose member is absent are left untouched.
+ */
+static const char *readHostifEntry(const RfcHostifEntry &entry, char *pcName, char *pcValue, size_t capacity, size_t *pLength, DATA_TYPE *peType)
+{
+   const char *answeredName = NULL;
+   if (entry.hasName)
+   {
+      answeredName = entry.name.c_str();
+      if (pcName != NULL)
+      {
+         strncpy(pcName, answeredName, MAX_PARAM_LEN);
+         pcName[MAX_PARAM_LEN - 1] = '\0';
+      }
+#ifdef TEMP_LOGGING
+      TEMP_LOG("name = " << answeredName);
+#endif
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"name = %s\n", answeredName);
+   }
+
+   if (entry.hasType)
+   {
+      *peType = (DATA_TYPE)entry.dataType;
+#ifdef TEMP_LOGGING
+      TEMP_LOG("dataType = " << *peType);
+#endif
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"type = %d\n", *peType);
+   }
+   if (entry.hasValue)
+   {
+      // Up to the first NUL, as with a C string from the JSON parser.
+      *pLength = rfcCopyValue(pcValue, capacity, entry.value.c_str(), strlen(entry.value.c_str()));
+#ifdef TEMP_LOGGING
+      TEMP_LOG("value = " << entry.value.c_str());
+#endif
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"value = %s\n", entry.value.c_str());
+   }
+   if (entry.hasMessage)
+   {
+#ifdef TEMP_LOGGING
+      TEMP_LOG("message = " << entry.message.c_str());
+#endif
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"message = %s\n", entry.message.c_str());
+   }
+   return answeredName;
+}
+
+/**
+ * @brief Copy one entry of a hostif "parameters" array into @p pstParam.
+ * @param[in]  entry     Entry with name/dataType/value/message members.
+ * @param[out] pstParam  Receives whichever members are present.
+ */
+static void readHostifParam(const RfcHostifEntry &entry, RFC_ParamData_t *pstParam)
+{
+   size_t length;
+   readHostifEntry(entry, pstParam->name, pstParam->value, MAX_PARAM_LEN, &length, &pstParam->type);
+}
+
+/**
+ * @brief Map a per-parameter hostif "message" back to its WDMP status.
+ *
+ * hostif reports per-parameter results as the getRFCErrorString() text.
+ * @param[in] entry     Entry of the "parameters" array.
+ * @param[in] fallback  Status to use when the entry carries no message.
+ * @return WDMP_STATUS for this parameter.
+ */
+static WDMP_STATUS readHostifParamStatus(const RfcHostifEntry &entry, WDMP_STATUS fallback)
+{
+   const char *message = entry.message.c_str();
+   if (!entry.hasMessage || !*message)
+      return fallback;
+
+   for (int code = WDMP_SUCCESS; code < WDMP_ERR_MAX_REQUEST; code++)
+   {
+      // Error strings carry a leading blank.
+      if (strcasecmp(getRFCErrorString((WDMP_STATUS)code) + 1, message) == 0)
+         return (WDMP_STATUS)code;
+   }
+   return (fallback == WDMP_SUCCESS) ? WDMP_FAILURE : fallback;
+}
+
+/**
+ * @brief Length of @p str once escaped as a JSON string body (without quotes).
+ */
+static size_t jsonEscapedLength(const char *str)
+{
+   size_t len = 0;
+   for (const unsigned char *p = (const unsigned char *)str; *p; p++)
+   {
+      if (*p == '"' || *p == '\\' || *p == '\b' || *p == '\f' || *p == '\n' || *p == '\r' || *p == '\t')
+         len += 2;
+      else if (*p < 0x20)
+         len += 6;
+      else
+         len++;
+   }
+   return len;
+}
+
+/**
+ * @brief Append @p str to @p out as a quoted, escaped JSON string.
+ */
+static void appendJsonString(string &out, const char *str)
+{
+   static const char hex[] = "0123456789abcdef";
+   out += '"';
+   for (const unsigned char *p = (const unsigned char *)str; *p; p++)
+   {
+      switch (*p)
+      {
+         case '"':  out += "\\\""; break;
+         case '\\': out += "\\\\"; break;
+         case '\b': out += "\\b"; break;
+         case '\f': out += "\\f"; break;
+         case '\n': out += "\\n"; break;
+         case '\r': out += "\\r"; break;
+         case '\t': out += "\\t"; break;
+         default:
+            if (*p < 0x20)
+            {
+               out += "\\u00";
+               out += hex[*p >> 4];
+               out += hex[*p & 0xf];
             }
-        }
-        ifs_rfcVar.close();
-    }
-    return WDMP_FAILURE;
+            else
+               out += (char)*p;
+      }
+   }
+   out += '"';
 }
+
+/**
+ * @brief Answer a get without contacting hostif, where possible.
+ *
+ * Rejects wildcard names, resolves from the local store files before hostif
+ * is ready, and serves cache hits.
+ * @param[in]  pcParameterName  TR181 parameter name.
+ * @param[out] pcName           Parameter name (MAX_PARAM_LEN bytes), or NULL.
+ * @param[out] pcValue          Value, NUL-terminated and truncated to @p capacity.
+ * @param[in]  capacity         Size of @p pcValue.
+ * @param[out] pLength          Full value length, excluding the NUL.
+ * @param[out] peType           Data type (WDMP_NONE before hostif is ready).
+ * @param[out] pStatus          Result when answered.
+ * @retval true   Answered; @p pStatus is valid.
+ * @retval false  A hostif request is needed.
+ */
+bool rfcReadParameterLocal(const char *pcParameterName, char *pcName, char *pcValue, size_t capacity,
+                           size_t *pLength, DATA_TYPE *peType, WDMP_STATUS *pStatus)
+{
+   if(!strcmp(pcParameterName+strlen(pcParameterName)-1,"."))
+   {
+#ifdef TEMP_LOGGING
+       TEMP_LOG(__FUNCTION__ << ": RFC API doesn't support wildcard parameterName ");
 #endif
+       RDK_LOG (RDK_LOG_DEBUG, LOG_RFCAPI, "%s: RFC API doesn't support wildcard parameterName\n", __FUNCTION__);
+       *pStatus = WDMP_FAILURE;
+       return true;
+   }
 
-/** @brief cURL write callback — appends received data to a std::string. */
-static size_t writeCurlResponse(void *ptr, size_t size, size_t nmemb, string stream)
+   if(!rfcHostifReady())
+   {
+      // A set still queued for hostif is newer than anything in the store files.
+      DATA_TYPE queuedType = WDMP_NONE;
+      if (rfcWriteBehindLookupValue(pcParameterName, pcValue, capacity, pLength, &queuedType))
+         *pStatus = WDMP_SUCCESS;
+      else
+         *pStatus = rfcStoreLookupValue(pcParameterName, pcValue, capacity, pLength);
+      if (*pStatus == WDMP_SUCCESS)
+      {
+         if (pcName != NULL)
+         {
+            strncpy(pcName, pcParameterName, MAX_PARAM_LEN);
+            pcName[MAX_PARAM_LEN - 1] = '\0';
+         }
+         *peType = queuedType; //Otherwise the caller must know what type they are expecting if they are requesting a param before the hostif is ready.
+      }
+      return true;
+   }
+
+   if (rfcSnapshotLookupValue(pcParameterName, pcValue, capacity, pLength, peType))
+   {
+      if (pcName != NULL)
+      {
+         strncpy(pcName, pcParameterName, MAX_PARAM_LEN);
+         pcName[MAX_PARAM_LEN - 1] = '\0';
+      }
+      *pStatus = WDMP_SUCCESS;
+      return true;
+   }
+
+   if (rfcCacheLookupValue(pcParameterName, pcValue, capacity, pLength, peType, pStatus))
+   {
+      if (pcName != NULL)
+      {
+         strncpy(pcName, pcParameterName, MAX_PARAM_LEN);
+         pcName[MAX_PARAM_LEN - 1] = '\0';
+      }
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: %s served from cache\n", __FUNCTION__, pcParameterName);
+      return true;
+   }
+   return false;
+}
+
+/**
+ * @brief JSON body of a single-parameter hostif get.
+ * @param[in] pcParameterName  TR181 parameter name.
+ */
+string rfcHostifGetBody(const char *pcParameterName)
 {
-   size_t realsize = size * nmemb;
-   string temp(static_cast<const char*>(ptr), realsize);
-   stream.append(temp);
-   return realsize;
+   string data = "{\"names\" : [";
+   appendJsonString(data, pcParameterName);
+   data.append("]}");
+#ifdef TEMP_LOGGING
+   TEMP_LOG("getRFCParam data = " << data << " dataLen = " << data.length());
+#endif
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"getRFCParam data = %s, datalen = %zu\n", data.c_str(), data.length());
+   return data;
+}
+
+/**
+ * @brief Parse the hostif answer to a single-parameter get and cache it.
+ * @param[in]  response         Response body.
+ * @param[in]  pcParameterName  Name that was requested.
+ * @param[out] pcName           Name hostif answered with (MAX_PARAM_LEN bytes), or NULL.
+ * @param[out] pcValue          Value, NUL-terminated and truncated to @p capacity.
+ * @param[in]  capacity         Size of @p pcValue.
+ * @param[out] pLength          Full value length, excluding the NUL.
+ * @param[out] peType           Data type.
+ * @param[in]  generation       Store generation sampled before the request was sent.
+ * @return statusCode of the response, or WDMP_FAILURE if it could not be parsed.
+ */
+WDMP_STATUS rfcHostifParseGet(const string &response, const char *pcParameterName, char *pcName, char *pcValue,
+                              size_t capacity, size_t *pLength, DATA_TYPE *peType, unsigned long generation)
+{
+   WDMP_STATUS ret = WDMP_FAILURE;
+   RfcHostifResponse parsed;
+
+   if (parseHostifResponse(response, &parsed))
+   {
+      const char *answeredName = NULL;
+
+      for (size_t i = 0 ; i < parsed.parameters.size() ; i++)
+      {
+         answeredName = readHostifEntry(parsed.parameters[i], pcName, pcValue, capacity, pLength, peType);
+      }
+      if(parsed.hasStatusCode)
+      {
+         ret = (WDMP_STATUS)parsed.statusCode;
+#ifdef TEMP_LOGGING
+         TEMP_LOG("statusCode = " << ret);
+#endif
+         RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"statusCode = %d\n", ret);
+      }
+      // hostif may answer with a different name (e.g. an alias); only cache exact, untruncated matches.
+      if (answeredName != NULL && strcmp(answeredName, pcParameterName) == 0 && *pLength < capacity)
+         rfcCacheStoreValue(pcParameterName, pcValue, *peType, ret, generation);
+   }
+   return ret;
 }
 
-#if !defined(RDKB_SUPPORT) && !defined(RDKC)
 /**
- * @brief Retrieve an RFC parameter via hostif HTTP (STB path).
+ * @brief Shared body of getRFCParameter(), getRFCParameterValue() and getRFCParameterWithDeadline().
  * @param[in]  pcCallerID       Caller identifier.
  * @param[in]  pcParameterName  TR181 parameter name.
- * @param[out] pstParam         Filled with name/value/type.
- * @return WDMP_STATUS code.
+ * @param[out] pcName           Name hostif answered with (MAX_PARAM_LEN bytes), or NULL.
+ * @param[out] pcValue          Value, NUL-terminated and truncated to @p capacity.
+ * @param[in]  capacity         Size of @p pcValue.
+ * @param[out] pLength          Full value length, excluding the NUL.
+ * @param[out] peType           Data type (WDMP_NONE before hostif is ready).
+ * @param[in]  deadlineMs       Bound on the hostif request; 0 keeps the default timeouts.
+ * @param[out] pStale           With a deadline: set to true when the value came from the store
+ *                              files because hostif missed it; may be NULL.
+ * @return WDMP_STATUS code; WDMP_ERR_TIMEOUT when the deadline was missed.
  */
-WDMP_STATUS getRFCParameter(const char *pcCallerID, const char* pcParameterName, RFC_ParamData_t *pstParam)
+static WDMP_STATUS readParameter(const char *pcCallerID, const char *pcParameterName, char *pcName,
+                                 char *pcValue, size_t capacity, size_t *pLength, DATA_TYPE *peType,
+                                 unsigned int deadlineMs = 0, bool *pStale = NULL)
 {
 #ifdef TEMP_LOGGING
    openLogFile();
 #endif
    WDMP_STATUS ret = WDMP_FAILURE;
-   long http_code = 0;
-   string response;
-   CURL *curl_handle = NULL;
-   CURLcode res = CURLE_FAILED_INIT;
+   if (rfcReadParameterLocal(pcParameterName, pcName, pcValue, capacity, pLength, peType, &ret))
+      return ret;
 
-   if(!strcmp(pcParameterName+strlen(pcParameterName)-1,"."))
+   // Sampled before the request so a store update racing with it is not cached.
+   unsigned long generation = rfcStoreGeneration();
+   string data = rfcHostifGetBody(pcParameterName);
+   string response;
+   RfcHostifResult res = sendHostifRequest(pcCallerID, data, false, response, deadlineMs);
+   if (res == RFC_HOSTIF_OK)
+      ret = rfcHostifParseGet(response, pcParameterName, pcName, pcValue, capacity, pLength, peType, generation);
+   else if (res == RFC_HOSTIF_UNREACHABLE)
    {
-#ifdef TEMP_LOGGING
-       logofs << prefix() << __FUNCTION__ << ": RFC API doesn't support wildcard parameterName " << endl;
-#endif
-       RDK_LOG (RDK_LOG_DEBUG, LOG_RFCAPI, "%s: RFC API doesn't support wildcard parameterName\n", __FUNCTION__);
-       return ret;
+      // hostif went away (e.g. restarting); rfcHostifReady() now reports false, so this reads the store files.
+      rfcReadParameterLocal(pcParameterName, pcName, pcValue, capacity, pLength, peType, &ret);
    }
-
-   if(!tr69hostif_http_server_ready)
+   else if (res == RFC_HOSTIF_TIMEOUT && deadlineMs != 0)
    {
-      ifstream ifs_rfc("/tmp/.tr69hostif_http_server_ready");
-      if(!ifs_rfc.is_open())
+      // hostif is alive but slow: hand back the last persisted value, marked stale.
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: %s missed its %u ms deadline, using local store\n", __FUNCTION__, pcParameterName, deadlineMs);
+      ret = WDMP_ERR_TIMEOUT;
+      if (rfcStoreLookupValue(pcParameterName, pcValue, capacity, pLength) == WDMP_SUCCESS)
       {
-#ifdef TEMP_LOGGING
-         logofs << prefix() << __FUNCTION__ << ": file /tmp/.tr69hostif_http_server_ready doesn't exist, http server isn't ready yet" << endl;
-#endif
-         RDK_LOG (RDK_LOG_ERROR, LOG_RFCAPI, "%s: file /tmp/.tr69hostif_http_server_ready doesn't exist, http server isn't ready yet\n", __FUNCTION__);
-
-         if(strncmp(pcParameterName, "RFC_", 4) == 0 && strchr(pcParameterName, '.') == NULL)
+         if (pcName != NULL)
          {
-            return getValue(RFCVAR_FILE, pcParameterName, pstParam);
+            strncpy(pcName, pcParameterName, MAX_PARAM_LEN);
+            pcName[MAX_PARAM_LEN - 1] = '\0';
          }
-         else
-         {
-            ret = getValue(TR181STORE_FILE, pcParameterName, pstParam);
-            if (WDMP_SUCCESS == ret)
-               return WDMP_SUCCESS;
+         *peType = WDMP_NONE;
+         if (pStale != NULL)
+            *pStale = true;
+      }
+   }
+   return ret;
+}
+
+/**
+ * @brief Retrieve an RFC parameter via hostif HTTP (STB path).
+ * @param[in]  pcCallerID       Caller identifier.
+ * @param[in]  pcParameterName  TR181 parameter name.
+ * @param[out] pstParam         Filled with name/value/type.
+ * @return WDMP_STATUS code.
+ */
+WDMP_STATUS getRFCParameter(const char *pcCallerID, const char* pcParameterName, RFC_ParamData_t *pstParam)
+{
+   RfcStatsScope stats(pcCallerID, RFC_STATS_GET);
+   size_t length = 0;
+   return stats.done(readParameter(pcCallerID, pcParameterName, pstParam->name, pstParam->value, MAX_PARAM_LEN, &length, &pstParam->type));
+}
 
-            // If the param is not found in tr181store.ini, also search in bootstrap.ini. When the hostif is not ready we do not know whether the requested param is regular tr181 param or bootstrap param.
-            ret = getValue(BOOTSTRAP_FILE, pcParameterName, pstParam);
-            if (WDMP_SUCCESS == ret)
-               return WDMP_SUCCESS;
+/**
+ * @brief Retrieve an RFC parameter, giving up on hostif after @p deadlineMs.
+ * @param[in]  pcCallerID       Caller identifier.
+ * @param[in]  pcParameterName  TR181 parameter name.
+ * @param[out] pstParam         Filled with name/value/type.
+ * @param[in]  deadlineMs       Bound on the hostif request; 0 behaves like getRFCParameter().
+ * @param[out] pbStale          Set to true when @p pstParam holds the store-file value
+ *                              after a missed deadline, otherwise false; may be NULL.
+ * @return WDMP_STATUS code; WDMP_ERR_TIMEOUT when the deadline was missed.
+ */
+WDMP_STATUS getRFCParameterWithDeadline(const char *pcCallerID, const char *pcParameterName, RFC_ParamData_t *pstParam,
+                                        unsigned int deadlineMs, bool *pbStale)
+{
+   if (pbStale != NULL)
+      *pbStale = false;
+   if (pcParameterName == NULL || pstParam == NULL)
+      return WDMP_ERR_INVALID_PARAM;
+   RfcStatsScope stats(pcCallerID, RFC_STATS_GET);
+   size_t length = 0;
+   return stats.done(readParameter(pcCallerID, pcParameterName, pstParam->name, pstParam->value, MAX_PARAM_LEN, &length, &pstParam->type,
+                                   deadlineMs, pbStale));
+}
 
-            // If the param is not found in override files, find it in rfcdefaults.
-            return getValue(RFCDEFAULTS_FILE, pcParameterName, pstParam);
+/**
+ * @brief Retrieve an RFC parameter value into a caller-provided buffer.
+ * @param[in]     pcCallerID       Caller identifier.
+ * @param[in]     pcParameterName  TR181 parameter name.
+ * @param[out]    pcValue          Receives the NUL-terminated value.
+ * @param[in,out] pValueLen        In: size of @p pcValue. Out: value length, excluding the NUL.
+ * @param[out]    peType           Receives the data type; may be NULL.
+ * @return WDMP_STATUS code, or WDMP_STATUS_RESOURCES if @p pcValue was too small.
+ */
+WDMP_STATUS getRFCParameterValue(const char *pcCallerID, const char *pcParameterName, char *pcValue, size_t *pValueLen, DATA_TYPE *peType)
+{
+   if (pcParameterName == NULL || pcValue == NULL || pValueLen == NULL || *pValueLen == 0)
+      return WDMP_ERR_INVALID_PARAM;
 
-         }
-      }
-      else
-      {
-         ifs_rfc.close();
-#ifdef TEMP_LOGGING
-         logofs << prefix() << __FUNCTION__ << ": http server is ready" << endl;
-#endif
-         RDK_LOG (RDK_LOG_INFO, LOG_RFCAPI, "%s: http server is ready\n", __FUNCTION__);
-         tr69hostif_http_server_ready = true;
-      }
+   RfcStatsScope stats(pcCallerID, RFC_STATS_GET);
+   size_t capacity = *pValueLen;
+   size_t length = 0;
+   DATA_TYPE type = WDMP_NONE;
+   pcValue[0] = '\0';
+   WDMP_STATUS ret = stats.done(readParameter(pcCallerID, pcParameterName, NULL, pcValue, capacity, &length, &type));
+   *pValueLen = length;
+   if (peType != NULL)
+      *peType = type;
+   if ((ret == WDMP_SUCCESS || ret == WDMP_ERR_DEFAULT_VALUE) && length >= capacity)
+   {
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: %s needs %zu bytes, caller gave %zu\n", __FUNCTION__, pcParameterName, length + 1, capacity);
+      return WDMP_STATUS_RESOURCES;
    }
-  
-   curl_handle = curl_easy_init();
-   string data = "{\"names\" : [\"";
-   data.append(pcParameterName);
-   data.append("\"]}");
-#ifdef TEMP_LOGGING
-   logofs << prefix() << "getRFCParam data = " << data << " dataLen = " << data.length() << endl;
-#endif
-   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"getRFCParam data = %s, datalen = %zu\n", data.c_str(), data.length());
-   if (curl_handle) 
-   {
-       char pcCallerIDHeader[128];
-       if(pcCallerID)
-           snprintf(pcCallerIDHeader, sizeof(pcCallerIDHeader), "CallerID: %s", pcCallerID);
-       else
-           sprintf(pcCallerIDHeader, "CallerID: Unknown");
-       struct curl_slist *customHeadersList = NULL;
-       customHeadersList = curl_slist_append(customHeadersList, pcCallerIDHeader);
-       if(curl_easy_setopt(curl_handle, CURLOPT_HTTPHEADER, customHeadersList) != CURLE_OK){
-           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_HTTPHEADER\n", __FUNCTION__, __LINE__);            
-       }	       
-
-       if(curl_easy_setopt(curl_handle, CURLOPT_URL, url) != CURLE_OK){
-           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_URL\n", __FUNCTION__, __LINE__);
-       } 	       
-       if(curl_easy_setopt(curl_handle, CURLOPT_CUSTOMREQUEST, "GET") != CURLE_OK){
-           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_CUSTOMREQUEST\n", __FUNCTION__, __LINE__); 
-       }	       
-       if(curl_easy_setopt(curl_handle, CURLOPT_POSTFIELDSIZE, (long) data.length()) != CURLE_OK){
-           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_POSTFIELDSIZE\n", __FUNCTION__, __LINE__); 
-       }
-       if(curl_easy_setopt(curl_handle, CURLOPT_POSTFIELDS, data.c_str()) != CURLE_OK){
-           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_POSTFIELDS\n", __FUNCTION__, __LINE__); 
-       }
-       if(curl_easy_setopt(curl_handle, CURLOPT_FOLLOWLOCATION, 1) != CURLE_OK){
-           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_FOLLOWLOCATION\n", __FUNCTION__, __LINE__);  
-       }
-       if(curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, writeCurlResponse) != CURLE_OK){
-           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_WRITEFUNCTION\n", __FUNCTION__, __LINE__); 
-       }		       
-       if(curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, &response) != CURLE_OK){
-           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_WRITEDATA\n", __FUNCTION__, __LINE__);
-       }       
-       if(curl_easy_setopt(curl_handle, CURLOPT_CONNECTTIMEOUT, CONNECTION_TIMEOUT) != CURLE_OK){
-           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_CONNECTTIMEOUT\n", __FUNCTION__, __LINE__);
-       }
-       if(curl_easy_setopt(curl_handle, CURLOPT_TIMEOUT, TRANSFER_TIMEOUT) != CURLE_OK){
-           RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_TIMEOUT\n", __FUNCTION__, __LINE__);   
-       }	       
+   return ret;
+}
 
-       res = curl_easy_perform(curl_handle);
-       curl_easy_getinfo(curl_handle, CURLINFO_RESPONSE_CODE, &http_code);
+/**
+ * @brief Retrieve several RFC parameters with a single hostif request.
+ * @param[in]  pcCallerID          Caller identifier.
+ * @param[in]  ppcParameterNames   Array of @p count TR181 parameter names.
+ * @param[in]  count               Number of names.
+ * @param[out] pstParams           Array of @p count results, in request order.
+ * @param[out] peStatus            Array of @p count per-parameter status codes.
+ * @return WDMP_SUCCESS if every parameter resolved, otherwise the first failing status.
+ */
+WDMP_STATUS getRFCParameters(const char *pcCallerID, const char **ppcParameterNames, size_t count, RFC_ParamData_t *pstParams, WDMP_STATUS *peStatus)
+{
 #ifdef TEMP_LOGGING
-       logofs  << prefix() << "curl response = " << res << "http response code = " << http_code << endl;
+   openLogFile();
 #endif
-       RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"curl response : %d http response code: %ld\n", res, http_code);
-       curl_easy_cleanup(curl_handle);
-
-       curl_slist_free_all(customHeadersList);
-   }
-   else
+   RfcStatsScope stats(pcCallerID, RFC_STATS_GET_MULTI);
+   if (ppcParameterNames == NULL || pstParams == NULL || peStatus == NULL || count == 0)
    {
-#ifdef TEMP_LOGGING
-      logofs << prefix() << "Could not perform curl" << endl;
-#endif
-      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"Could not perform curl \n");
+      RDK_LOG (RDK_LOG_ERROR, LOG_RFCAPI, "%s: invalid arguments\n", __FUNCTION__);
+      return stats.done(WDMP_FAILURE);
    }
-   if (res == CURLE_OK)
+
+   vector<size_t> pending;
+   size_t dataLen = 16;
+   for (size_t i = 0; i < count; i++)
    {
-      cJSON *response_json = NULL;
-#ifdef TEMP_LOGGING
-      logofs << prefix() << "curl response: " << response << endl;
-#endif
-      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"Curl response: %s\n", response.c_str());
-      response_json = cJSON_Parse(response.c_str());
+      const char *name = ppcParameterNames[i];
+      peStatus[i] = WDMP_FAILURE;
+      if (name == NULL || *name == '\0' || name[strlen(name) - 1] == '.')
+      {
+         RDK_LOG (RDK_LOG_DEBUG, LOG_RFCAPI, "%s: skipping empty or wildcard parameterName at index %zu\n", __FUNCTION__, i);
+         continue;
+      }
+      // Resolved like getRFCParameter(): queued sets and store files before hostif is ready, snapshot and cache after.
+      size_t length;
+      if (rfcReadParameterLocal(name, pstParams[i].name, pstParams[i].value, MAX_PARAM_LEN, &length, &pstParams[i].type, &peStatus[i]))
+         continue;
+      pending.push_back(i);
+      dataLen += jsonEscapedLength(name) + 3;
+   }
 
-      if (response_json)
+   if (!pending.empty())
+   {
+      // Sampled before the request so a store update racing with it is not cached.
+      unsigned long generation = rfcStoreGeneration();
+      string response;
+      string data;
+      data.reserve(dataLen);
+      data.append("{\"names\" : [");
+      for (size_t j = 0; j < pending.size(); j++)
       {
-         cJSON *items = cJSON_GetObjectItem(response_json, "parameters");
+         if (j)
+            data.append(",");
+         appendJsonString(data, ppcParameterNames[pending[j]]);
+      }
+      data.append("]}");
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"getRFCParams count = %zu, datalen = %zu\n", pending.size(), data.length());
 
-         for (int i = 0 ; i < cJSON_GetArraySize(items) ; i++)
+      RfcHostifResult res = sendHostifRequest(pcCallerID, data, false, response);
+      if (res == RFC_HOSTIF_UNREACHABLE)
+      {
+         // hostif went away (e.g. restarting); rfcHostifReady() now reports false, so this reads the store files.
+         for (size_t j = 0; j < pending.size(); j++)
+         {
+            RFC_ParamData_t &param = pstParams[pending[j]];
+            size_t length;
+            rfcReadParameterLocal(ppcParameterNames[pending[j]], param.name, param.value, MAX_PARAM_LEN, &length, &param.type, &peStatus[pending[j]]);
+         }
+      }
+      else if (res == RFC_HOSTIF_OK)
+      {
+         RfcHostifResponse parsed;
+         if (parseHostifResponse(response, &parsed))
          {
-            cJSON* subitem  = cJSON_GetArrayItem(items, i);
-            cJSON* name    = cJSON_GetObjectItem(subitem, "name");
-            if(name)
+            WDMP_STATUS overall = WDMP_FAILURE;
+            if (parsed.hasStatusCode)
             {
-               strncpy(pstParam->name, name->valuestring, MAX_PARAM_LEN);
-               pstParam->name[MAX_PARAM_LEN - 1] = '\0';
-#ifdef TEMP_LOGGING
-               logofs << prefix() << "name = " << pstParam->name << endl;
-#endif
-               RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"name = %s\n", pstParam->name);
+               overall = (WDMP_STATUS)parsed.statusCode;
+               RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"statusCode = %d\n", overall);
             }
 
-            cJSON* dataType = cJSON_GetObjectItem(subitem, "dataType");
-            if (dataType)
-            {
-               pstParam->type = (DATA_TYPE)dataType->valueint;
-#ifdef TEMP_LOGGING
-               logofs << prefix() << "dataType = " << pstParam->type << endl;
-#endif
-               RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"type = %d\n", pstParam->type);
-            }
-            cJSON* value = cJSON_GetObjectItem(subitem, "value");
-            if (value)
+            // hostif answers in request order, but match by name so a short or reordered reply cannot shift values.
+            vector<bool> answered(pending.size(), false);
+            for (size_t k = 0 ; k < parsed.parameters.size() ; k++)
             {
-               strncpy(pstParam->value, value->valuestring, MAX_PARAM_LEN);
-               pstParam->value[MAX_PARAM_LEN - 1] = '\0';
-#ifdef TEMP_LOGGING
-               logofs << prefix() << "value = " << pstParam->value << endl;
-#endif
-               RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"value = %s\n", pstParam->value);
+               const RfcHostifEntry &entry = parsed.parameters[k];
+               if (!entry.hasName)
+                  continue;
+               for (size_t j = 0; j < pending.size(); j++)
+               {
+                  if (answered[j] || strcmp(ppcParameterNames[pending[j]], entry.name.c_str()) != 0)
+                     continue;
+                  size_t idx = pending[j];
+                  answered[j] = true;
+                  readHostifParam(entry, &pstParams[idx]);
+                  peStatus[idx] = readHostifParamStatus(entry, overall);
+                  rfcCacheStore(ppcParameterNames[idx], &pstParams[idx], peStatus[idx], generation);
+                  break;
+               }
             }
-            cJSON* message = cJSON_GetObjectItem(subitem, "message");
-            if (message)
+            for (size_t j = 0; j < pending.size(); j++)
             {
-#ifdef TEMP_LOGGING
-               logofs << prefix() << "message = " << message->valuestring << endl;
-#endif
-               RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"message = %s\n", message->valuestring);
+               if (!answered[j])
+               {
+                  peStatus[pending[j]] = (overall == WDMP_SUCCESS) ? WDMP_FAILURE : overall;
+                  RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"%s: no value returned for %s\n", __FUNCTION__, ppcParameterNames[pending[j]]);
+               }
             }
          }
-         cJSON* statusCode = cJSON_GetObjectItem(response_json, "statusCode");
-         if(statusCode)
-         {
-            ret = (WDMP_STATUS)statusCode->valueint;
-#ifdef TEMP_LOGGING
-            logofs << prefix() << "statusCode = " << ret << endl;
-#endif
-            RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"statusCode = %d\n", ret);
-         }
-         cJSON_Delete(response_json);
       }
    }
-   return ret;
+
+   for (size_t i = 0; i < count; i++)
+   {
+      if (peStatus[i] != WDMP_SUCCESS && peStatus[i] != WDMP_ERR_DEFAULT_VALUE)
+         return stats.done(peStatus[i]);
+   }
+   return stats.done(WDMP_SUCCESS);
 }
 
 /**
- * @brief Set an RFC parameter via hostif HTTP.
- * @param[in] pcCallerID        Caller identifier.
- * @param[in] pcParameterName   TR181 parameter name.
- * @param[in] pcParameterValue  New value to set.
- * @param[in] eDataType         WDMP data type.
- * @return WDMP_STATUS code.
+ * @brief Retrieve every RFC parameter under a TR181 subtree.
+ * @param[in] pcCallerID  Caller identifier.
+ * @param[in] pcPrefix    Subtree name ending in '.'.
+ * @param[in] callback    Invoked once per parameter found.
+ * @param[in] pUserData   Passed through to @p callback.
+ * @return WDMP_SUCCESS if at least one parameter was reported, otherwise a failure code.
  */
-WDMP_STATUS setRFCParameter(const char *pcCallerID, const char* pcParameterName, const char* pcParameterValue, DATA_TYPE eDataType)
+WDMP_STATUS getRFCParameterTree(const char *pcCallerID, const char *pcPrefix, RFC_ParamCallback_t callback, void *pUserData)
 {
-#ifdef TEMP_LOGGING 
+#ifdef TEMP_LOGGING
    openLogFile();
 #endif
+   RfcStatsScope stats(pcCallerID, RFC_STATS_GET_TREE);
+   if (pcPrefix == NULL || callback == NULL || *pcPrefix == '\0' || pcPrefix[strlen(pcPrefix) - 1] != '.')
+   {
+      RDK_LOG (RDK_LOG_ERROR, LOG_RFCAPI, "%s: prefix must be a non-empty subtree name ending in '.'\n", __FUNCTION__);
+      return stats.done(WDMP_FAILURE);
+   }
+
+   if (!rfcHostifReady())
+   {
+      size_t found = rfcStoreForEach(pcPrefix, callback, pUserData);
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: %zu parameters under %s from local store\n", __FUNCTION__, found, pcPrefix);
+      return stats.done(found ? WDMP_SUCCESS : WDMP_FAILURE);
+   }
+
    WDMP_STATUS ret = WDMP_FAILURE;
-   long http_code = 0;
+   size_t found = 0;
    string response;
-   CURL *curl_handle = NULL;
-   CURLcode res = CURLE_FAILED_INIT;
+   string data = "{\"names\" : [";
+   appendJsonString(data, pcPrefix);
+   data.append("]}");
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"getRFCParamTree data = %s, datalen = %zu\n", data.c_str(), data.length());
 
-   if(!strcmp(pcParameterName+strlen(pcParameterName)-1,".") && pcParameterValue == NULL)
+   RfcHostifResult res = sendHostifRequest(pcCallerID, data, false, response);
+   if (res == RFC_HOSTIF_UNREACHABLE)
    {
-#ifdef TEMP_LOGGING
-   logofs << prefix() <<__FUNCTION__ << ": RFC API doesn't support wildcard parameterName or NULL parameterValue" << endl;
-#endif
-       RDK_LOG (RDK_LOG_DEBUG, LOG_RFCAPI, "%s: RFC API doesn't support wildcard parameterName or NULL parameterValue\n", __FUNCTION__);
-       return ret;
+      // hostif went away (e.g. restarting): answer from the store files.
+      found = rfcStoreForEach(pcPrefix, callback, pUserData);
+      return stats.done(found ? WDMP_SUCCESS : WDMP_FAILURE);
+   }
+   if (res == RFC_HOSTIF_OK)
+   {
+      RfcHostifResponse parsed;
+      if (parseHostifResponse(response, &parsed))
+      {
+         if (parsed.hasStatusCode)
+         {
+            ret = (WDMP_STATUS)parsed.statusCode;
+            RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"statusCode = %d\n", ret);
+         }
+
+         size_t prefixLen = strlen(pcPrefix);
+         RFC_ParamData_t param;
+         for (size_t i = 0 ; i < parsed.parameters.size() ; i++)
+         {
+            param.name[0] = '\0';
+            param.value[0] = '\0';
+            param.type = WDMP_NONE;
+            readHostifParam(parsed.parameters[i], &param);
+            if (strncmp(param.name, pcPrefix, prefixLen) != 0)
+               continue;
+            callback(&param, pUserData);
+            found++;
+         }
+      }
    }
+   if (ret == WDMP_SUCCESS && found == 0)
+      ret = WDMP_FAILURE;
+   return stats.done(ret);
+}
+
+/**
+ * @brief Look up a default value in the compiled rfcdefaults snapshot.
+ * @param[in]  pcComponent      Defaults file name without ".ini", or NULL for the winning value.
+ * @param[in]  pcParameterName  Parameter name.
+ * @param[out] pstParam         Filled with name/value on success.
+ * @return WDMP_SUCCESS, WDMP_ERR_VALUE_IS_EMPTY, WDMP_FAILURE or WDMP_ERR_UNKNOWN_COMPONENT.
+ */
+WDMP_STATUS getRFCDefaultValue(const char *pcComponent, const char *pcParameterName, RFC_ParamData_t *pstParam)
+{
+   if (pcParameterName == NULL || pstParam == NULL)
+      return WDMP_ERR_INVALID_PARAM;
 
-   curl_handle = curl_easy_init();
+   string componentFile;
+   if (pcComponent != NULL)
+      componentFile = string(pcComponent) + ".ini";
+   const char *pcComponentFile = pcComponent != NULL ? componentFile.c_str() : NULL;
 
-   ostringstream ss;
-   ss << eDataType;
-   string strDataType = ss.str();
+   std::shared_ptr<const RfcDefaultsSnapshot> snapshot = rfcDefaultsCurrent(pcComponentFile);
+   if (!snapshot || (pcComponentFile != NULL && !snapshot->hasComponent(pcComponentFile)))
+      return WDMP_ERR_UNKNOWN_COMPONENT;
+
+   long index = snapshot->find(pcParameterName, pcComponentFile);
+   if (index < 0)
+      return WDMP_FAILURE;
+
+   const char *name, *value;
+   size_t nameLen, valueLen;
+   snapshot->record((size_t)index, &name, &nameLen, &value, &valueLen);
+   RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "Found Key = %s : Value = %.*s\n", pcParameterName, (int)valueLen, value);
+   if (valueLen == 0)
+      return WDMP_ERR_VALUE_IS_EMPTY;
+
+   strncpy(pstParam->name, pcParameterName, MAX_PARAM_LEN);
+   pstParam->name[MAX_PARAM_LEN - 1] = '\0';
+   valueLen = std::min(valueLen, (size_t)MAX_PARAM_LEN - 1);
+   memcpy(pstParam->value, value, valueLen);
+   pstParam->value[valueLen] = '\0';
+   pstParam->type = WDMP_NONE;
+   return WDMP_SUCCESS;
+}
+
+/**
+ * @brief JSON body of a hostif set.
+ * @param[in] pstParams  Parameters to set.
+ * @param[in] pending    Indexes into @p pstParams to include.
+ */
+string rfcHostifSetBody(const RFC_SetParamData_t *pstParams, const vector<size_t> &pending)
+{
+   // {"name":"","value":"","dataType":<int>},
+   size_t dataLen = 20;
+   for (size_t j = 0; j < pending.size(); j++)
+      dataLen += jsonEscapedLength(pstParams[pending[j]].name) + jsonEscapedLength(pstParams[pending[j]].value) + 48;
 
-   string data = "{\"parameters\" : [{\"name\":\"";
-   data.append(pcParameterName);
-   data.append("\",\"value\":\"");
-   data.append(pcParameterValue);
-   data.append("\",\"dataType\":");
-   data.append(strDataType);
-   data.append("}]}");
+   string data;
+   data.reserve(dataLen);
+   data.append("{\"parameters\" : [");
+   for (size_t j = 0; j < pending.size(); j++)
+   {
+      const RFC_SetParamData_t &param = pstParams[pending[j]];
+      char strDataType[16];
+      snprintf(strDataType, sizeof(strDataType), "%d", (int)param.type);
+      if (j)
+         data.append(",");
+      data.append("{\"name\":");
+      appendJsonString(data, param.name);
+      data.append(",\"value\":");
+      appendJsonString(data, param.value);
+      data.append(",\"dataType\":");
+      data.append(strDataType);
+      data.append("}");
+   }
+   data.append("]}");
 #ifdef TEMP_LOGGING
-   logofs << prefix() << "setRFCParam data = " << data << " dataLen = " <<  data.length() << endl;
+   TEMP_LOG("setRFCParam data = " << data << " dataLen = " <<  data.length());
 #endif
    RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"setRFCParam data = %s, datalen = %zu\n", data.c_str(), data.length());
+   return data;
+}
+
+/**
+ * @brief Parse the hostif answer to a set into per-parameter statuses.
+ * @param[in]  response   Response body.
+ * @param[in]  pstParams  Parameters that were set.
+ * @param[in]  pending    Indexes into @p pstParams that were sent.
+ * @param[out] peStatus   Status of each sent parameter, indexed like @p pstParams.
+ */
+void rfcHostifParseSet(const string &response, const RFC_SetParamData_t *pstParams, const vector<size_t> &pending, WDMP_STATUS *peStatus)
+{
+   RfcHostifResponse parsed;
+   if (!parseHostifResponse(response, &parsed))
+      return;
 
-   if (curl_handle)
+   WDMP_STATUS overall = WDMP_FAILURE;
+   if(parsed.hasStatusCode)
    {
-       char pcCallerIDHeader[128];
-       if(pcCallerID)
-           snprintf(pcCallerIDHeader, sizeof(pcCallerIDHeader), "CallerID: %s", pcCallerID);
-       else
-           sprintf(pcCallerIDHeader, "CallerID: Unknown");
+      overall = (WDMP_STATUS)parsed.statusCode;
+#ifdef TEMP_LOGGING
+      TEMP_LOG("statusCode = " << parsed.statusCode);
+#endif
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"statusCode = %d\n", overall);
+   }
 
-      struct curl_slist *customHeadersList = NULL;
-      customHeadersList = curl_slist_append(customHeadersList, pcCallerIDHeader);
-      if(curl_easy_setopt(curl_handle, CURLOPT_HTTPHEADER, customHeadersList) != CURLE_OK){
-          RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_HTTPHEADER\n", __FUNCTION__, __LINE__);
-      }
-      if(curl_easy_setopt(curl_handle, CURLOPT_URL, url) != CURLE_OK){
-          RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_URL\n", __FUNCTION__, __LINE__); 
+   // hostif may report per-parameter results; anything it does not list takes the overall status.
+   vector<bool> answered(pending.size(), false);
+   for (size_t k = 0 ; k < parsed.parameters.size() ; k++)
+   {
+      const RfcHostifEntry &entry = parsed.parameters[k];
+      if (!entry.hasName)
+         continue;
+      for (size_t j = 0; j < pending.size(); j++)
+      {
+         if (answered[j] || strcmp(pstParams[pending[j]].name, entry.name.c_str()) != 0)
+            continue;
+         answered[j] = true;
+         peStatus[pending[j]] = readHostifParamStatus(entry, overall);
+         break;
       }
-      if(curl_easy_setopt(curl_handle, CURLOPT_HTTPPOST, 1L) != CURLE_OK){
-	  RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_HTTPPOST\n", __FUNCTION__, __LINE__);    
-      } 	      
-      if(curl_easy_setopt(curl_handle, CURLOPT_POSTFIELDSIZE, (long) data.length()) != CURLE_OK){
-	  RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_POSTFIELDSIZE\n", __FUNCTION__, __LINE__);    
-      }  	      
-      if(curl_easy_setopt(curl_handle, CURLOPT_POSTFIELDS, data.c_str()) != CURLE_OK){
-          RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_POSTFIELDS\n", __FUNCTION__, __LINE__);      	      
-      }	      
-      if(curl_easy_setopt(curl_handle, CURLOPT_FOLLOWLOCATION, 1) != CURLE_OK){
-          RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_FOLLOWLOCATION\n", __FUNCTION__, __LINE__);      	      
-      }	      
-      if(curl_easy_setopt(curl_handle, CURLOPT_WRITEFUNCTION, writeCurlResponse) != CURLE_OK){
-          RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_WRITEFUNCTION\n", __FUNCTION__, __LINE__);
-      }	      
-      if(curl_easy_setopt(curl_handle, CURLOPT_WRITEDATA, &response) != CURLE_OK){
-          RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"%s:%d curl setup failed for CURLOPT_WRITEDATA\n", __FUNCTION__, __LINE__);
-      } 	      
-      res = curl_easy_perform(curl_handle);
-      curl_easy_getinfo(curl_handle, CURLINFO_RESPONSE_CODE, &http_code);
+   }
+   for (size_t j = 0; j < pending.size(); j++)
+   {
+      if (!answered[j])
+         peStatus[pending[j]] = overall;
+   }
+}
 
-#ifdef TEMP_LOGGING
-   logofs << prefix() << "curl response = " << res << "http response code = " << http_code << endl;
-#endif
-      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"curl response : %d http response code: %ld\n", res, http_code);
-      curl_easy_cleanup(curl_handle);
+/**
+ * @brief Whether a set entry can be sent to hostif (non-empty name and a value).
+ * @param[in] pstParam       Entry to check.
+ * @param[in] allowWildcard  Also send a name ending in '.', as setRFCParameter() always has.
+ */
+bool rfcSetParamValid(const RFC_SetParamData_t *pstParam, bool allowWildcard)
+{
+   const char *name = pstParam->name;
+   return name != NULL && *name != '\0' && (allowWildcard || name[strlen(name) - 1] != '.') && pstParam->value != NULL;
+}
+
+/**
+ * @brief Send the @p pending entries of @p pstParams to hostif as one set.
+ * @param[in]  pcCallerID  Caller identifier.
+ * @param[in]  pstParams   Parameters to set.
+ * @param[in]  pending     Indexes into @p pstParams to send.
+ * @param[out] peStatus    Status of each sent parameter, indexed like @p pstParams; untouched unless hostif answered.
+ * @param[in]  deadlineMs  Bound on the request; 0 keeps the default timeouts.
+ * @return Outcome of the request.
+ */
+RfcHostifResult rfcHostifSetRequest(const char *pcCallerID, const RFC_SetParamData_t *pstParams, const vector<size_t> &pending,
+                                    WDMP_STATUS *peStatus, unsigned int deadlineMs)
+{
+   string response;
+   string data = rfcHostifSetBody(pstParams, pending);
+   RfcHostifResult res = sendHostifRequest(pcCallerID, data, true, response, deadlineMs);
+   if (res == RFC_HOSTIF_OK)
+      rfcHostifParseSet(response, pstParams, pending, peStatus);
+   return res;
+}
+
+/**
+ * @brief Send the valid entries of @p pstParams to hostif in one set, or queue them for write-behind.
+ * @param[in]  pcCallerID     Caller identifier.
+ * @param[in]  pstParams      Array of @p count name/value/type entries.
+ * @param[in]  count          Number of entries.
+ * @param[out] peStatus       Array of @p count per-parameter status codes.
+ * @param[in]  allowWildcard  Send names ending in '.' too (see rfcSetParamValid()).
+ * @return WDMP_SUCCESS if every parameter was set, otherwise the first failing status.
+ */
+static WDMP_STATUS setParameters(const char *pcCallerID, const RFC_SetParamData_t *pstParams, size_t count, WDMP_STATUS *peStatus,
+                                 bool allowWildcard)
+{
+   vector<size_t> pending;
+   for (size_t i = 0; i < count; i++)
+   {
+      peStatus[i] = WDMP_FAILURE;
+      if (!rfcSetParamValid(&pstParams[i], allowWildcard))
+      {
+         RDK_LOG (RDK_LOG_DEBUG, LOG_RFCAPI, "%s: RFC API doesn't support wildcard/empty parameterName or NULL parameterValue at index %zu\n", __FUNCTION__, i);
+         continue;
+      }
+      pending.push_back(i);
+   }
 
-      curl_slist_free_all(customHeadersList);
+   if (!pending.empty())
+   {
+      // With write-behind on, sets queued earlier go first, and sets hostif cannot take yet are queued.
+      bool writeBehind = rfcWriteBehindEnabled();
+      RfcHostifResult res = RFC_HOSTIF_UNREACHABLE;
+      if (!writeBehind || rfcWriteBehindReplay())
+         res = rfcHostifSetRequest(pcCallerID, pstParams, pending, peStatus, 0);
+      if (writeBehind && res == RFC_HOSTIF_UNREACHABLE && rfcWriteBehindAppend(pcCallerID, pstParams, pending))
+      {
+         for (size_t j = 0; j < pending.size(); j++)
+            peStatus[pending[j]] = WDMP_SUCCESS;
+      }
    }
-   else
+
+   WDMP_STATUS ret = WDMP_SUCCESS;
+   bool changed = false;
+   for (size_t i = 0; i < count; i++)
    {
+      if (peStatus[i] == WDMP_SUCCESS)
+         changed = true;
+      else if (ret == WDMP_SUCCESS)
+         ret = peStatus[i];
+   }
+   // Cached values may now be stale; this also covers RFC_CONTROL_RELOADCACHE.
+   if (changed)
+      rfcStoreChanged();
+   return ret;
+}
+
+/**
+ * @brief Set several RFC parameters with a single hostif POST.
+ * @param[in]  pcCallerID  Caller identifier.
+ * @param[in]  pstParams   Array of @p count name/value/type entries.
+ * @param[in]  count       Number of entries.
+ * @param[out] peStatus    Array of @p count per-parameter status codes.
+ * @return WDMP_SUCCESS if every parameter was set, otherwise the first failing status.
+ */
+WDMP_STATUS setRFCParameters(const char *pcCallerID, const RFC_SetParamData_t *pstParams, size_t count, WDMP_STATUS *peStatus)
+{
 #ifdef TEMP_LOGGING
-   logofs << prefix() << "Could not perform curl" << endl;
+   openLogFile();
 #endif
-      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI,"Could not perform curl \n");
-   }
-   if (res == CURLE_OK)
+   RfcStatsScope stats(pcCallerID, RFC_STATS_SET_MULTI);
+   if (pstParams == NULL || peStatus == NULL || count == 0)
    {
-      cJSON *response_json = NULL;
-#ifdef TEMP_LOGGING
-   logofs << prefix() << "curl response: " << response << endl;
+      RDK_LOG (RDK_LOG_ERROR, LOG_RFCAPI, "%s: invalid arguments\n", __FUNCTION__);
+      return stats.done(WDMP_FAILURE);
+   }
+   return stats.done(setParameters(pcCallerID, pstParams, count, peStatus, false));
+}
+
+/**
+ * @brief Set an RFC parameter via hostif HTTP.
+ * @param[in] pcCallerID        Caller identifier.
+ * @param[in] pcParameterName   TR181 parameter name.
+ * @param[in] pcParameterValue  New value to set.
+ * @param[in] eDataType         WDMP data type.
+ * @return WDMP_STATUS code.
+ */
+WDMP_STATUS setRFCParameter(const char *pcCallerID, const char* pcParameterName, const char* pcParameterValue, DATA_TYPE eDataType)
+{
+#ifdef TEMP_LOGGING 
+   openLogFile();
 #endif
-      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI,"Curl response: %s\n", response.c_str());
-      response_json = cJSON_Parse(response.c_str());
-      if (response_json)
-      {
-         cJSON* statusCode = cJSON_GetObjectItem(response_json, "statusCode");
-         if(statusCode)
-         {
-            ret = (WDMP_STATUS)statusCode->valueint;
+   RfcStatsScope stats(pcCallerID, RFC_STATS_SET);
+   if(!strcmp(pcParameterName+strlen(pcParameterName)-1,".") && pcParameterValue == NULL)
+   {
 #ifdef TEMP_LOGGING
-   logofs << prefix() << "statusCode = " << statusCode->valueint << endl;
+   TEMP_LOG(__FUNCTION__ << ": RFC API doesn't support wildcard parameterName or NULL parameterValue");
 #endif
-            RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI,"statusCode = %d\n", ret);
-         }
-         cJSON_Delete(response_json);
-      }
+       RDK_LOG (RDK_LOG_DEBUG, LOG_RFCAPI, "%s: RFC API doesn't support wildcard parameterName or NULL parameterValue\n", __FUNCTION__);
+       return stats.done(WDMP_FAILURE);
    }
-   return ret;
+
+   RFC_SetParamData_t param;
+   param.name = pcParameterName;
+   param.value = pcParameterValue;
+   param.type = eDataType;
+   WDMP_STATUS status = WDMP_FAILURE;
+   // Only a wildcard without a value is refused here; hostif decides what a wildcard set means.
+   return stats.done(setParameters(pcCallerID, &param, 1, &status, true));
 }
 
 /**
@@ -722,14 +1532,49 @@ int getRFCParameter(const char* pcParameterName, RFC_ParamData_t *pstParam)
  */
 bool isRFCEnabled(const char *feature)
 {
+   bool enabled = false;
+   if (rfcFeatureLookup(&feature, 1, &enabled))
+      return enabled;
+
    struct stat buffer;
    string fileName = RFC_FEATURE_DIR + string(".RFC_") + feature + ".ini";
 
    return (stat(fileName.c_str(), &buffer) == 0);
 }
 
+/**
+ * @brief Check several RFC features at once.
+ * @param[in]  ppcFeatures  Array of @p count feature names.
+ * @param[in]  count        Number of entries.
+ * @param[out] pbEnabled    Per-feature result.
+ * @return Number of enabled features.
+ */
+size_t isRFCEnabledMulti(const char **ppcFeatures, size_t count, bool *pbEnabled)
+{
+   if (ppcFeatures == NULL || pbEnabled == NULL)
+      return 0;
+
+   if (!rfcFeatureLookup(ppcFeatures, count, pbEnabled))
+   {
+      for (size_t i = 0; i < count; i++)
+      {
+         struct stat buffer;
+         pbEnabled[i] = ppcFeatures[i] != NULL &&
+                        stat((RFC_FEATURE_DIR + string(".RFC_") + ppcFeatures[i] + ".ini").c_str(), &buffer) == 0;
+      }
+   }
+
+   size_t enabled = 0;
+   for (size_t i = 0; i < count; i++)
+   {
+      if (pbEnabled[i])
+         enabled++;
+   }
+   return enabled;
+}
+
 /** @brief Expose writeCurlResponse for unit testing. */
-#ifdef GTEST_ENABLE
+#if defined(GTEST_ENABLE) && !defined(RFCAPI_LITE_CLIENT)
 size_t (*getWriteCurlResponse(void))(void *ptr, size_t size, size_t nmemb, std::string stream) {
     return &writeCurlResponse;
 }
@@ -18,6 +18,13 @@
  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
  * See the License for the specific language governing permissions and
  * limitations under the License.
+ *
+ * Thread safety (RDK-V): every function declared here may be called from any
+ * number of threads at once. curl_global_init() is run once, on the first
+ * request. Each thread keeps its own curl handle, and with it a persistent
+ * connection to hostif. A process that uses libcurl directly should call
+ * curl_global_init() itself before starting threads. A library built with
+ * --enable-rfcapi-lite does not use libcurl; each thread keeps its own socket.
  */
 
 #ifndef RFCAPI_H_
@@ -89,6 +96,87 @@ int getRFCParameter(const char* pcParameterName, RFC_ParamData_t *pstParamData);
  */
 WDMP_STATUS getRFCParameter(const char *pcCallerID, const char* pcParameterName, RFC_ParamData_t *pstParamData);
 
+/**
+ * @brief Retrieve an RFC parameter value into a caller-provided buffer.
+ *
+ * Same lookup as getRFCParameter(), without the 4 KiB RFC_ParamData_t.
+ * @param[in]     pcCallerID       Caller identifier string.
+ * @param[in]     pcParameterName  TR181 parameter name.
+ * @param[out]    pcValue          Receives the NUL-terminated value.
+ * @param[in,out] pValueLen        In: size of @p pcValue in bytes. Out: length of the
+ *                                 value excluding the NUL, also when it did not fit.
+ * @param[out]    peType           Receives the data type; may be NULL.
+ * @return WDMP_STATUS code. WDMP_STATUS_RESOURCES means @p pcValue holds a truncated
+ *         value and *pValueLen + 1 bytes are required.
+ */
+WDMP_STATUS getRFCParameterValue(const char *pcCallerID, const char *pcParameterName, char *pcValue, size_t *pValueLen, DATA_TYPE *peType);
+
+/**
+ * @brief getRFCParameter() with a bound on how long hostif may take.
+ *
+ * For latency-critical paths (channel change, app launch). When hostif does
+ * not answer within @p deadlineMs, the last persisted value is taken from
+ * the local store files (tr181store.ini, bootstrap.ini, rfcdefaults.ini) and
+ * WDMP_ERR_TIMEOUT is returned with *pbStale set. The type is then WDMP_NONE.
+ * @param[in]  pcCallerID       Caller identifier string.
+ * @param[in]  pcParameterName  TR181 parameter name.
+ * @param[out] pstParam         Filled with name/value/type.
+ * @param[in]  deadlineMs       Milliseconds hostif may take; 0 uses the default 5 s / 10 s timeouts.
+ * @param[out] pbStale          true when @p pstParam holds a stale store-file value; may be NULL.
+ * @return WDMP_STATUS code. WDMP_ERR_TIMEOUT means the deadline was missed; the value
+ *         is usable only if *pbStale is true.
+ */
+WDMP_STATUS getRFCParameterWithDeadline(const char *pcCallerID, const char *pcParameterName, RFC_ParamData_t *pstParam,
+                                        unsigned int deadlineMs, bool *pbStale);
+
+/**
+ * @brief Retrieve several RFC parameters with one hostif request.
+ *
+ * Before hostif is ready each name is resolved from the local store files,
+ * exactly as getRFCParameter() does.
+ * @param[in]  pcCallerID          Caller identifier string.
+ * @param[in]  ppcParameterNames   Array of @p count TR181 parameter names.
+ * @param[in]  count               Number of entries in each array.
+ * @param[out] pstParams           Filled with name/value/type, in request order.
+ * @param[out] peStatus            Per-parameter WDMP status, in request order.
+ * @return WDMP_SUCCESS if every parameter resolved, otherwise the first failing status.
+ */
+WDMP_STATUS getRFCParameters(const char *pcCallerID, const char **ppcParameterNames, size_t count, RFC_ParamData_t *pstParams, WDMP_STATUS *peStatus);
+
+/**
+ * @brief Callback receiving one parameter of a getRFCParameterTree() query.
+ * @param[in] pstParam   Parameter name/value/type; only valid during the call.
+ * @param[in] pUserData  Value passed to getRFCParameterTree().
+ */
+typedef void (*RFC_ParamCallback_t)(const RFC_ParamData_t *pstParam, void *pUserData);
+
+/**
+ * @brief Retrieve every RFC parameter under a TR181 subtree.
+ *
+ * Uses one hostif wildcard request, or before hostif is ready, a sorted
+ * index of the local store files (types are then reported as WDMP_NONE).
+ * @param[in] pcCallerID  Caller identifier string.
+ * @param[in] pcPrefix    Subtree name ending in '.', e.g. "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay."
+ * @param[in] callback    Invoked once per parameter found.
+ * @param[in] pUserData   Passed through to @p callback.
+ * @return WDMP_SUCCESS if at least one parameter was reported, otherwise a failure code.
+ */
+WDMP_STATUS getRFCParameterTree(const char *pcCallerID, const char *pcPrefix, RFC_ParamCallback_t callback, void *pUserData);
+
+/**
+ * @brief Look up a build-time default from the compiled /etc/rfcdefaults snapshot.
+ *
+ * The ini files are compiled once into a sorted binary snapshot, so the
+ * lookup is a binary search instead of a file scan.
+ * @param[in]  pcComponent      Defaults file name without ".ini", or NULL for
+ *                              the value getRFCParameter() falls back to.
+ * @param[in]  pcParameterName  Parameter name.
+ * @param[out] pstParamData     Filled with name/value; type is WDMP_NONE.
+ * @return WDMP_SUCCESS, WDMP_ERR_VALUE_IS_EMPTY, WDMP_FAILURE if not defined,
+ *         or WDMP_ERR_UNKNOWN_COMPONENT if @p pcComponent is not in the snapshot.
+ */
+WDMP_STATUS getRFCDefaultValue(const char *pcComponent, const char *pcParameterName, RFC_ParamData_t *pstParamData);
+
 /**
  * @brief Set an RFC parameter value via hostif.
  * @param[in] pcCallerID        Caller identifier string.
@@ -99,6 +187,106 @@ WDMP_STATUS getRFCParameter(const char *pcCallerID, const char* pcParameterName,
  */
 WDMP_STATUS setRFCParameter(const char *pcCallerID, const char* pcParameterName, const char* pcParameterValue, DATA_TYPE eDataType);
 
+/**
+ * @struct _RFC_SetParam_t
+ * @brief One entry of a setRFCParameters() request.
+ */
+typedef struct _RFC_SetParam_t {
+   const char *name;    /**< TR181 parameter name. */
+   const char *value;   /**< New value. */
+   DATA_TYPE type;      /**< WDMP data type of the value. */
+} RFC_SetParamData_t;
+
+/**
+ * @brief Set several RFC parameters with one hostif POST.
+ * @param[in]  pcCallerID  Caller identifier string.
+ * @param[in]  pstParams   Array of @p count name/value/type entries.
+ * @param[in]  count       Number of entries.
+ * @param[out] peStatus    Per-parameter WDMP status, in request order.
+ * @return WDMP_SUCCESS if every parameter was set, otherwise the first failing status.
+ */
+WDMP_STATUS setRFCParameters(const char *pcCallerID, const RFC_SetParamData_t *pstParams, size_t count, WDMP_STATUS *peStatus);
+
+/** @brief Handle of an asynchronous get/set; 0 means the request was not queued. */
+typedef unsigned long RFC_AsyncHandle_t;
+
+/**
+ * @brief Completion of getRFCParameterAsync().
+ * @param[in] handle    Handle returned when the request was queued.
+ * @param[in] status    WDMP status, as getRFCParameter() would have returned it.
+ * @param[in] pstParam  Name/value/type; only valid for the duration of the call.
+ * @param[in] userData  Pointer passed when the request was queued.
+ */
+typedef void (*RFC_GetCompletion_t)(RFC_AsyncHandle_t handle, WDMP_STATUS status, const RFC_ParamData_t *pstParam, void *userData);
+
+/**
+ * @brief Completion of setRFCParameterAsync().
+ * @param[in] handle    Handle returned when the request was queued.
+ * @param[in] status    WDMP status, as setRFCParameter() would have returned it.
+ * @param[in] userData  Pointer passed when the request was queued.
+ */
+typedef void (*RFC_SetCompletion_t)(RFC_AsyncHandle_t handle, WDMP_STATUS status, void *userData);
+
+/**
+ * @brief Start reading an RFC parameter without blocking the caller.
+ *
+ * All asynchronous requests share one curl multi handle and run concurrently
+ * on a library worker thread (one after another with --enable-rfcapi-lite). The completion runs on that thread unless
+ * getRFCAsyncFd() has been called, in which case it runs from
+ * dispatchRFCAsync() on the caller's thread.
+ * @param[in] pcCallerID       Caller identifier string.
+ * @param[in] pcParameterName  TR181 parameter name.
+ * @param[in] callback         Completion; must not be NULL.
+ * @param[in] userData         Passed to @p callback.
+ * @return Request handle, or 0 if the request could not be queued.
+ */
+RFC_AsyncHandle_t getRFCParameterAsync(const char *pcCallerID, const char *pcParameterName, RFC_GetCompletion_t callback, void *userData);
+
+/**
+ * @brief Start setting an RFC parameter without blocking the caller.
+ *
+ * Write-behind (setRFCWriteBehindEnabled()) does not apply: while hostif is
+ * not ready or refuses the connection, the set completes with WDMP_FAILURE
+ * and is not queued. Use setRFCParameter() for sets that must survive that.
+ * @param[in] pcCallerID        Caller identifier string.
+ * @param[in] pcParameterName   TR181 parameter name.
+ * @param[in] pcParameterValue  New value.
+ * @param[in] eDataType         WDMP data type of the value.
+ * @param[in] callback          Completion, or NULL for fire-and-forget.
+ * @param[in] userData          Passed to @p callback.
+ * @return Request handle, or 0 if the request could not be queued.
+ * @see getRFCParameterAsync()
+ */
+RFC_AsyncHandle_t setRFCParameterAsync(const char *pcCallerID, const char *pcParameterName, const char *pcParameterValue, DATA_TYPE eDataType, RFC_SetCompletion_t callback, void *userData);
+
+/**
+ * @brief Switch completions to the caller's event loop and return a pollable fd.
+ *
+ * The fd (an eventfd) becomes readable when completions are pending; call
+ * dispatchRFCAsync() to run them. Do not read from or close the fd.
+ * A child created with fork() has its own worker and fd: until it calls
+ * getRFCAsyncFd() itself, its completions run on its worker thread.
+ * @return File descriptor, or -1 on failure.
+ */
+int getRFCAsyncFd(void);
+
+/**
+ * @brief Run the completions of finished asynchronous requests.
+ * @return Number of completions run.
+ */
+size_t dispatchRFCAsync(void);
+
+/**
+ * @brief Cancel an asynchronous request whose completion has not run yet.
+ *
+ * A cancelled request never invokes its completion. A set that has already
+ * reached hostif may still take effect.
+ * @param[in] handle  Handle returned when the request was queued.
+ * @retval true   The completion will not run.
+ * @retval false  Unknown handle, or the completion already ran or is running.
+ */
+bool cancelRFCAsync(RFC_AsyncHandle_t handle);
+
 /**
  * @brief Return a human-readable error string for a WDMP status code.
  * @param[in] code  WDMP status code.
@@ -106,6 +294,17 @@ WDMP_STATUS setRFCParameter(const char *pcCallerID, const char* pcParameterName,
  */
 const char* getRFCErrorString(WDMP_STATUS code);
 
+/**
+ * @brief Wait until tr69hostif can answer parameter requests.
+ *
+ * Until then getRFCParameter() answers from the local store files. Sleeps on
+ * an inotify watch of the hostif ready marker rather than polling it.
+ * @param[in] timeoutMs  Longest time to wait, in milliseconds; 0 only checks.
+ * @retval true   hostif is ready.
+ * @retval false  Still not ready when the deadline passed.
+ */
+bool waitForRFCHostifReady(unsigned int timeoutMs);
+
 /**
  * @brief Check whether a named RFC feature is enabled.
  * @param[in] feature  Feature name (without "RFC_" prefix).
@@ -114,6 +313,18 @@ const char* getRFCErrorString(WDMP_STATUS code);
  */
 bool isRFCEnabled(const char *);
 
+/**
+ * @brief Check several RFC features with one lookup.
+ *
+ * Like isRFCEnabled(), answered from an in-memory set of enabled features
+ * while an RFC store watcher started elsewhere in the process is armed.
+ * @param[in]  ppcFeatures  Array of @p count feature names (without "RFC_" prefix).
+ * @param[in]  count        Number of entries in each array.
+ * @param[out] pbEnabled    Per-feature result, in request order.
+ * @return Number of enabled features.
+ */
+size_t isRFCEnabledMulti(const char **ppcFeatures, size_t count, bool *pbEnabled);
+
 /**
  * @brief Check whether a file exists in a given directory.
  * @param[in] dir       Directory path to search.
@@ -123,6 +334,228 @@ bool isRFCEnabled(const char *);
  */
 bool isFileInDirectory(const char *, const char *);
 
+/**
+ * @struct _RFC_CacheStats_t
+ * @brief Counters of the in-process getRFCParameter() cache.
+ */
+typedef struct _RFC_CacheStats_t {
+   unsigned long hits;           /**< Lookups answered without a hostif request. */
+   unsigned long misses;         /**< Lookups that went to hostif. */
+   unsigned long invalidations;  /**< Times the cache was dropped after a store change. */
+   unsigned long entries;        /**< Entries currently held. */
+} RFC_CacheStats_t;
+
+/**
+ * @brief Enable, retune or disable the in-process parameter cache.
+ *
+ * The cache is off by default. It can also be enabled without code changes
+ * by exporting RFC_CACHE_TTL_MS. Entries are dropped when rfcMgr/hostif
+ * rewrite the RFC store files, when this process sets a parameter, or when
+ * the TTL expires.
+ * @param[in] ttlMs  Entry lifetime in milliseconds; 0 disables the cache.
+ */
+void setRFCCacheTTL(unsigned int ttlMs);
+
+/**
+ * @brief Enable, retune or disable caching of unknown and empty parameters.
+ *
+ * Off by default, and independent of setRFCCacheTTL(). It can also be
+ * enabled by exporting RFC_NEGATIVE_CACHE_TTL_MS. hostif answers of
+ * WDMP_ERR_INVALID_PARAMETER_NAME, WDMP_ERR_NOT_EXIST and
+ * WDMP_ERR_VALUE_IS_EMPTY are then replayed without a request. They are
+ * dropped on the same store changes as cached values. At most 256 such
+ * entries are kept.
+ * @param[in] ttlMs  Entry lifetime in milliseconds; 0 disables negative caching.
+ */
+void setRFCNegativeCacheTTL(unsigned int ttlMs);
+
+/**
+ * @brief Read the cache hit/miss counters.
+ * @param[out] pstStats  Filled with the current counters.
+ */
+void getRFCCacheStats(RFC_CacheStats_t *pstStats);
+
+/** @brief Drop all cached parameters. */
+void clearRFCCache(void);
+
+/**
+ * @brief Reach hostif over a Unix domain socket instead of loopback TCP.
+ *
+ * Off by default. It can also be enabled without code changes by exporting
+ * RFC_HOSTIF_SOCKET. TCP is still used while the socket does not exist, and
+ * for a while after it refuses a connection.
+ * @param[in] pcPath  Socket path; NULL or "" uses TCP only.
+ */
+void setRFCHostifSocket(const char *pcPath);
+
+/**
+ * @brief Serve RFC parameters from the snapshot published by rfcMgr.
+ *
+ * Off by default. It can also be enabled without code changes by exporting
+ * RFC_SNAPSHOT=1. Only names under Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.
+ * found in the snapshot are answered from it; everything else, and every
+ * name once tr181store.ini or bootstrap.ini changed after the snapshot was
+ * taken, still goes to hostif.
+ * @param[in] enable  true to read from the snapshot.
+ */
+void setRFCSnapshotEnabled(bool enable);
+
+/**
+ * @brief Current RFC store generation, for callers that keep derived values.
+ *
+ * Moves whenever rfcMgr/hostif rewrite the RFC store files, this process
+ * sets a parameter, or hostif becomes ready or unreachable. A value derived
+ * from getRFCParameter() stays valid while this returns the same non-zero
+ * number. 0 means changes cannot be tracked yet, so nothing may be kept.
+ * Costs two atomic loads once tracking is established.
+ * @return Store generation, or 0.
+ */
+unsigned long getRFCStoreGeneration(void);
+
+/**
+ * @brief Publish the current RFC parameters for setRFCSnapshotEnabled() readers.
+ *
+ * Called by rfcMgr after applying an XConf response. Reads the whole
+ * Device.DeviceInfo.X_RDKCENTRAL-COM_RFC. subtree from hostif and replaces
+ * the snapshot file with rename().
+ * @param[in] pcCallerID  Caller identifier.
+ * @return WDMP_SUCCESS, or the failure that kept the snapshot from being replaced.
+ */
+WDMP_STATUS publishRFCSnapshot(const char *pcCallerID);
+
+/** @brief Handle of a change subscription; 0 means the subscription failed. */
+typedef unsigned long RFC_SubscriptionHandle_t;
+
+/**
+ * @brief Change notification of subscribeRFCParameter().
+ *
+ * Runs on the librfcapi subscription thread. It may call back into librfcapi,
+ * including unsubscribeRFCParameter(), but should not block for long, since
+ * it delays every other subscriber.
+ * @param[in] handle     Subscription the change belongs to.
+ * @param[in] pcName     Parameter that changed.
+ * @param[in] pcValue    New value, or NULL if the parameter was removed or cleared.
+ * @param[in] pUserData  Value passed to subscribeRFCParameter().
+ */
+typedef void (*RFC_ChangeCallback_t)(RFC_SubscriptionHandle_t handle, const char *pcName, const char *pcValue, void *pUserData);
+
+/**
+ * @brief Get told when parameters under a prefix change, instead of polling.
+ *
+ * Changes are taken from the store files rfcMgr/hostif persist
+ * (tr181store.ini, bootstrap.ini, rfcdefaults.ini, merged as
+ * getRFCParameter() does before hostif is ready) and from
+ * the local store, which setLocalParam() writes. A burst of writes, such
+ * as rfcMgr applying a new XConf configuration, is reported once it has been
+ * quiet for 200 ms, and only for parameters whose value actually differs
+ * from the last one reported. Values current at subscription time are not
+ * reported. A child created with fork() does not inherit the subscription
+ * thread; its first subscribeRFCParameter() starts one of its own, which
+ * also serves the subscriptions it inherited.
+ * @param[in] pcPrefix   Name prefix, e.g. "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay."; a full name watches one parameter.
+ * @param[in] callback   Invoked once per changed parameter.
+ * @param[in] pUserData  Passed through to @p callback.
+ * @return Subscription handle, or 0 on failure.
+ */
+RFC_SubscriptionHandle_t subscribeRFCParameter(const char *pcPrefix, RFC_ChangeCallback_t callback, void *pUserData);
+
+/**
+ * @brief Stop a subscription.
+ *
+ * Once this returns, the callback is no longer running for @p handle and
+ * will not be called again (when called from that callback itself, only the
+ * latter holds).
+ * @param[in] handle  Handle returned by subscribeRFCParameter().
+ * @retval true   The subscription was removed.
+ * @retval false  Unknown handle.
+ */
+bool unsubscribeRFCParameter(RFC_SubscriptionHandle_t handle);
+
+/** @brief Operations counted by the per-caller statistics. */
+typedef enum {
+   RFC_STATS_GET = 0,      /**< getRFCParameter(), getRFCParameterValue(), getRFCParameterWithDeadline(). */
+   RFC_STATS_GET_MULTI,    /**< getRFCParameters(). */
+   RFC_STATS_GET_TREE,     /**< getRFCParameterTree(). */
+   RFC_STATS_SET,          /**< setRFCParameter(). */
+   RFC_STATS_SET_MULTI,    /**< setRFCParameters(). */
+   RFC_STATS_GET_ASYNC,    /**< getRFCParameterAsync(), submission to completion. */
+   RFC_STATS_SET_ASYNC,    /**< setRFCParameterAsync(), submission to completion. */
+   RFC_STATS_OP_COUNT
+} RFC_StatsOp_t;
+
+#define RFC_STATS_CALLER_LEN 48        /**< Caller IDs are counted by their first 47 characters. */
+#define RFC_STATS_LATENCY_BUCKETS 20   /**< Latency histogram size; see RFC_CallerStats_t::latency. */
+
+/**
+ * @struct _RFC_CallerStats_t
+ * @brief Counters of one caller ID and operation, summed over all processes.
+ */
+typedef struct _RFC_CallerStats_t {
+   char callerID[RFC_STATS_CALLER_LEN];
+   RFC_StatsOp_t op;
+   unsigned long long calls;
+   unsigned long long hostif;    /**< Calls answered by a hostif request. */
+   unsigned long long file;      /**< Calls answered from the local store files (hostif not ready or unreachable). */
+   unsigned long long memory;    /**< Calls answered from the cache or the snapshot. */
+   unsigned long long errors;    /**< Calls that returned neither WDMP_SUCCESS nor WDMP_ERR_DEFAULT_VALUE. */
+   unsigned long long totalUs;   /**< Sum of call latencies in microseconds. */
+   unsigned long long latency[RFC_STATS_LATENCY_BUCKETS];  /**< latency[i]: calls taking [2^i, 2^(i+1)) us; [0] includes 0 us, the last bucket is open-ended. */
+} RFC_CallerStats_t;
+
+/** @brief Receives one entry of getRFCCallerStats(). */
+typedef void (*RFC_CallerStatsCallback_t)(const RFC_CallerStats_t *pstStats, void *pUserData);
+
+/**
+ * @brief Count this process's calls per caller ID in shared memory.
+ *
+ * Off by default. It can also be enabled without code changes by exporting
+ * RFC_STATS=1, or for every process by creating /opt/rfcapi_stats.enable.
+ * Counting costs a few relaxed atomic increments per call. The segment is
+ * created readable and writable by every uid, so components running as
+ * different users count into the same table.
+ * @param[in] enable  true to count calls.
+ */
+void setRFCStatsEnabled(bool enable);
+
+/**
+ * @brief Read the statistics of every process that counts calls.
+ * @param[in] callback   Invoked once per caller ID and operation seen.
+ * @param[in] pUserData  Passed through to @p callback.
+ * @return WDMP_SUCCESS, or WDMP_FAILURE if no process has counted anything yet.
+ */
+WDMP_STATUS getRFCCallerStats(RFC_CallerStatsCallback_t callback, void *pUserData);
+
+/** @brief Short name of a statistics operation, e.g. "get". */
+const char *getRFCStatsOpName(RFC_StatsOp_t op);
+
+/**
+ * @brief Queue sets made before hostif is ready, instead of failing them.
+ *
+ * Off by default; it can also be enabled by exporting RFC_WRITE_BEHIND=1.
+ * While hostif is not ready, or refuses the connection, setRFCParameter()
+ * and setRFCParameters() append the sets to a journal in /opt/secure/RFC/,
+ * sync it to disk and return WDMP_SUCCESS. The journal is shared by all
+ * processes and replayed in order, one POST per caller ID, as soon as hostif
+ * is ready, by a librfcapi thread or by the next set, whichever comes first.
+ * Until then getRFCParameter() returns the queued values. A set that hostif
+ * later rejects is logged, not reported to the caller. setRFCParameterAsync()
+ * is not queued and fails instead. A forked child starts
+ * a replay thread of its own once it finds the journal not empty.
+ * @param[in] enable  true to queue sets.
+ */
+void setRFCWriteBehindEnabled(bool enable);
+
+/** @brief Number of sets waiting in the write-behind journal, from every process. */
+size_t getRFCWriteBehindPending(void);
+
+/**
+ * @brief Replay the write-behind journal now.
+ * @param[in] timeoutMs  How long to wait for hostif to become ready.
+ * @retval true   The journal is empty.
+ * @retval false  hostif did not become ready in time or could not be reached; the sets stay queued.
+ */
+bool flushRFCWriteBehind(unsigned int timeoutMs);
+
 #if defined(GTEST_ENABLE)
 /**
  * @brief Merge per-feature rfcdefaults ini files into a single file.
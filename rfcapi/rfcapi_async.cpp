@@ -0,0 +1,616 @@
+/**
+ * @file rfcapi_async.cpp
+ * @brief Asynchronous getRFCParameter()/setRFCParameter() on one worker thread.
+ *
+ * The worker drives all transfers at once on a curl multi handle. In the
+ * curl-free build (RFCAPI_LITE_CLIENT) it sends them one at a time on its
+ * own hostif connection instead.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include "rfcapi_hostif.h"
+#include "rfcapi_ready.h"
+#include "rfcapi_stats.h"
+#include "rfcapi_transport.h"
+#include "rfcapi_watch.h"
+#include "rfcapi_internal.h"
+#include "rdk_debug.h"
+
+/** Upper bound on one curl_multi_wait() while transfers are in flight, in ms. */
+#define ASYNC_WAIT_INTERVAL 1000
+
+/** @brief One queued, in-flight or completed asynchronous request. */
+struct AsyncRequest
+{
+   RFC_AsyncHandle_t handle;
+   bool isSet;
+   bool cancelled;                  /**< Guarded by asyncMutex. */
+   std::string callerID;
+   std::string name;
+   std::string value;
+   DATA_TYPE type;
+   RFC_GetCompletion_t getCallback;
+   RFC_SetCompletion_t setCallback;
+   void *userData;
+   std::string body;                /**< Must outlive the transfer (CURLOPT_POSTFIELDS). */
+   std::string response;
+#ifndef RFCAPI_LITE_CLIENT
+   CURL *curl;
+   struct curl_slist *headers;
+   bool viaSocket;
+#endif
+   unsigned long generation;
+   WDMP_STATUS status;
+   RFC_ParamData_t param;
+   RfcStatsSource statsSource;
+   std::chrono::steady_clock::time_point started;   /**< Submission time, set while statistics are on. */
+};
+
+typedef std::shared_ptr<AsyncRequest> AsyncRequestPtr;
+
+static std::mutex startMutex;
+static std::atomic<pid_t> asyncPid(0);   /**< Process that last ran asyncStart(); 0 before the first call. */
+static bool asyncStarted = false;        /**< Whether asyncPid's worker is running; published by asyncPid. */
+#ifndef RFCAPI_LITE_CLIENT
+static CURLM *multiHandle = NULL;
+#endif
+static int wakeFd = -1;          /**< Signalled to wake the worker for new or cancelled requests. */
+static int completionFd = -1;    /**< Signalled when completions are queued for dispatchRFCAsync(). */
+static std::atomic<bool> fdMode(false);
+static std::atomic<unsigned long> nextHandle(1);
+
+static std::mutex asyncMutex;
+static std::deque<AsyncRequestPtr> submitted;
+static std::deque<AsyncRequestPtr> completed;
+static std::map<RFC_AsyncHandle_t, AsyncRequestPtr> live;   /**< Requests whose completion has not started. */
+
+static void signalFd(int fd)
+{
+   uint64_t one = 1;
+   while (write(fd, &one, sizeof(one)) < 0 && errno == EINTR)
+      ;
+}
+
+static void drainFd(int fd)
+{
+   uint64_t count;
+   while (read(fd, &count, sizeof(count)) < 0 && errno == EINTR)
+      ;
+}
+
+static void invokeCompletion(const AsyncRequestPtr &req)
+{
+   if (req->isSet)
+   {
+      if (req->setCallback != NULL)
+         req->setCallback(req->handle, req->status, req->userData);
+   }
+   else
+   {
+      req->getCallback(req->handle, req->status, &req->param, req->userData);
+   }
+}
+
+/** @brief Hand a finished request to its completion, directly or through the completion fd. */
+static void completeRequest(const AsyncRequestPtr &req)
+{
+   std::unique_lock<std::mutex> lock(asyncMutex);
+   if (req->cancelled)
+      return;
+   if (req->started != std::chrono::steady_clock::time_point())
+      rfcStatsRecord(req->callerID.c_str(), req->isSet ? RFC_STATS_SET_ASYNC : RFC_STATS_GET_ASYNC, req->statsSource, req->status, req->started);
+   if (fdMode.load(std::memory_order_acquire))
+   {
+      completed.push_back(req);
+      lock.unlock();
+      signalFd(completionFd);
+      return;
+   }
+   live.erase(req->handle);
+   lock.unlock();
+   invokeCompletion(req);
+}
+
+#ifndef RFCAPI_LITE_CLIENT
+/**
+ * @brief Create the transfer for a request and add it to the multi handle.
+ * @retval true  The request was added to the multi handle.
+ */
+static bool addTransfer(const AsyncRequestPtr &req)
+{
+   req->curl = rfcHostifRequestCreate(req->callerID.c_str(), req->body, req->isSet, &req->response, &req->headers, &req->viaSocket);
+   if (req->curl == NULL)
+      return false;
+   CURLMcode mc = curl_multi_add_handle(multiHandle, req->curl);
+   if (mc != CURLM_OK)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: curl_multi_add_handle failed: %s\n", __FUNCTION__, curl_multi_strerror(mc));
+      rfcHostifRequestDone(req->curl, req->headers, CURLE_FAILED_INIT, req->response);
+      req->curl = NULL;
+      return false;
+   }
+   return true;
+}
+#endif
+
+/**
+ * @brief Answer a submitted request locally, or prepare its hostif request body.
+ * @retval true  The request needs to go to hostif.
+ */
+static bool startRequest(const AsyncRequestPtr &req)
+{
+   RfcStatsTrace trace(req->statsSource);
+   if (!req->isSet)
+   {
+      size_t length = 0;
+      if (rfcReadParameterLocal(req->name.c_str(), req->param.name, req->param.value, MAX_PARAM_LEN,
+                                &length, &req->param.type, &req->status))
+         return false;
+      // Sampled before the request so a store update racing with it is not cached.
+      req->generation = rfcStoreGeneration();
+      req->body = rfcHostifGetBody(req->name.c_str());
+   }
+   else
+   {
+      RFC_SetParamData_t param = { req->name.c_str(), req->value.c_str(), req->type };
+      // Same rule as setRFCParameter(): a wildcard with a value is hostif's to judge.
+      if (!rfcSetParamValid(&param, true))
+      {
+         RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: RFC API doesn't support empty parameterName\n", __FUNCTION__);
+         return false;
+      }
+      req->body = rfcHostifSetBody(&param, std::vector<size_t>(1, 0));
+   }
+   return true;
+}
+
+/** @brief Parse the hostif answer of a finished request. */
+static void finishRequest(const AsyncRequestPtr &req, RfcHostifResult res)
+{
+   RfcStatsTrace trace(req->statsSource);
+   if (res == RFC_HOSTIF_UNREACHABLE)
+   {
+      rfcHostifUnreachable();
+      // hostif went away (e.g. restarting): answer gets from the store files.
+      size_t length = 0;
+      if (!req->isSet)
+         rfcReadParameterLocal(req->name.c_str(), req->param.name, req->param.value, MAX_PARAM_LEN,
+                               &length, &req->param.type, &req->status);
+      return;
+   }
+   if (res != RFC_HOSTIF_OK)
+      return;
+
+   if (!req->isSet)
+   {
+      size_t length = 0;
+      req->status = rfcHostifParseGet(req->response, req->name.c_str(), req->param.name, req->param.value,
+                                      MAX_PARAM_LEN, &length, &req->param.type, req->generation);
+   }
+   else
+   {
+      RFC_SetParamData_t param = { req->name.c_str(), req->value.c_str(), req->type };
+      rfcHostifParseSet(req->response, &param, std::vector<size_t>(1, 0), &req->status);
+      // Cached values may now be stale; this also covers RFC_CONTROL_RELOADCACHE.
+      if (req->status == WDMP_SUCCESS)
+         rfcStoreChanged();
+   }
+}
+
+#ifndef RFCAPI_LITE_CLIENT
+/** @brief Log and release the transfer of a finished request, then parse its answer. */
+static void finishTransfer(const AsyncRequestPtr &req, CURLcode res)
+{
+   rfcHostifRequestDone(req->curl, req->headers, res, req->response);
+   req->curl = NULL;
+   req->headers = NULL;
+   finishRequest(req, rfcHostifResultFromCurl(res));
+}
+
+/**
+ * @brief Worker thread body.
+ *
+ * Picks up submitted requests, drives all transfers on the multi handle and
+ * completes them as they finish. Sleeps on the wake fd when idle.
+ */
+static void asyncLoop()
+{
+   std::map<CURL *, AsyncRequestPtr> inflight;
+   for (;;)
+   {
+      std::deque<AsyncRequestPtr> batch;
+      std::vector<AsyncRequestPtr> cancelledTransfers;
+      {
+         std::lock_guard<std::mutex> lock(asyncMutex);
+         batch.swap(submitted);
+         for (std::map<CURL *, AsyncRequestPtr>::iterator it = inflight.begin(); it != inflight.end(); ++it)
+         {
+            if (it->second->cancelled)
+               cancelledTransfers.push_back(it->second);
+         }
+      }
+
+      for (size_t i = 0; i < cancelledTransfers.size(); i++)
+      {
+         const AsyncRequestPtr &req = cancelledTransfers[i];
+         inflight.erase(req->curl);
+         curl_multi_remove_handle(multiHandle, req->curl);
+         rfcHostifRequestDone(req->curl, req->headers, CURLE_ABORTED_BY_CALLBACK, req->response);
+         req->curl = NULL;
+      }
+
+      for (size_t i = 0; i < batch.size(); i++)
+      {
+         const AsyncRequestPtr &req = batch[i];
+         {
+            std::lock_guard<std::mutex> lock(asyncMutex);
+            if (req->cancelled)
+               continue;
+         }
+         if (startRequest(req) && addTransfer(req))
+            inflight[req->curl] = req;
+         else
+            completeRequest(req);
+      }
+
+      if (inflight.empty())
+      {
+         bool idle;
+         {
+            std::lock_guard<std::mutex> lock(asyncMutex);
+            idle = submitted.empty();
+         }
+         if (idle)
+         {
+            struct pollfd pfd = { wakeFd, POLLIN, 0 };
+            while (poll(&pfd, 1, -1) < 0 && errno == EINTR)
+               ;
+         }
+         drainFd(wakeFd);
+         continue;
+      }
+
+      int running = 0;
+      curl_multi_perform(multiHandle, &running);
+
+      CURLMsg *msg;
+      int queued = 0;
+      while ((msg = curl_multi_info_read(multiHandle, &queued)) != NULL)
+      {
+         if (msg->msg != CURLMSG_DONE)
+            continue;
+         CURL *curl = msg->easy_handle;
+         CURLcode res = msg->data.result;
+         std::map<CURL *, AsyncRequestPtr>::iterator it = inflight.find(curl);
+         if (it == inflight.end())
+            continue;
+         AsyncRequestPtr req = it->second;
+         inflight.erase(it);
+         curl_multi_remove_handle(multiHandle, curl);
+         if (req->viaSocket && res == CURLE_COULDNT_CONNECT)
+         {
+            // Nothing reached hostif, so the request can be repeated over TCP.
+            rfcHostifRequestDone(req->curl, req->headers, res, req->response);
+            rfcTransportSocketFailed();
+            req->response.clear();
+            if (addTransfer(req))
+               inflight[req->curl] = req;
+            else
+               completeRequest(req);
+            continue;
+         }
+         finishTransfer(req, res);
+         completeRequest(req);
+      }
+
+      if (!inflight.empty())
+      {
+         struct curl_waitfd extra;
+         extra.fd = wakeFd;
+         extra.events = CURL_WAIT_POLLIN;
+         extra.revents = 0;
+         curl_multi_wait(multiHandle, &extra, 1, ASYNC_WAIT_INTERVAL, NULL);
+         if (extra.revents)
+            drainFd(wakeFd);
+      }
+   }
+}
+#else
+/**
+ * @brief Worker thread body.
+ *
+ * Picks up submitted requests and sends them one after another on the
+ * worker's hostif connection. A request cancelled while it is being sent
+ * still runs to the end, but its completion is dropped. Sleeps on the wake
+ * fd when idle.
+ */
+static void asyncLoop()
+{
+   for (;;)
+   {
+      std::deque<AsyncRequestPtr> batch;
+      {
+         std::lock_guard<std::mutex> lock(asyncMutex);
+         batch.swap(submitted);
+      }
+      if (batch.empty())
+      {
+         struct pollfd pfd = { wakeFd, POLLIN, 0 };
+         while (poll(&pfd, 1, -1) < 0 && errno == EINTR)
+            ;
+         drainFd(wakeFd);
+         continue;
+      }
+
+      for (size_t i = 0; i < batch.size(); i++)
+      {
+         const AsyncRequestPtr &req = batch[i];
+         {
+            std::lock_guard<std::mutex> lock(asyncMutex);
+            if (req->cancelled)
+               continue;
+         }
+         if (startRequest(req))
+            finishRequest(req, rfcHttpRequest(req->callerID.c_str(), req->body, req->isSet, &req->response, 0));
+         completeRequest(req);
+      }
+   }
+}
+#endif
+
+/* Threads do not survive fork(): the child must not inherit a held lock. */
+static void prepareFork()
+{
+   startMutex.lock();
+   asyncMutex.lock();
+}
+
+static void afterFork()
+{
+   asyncMutex.unlock();
+   startMutex.unlock();
+}
+
+/**
+ * @brief Drop what a forked child inherited from the parent's worker. Caller holds startMutex.
+ *
+ * The queued requests and their completions belong to the parent, and the
+ * eventfds are shared with it. The parent's multi handle still holds its
+ * transfers, so it is abandoned rather than cleaned up.
+ */
+static void resetAfterFork()
+{
+   {
+      std::lock_guard<std::mutex> lock(asyncMutex);
+      submitted.clear();
+      completed.clear();
+      live.clear();
+   }
+   if (wakeFd >= 0)
+      close(wakeFd);
+   if (completionFd >= 0)
+      close(completionFd);
+   wakeFd = -1;
+   completionFd = -1;
+#ifndef RFCAPI_LITE_CLIENT
+   multiHandle = NULL;
+#endif
+   // Completions run on the worker until the child asks for its own completion fd.
+   fdMode.store(false, std::memory_order_release);
+   asyncStarted = false;
+}
+
+/** @brief Create the multi handle, the eventfds and the worker thread. Caller holds startMutex. */
+static bool startWorker()
+{
+#ifndef RFCAPI_LITE_CLIENT
+   rfcCurlGlobalInit();
+   multiHandle = curl_multi_init();
+   if (multiHandle == NULL)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "asyncStart: curl multi setup failed\n");
+      return false;
+   }
+#endif
+   wakeFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+   completionFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+   if (wakeFd < 0 || completionFd < 0)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "asyncStart: eventfd setup failed, errno=%d\n", errno);
+      return false;
+   }
+   try
+   {
+      std::thread(asyncLoop).detach();
+   }
+   catch (const std::exception &e)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "asyncStart: failed to start worker thread: %s\n", e.what());
+      return false;
+   }
+   return true;
+}
+
+/** @brief Whether this process started the worker, rather than inheriting it from its parent. */
+static bool ownWorker()
+{
+   return asyncPid.load(std::memory_order_acquire) == getpid() && asyncStarted;
+}
+
+/**
+ * @brief Start the worker on first use in this process.
+ *
+ * A failure is not retried in the same process. A forked child starts a worker of its own.
+ */
+static bool asyncStart()
+{
+   pid_t pid = getpid();
+   if (asyncPid.load(std::memory_order_acquire) == pid)
+      return asyncStarted;
+   std::lock_guard<std::mutex> lock(startMutex);
+   pid_t owner = asyncPid.load(std::memory_order_relaxed);
+   if (owner == pid)
+      return asyncStarted;
+   if (owner == 0)
+      pthread_atfork(prepareFork, afterFork, afterFork);
+   else
+   {
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "asyncStart: forked from %d, starting a new worker\n", (int)owner);
+      resetAfterFork();
+   }
+   asyncStarted = startWorker();
+   asyncPid.store(pid, std::memory_order_release);
+   return asyncStarted;
+}
+
+static RFC_AsyncHandle_t submitRequest(const AsyncRequestPtr &req)
+{
+   if (!asyncStart())
+      return 0;
+   req->handle = nextHandle.fetch_add(1, std::memory_order_relaxed);
+   {
+      std::lock_guard<std::mutex> lock(asyncMutex);
+      live[req->handle] = req;
+      submitted.push_back(req);
+   }
+   signalFd(wakeFd);
+   return req->handle;
+}
+
+static AsyncRequestPtr newRequest(const char *pcCallerID, const char *pcParameterName, bool isSet)
+{
+   AsyncRequestPtr req = std::make_shared<AsyncRequest>();
+   req->handle = 0;
+   req->isSet = isSet;
+   req->cancelled = false;
+   req->callerID = pcCallerID ? pcCallerID : "Unknown";
+   req->name = pcParameterName;
+   req->type = WDMP_NONE;
+   req->getCallback = NULL;
+   req->setCallback = NULL;
+   req->userData = NULL;
+#ifndef RFCAPI_LITE_CLIENT
+   req->curl = NULL;
+   req->headers = NULL;
+   req->viaSocket = false;
+#endif
+   req->generation = 0;
+   req->status = WDMP_FAILURE;
+   memset(&req->param, 0, sizeof(req->param));
+   req->statsSource = RFC_STATS_FROM_MEMORY;
+   if (rfcStatsEnabled())
+      req->started = std::chrono::steady_clock::now();
+   return req;
+}
+
+RFC_AsyncHandle_t getRFCParameterAsync(const char *pcCallerID, const char *pcParameterName, RFC_GetCompletion_t callback, void *userData)
+{
+   if (pcParameterName == NULL || *pcParameterName == '\0' || callback == NULL)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: invalid arguments\n", __FUNCTION__);
+      return 0;
+   }
+   AsyncRequestPtr req = newRequest(pcCallerID, pcParameterName, false);
+   req->getCallback = callback;
+   req->userData = userData;
+   return submitRequest(req);
+}
+
+RFC_AsyncHandle_t setRFCParameterAsync(const char *pcCallerID, const char *pcParameterName, const char *pcParameterValue, DATA_TYPE eDataType, RFC_SetCompletion_t callback, void *userData)
+{
+   if (pcParameterName == NULL || *pcParameterName == '\0' || pcParameterValue == NULL)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: invalid arguments\n", __FUNCTION__);
+      return 0;
+   }
+   AsyncRequestPtr req = newRequest(pcCallerID, pcParameterName, true);
+   req->value = pcParameterValue;
+   req->type = eDataType;
+   req->setCallback = callback;
+   req->userData = userData;
+   return submitRequest(req);
+}
+
+int getRFCAsyncFd(void)
+{
+   if (!asyncStart())
+      return -1;
+   fdMode.store(true, std::memory_order_release);
+   return completionFd;
+}
+
+size_t dispatchRFCAsync(void)
+{
+   // A forked child must not run, or steal the wakeup of, its parent's completions.
+   if (!ownWorker() || completionFd < 0)
+      return 0;
+
+   // Drain before taking the queue so a completion queued in between re-signals the fd.
+   drainFd(completionFd);
+   std::deque<AsyncRequestPtr> ready;
+   {
+      std::lock_guard<std::mutex> lock(asyncMutex);
+      ready.swap(completed);
+   }
+
+   size_t dispatched = 0;
+   for (size_t i = 0; i < ready.size(); i++)
+   {
+      {
+         std::lock_guard<std::mutex> lock(asyncMutex);
+         if (ready[i]->cancelled)
+            continue;
+         live.erase(ready[i]->handle);
+      }
+      invokeCompletion(ready[i]);
+      dispatched++;
+   }
+   return dispatched;
+}
+
+bool cancelRFCAsync(RFC_AsyncHandle_t handle)
+{
+   if (!ownWorker())
+      return false;
+   std::unique_lock<std::mutex> lock(asyncMutex);
+   std::map<RFC_AsyncHandle_t, AsyncRequestPtr>::iterator it = live.find(handle);
+   if (it == live.end())
+      return false;
+   it->second->cancelled = true;
+   live.erase(it);
+   lock.unlock();
+   signalFd(wakeFd);
+   return true;
+}
@@ -0,0 +1,279 @@
+/**
+ * @file rfcapi_cache.cpp
+ * @brief Opt-in, thread-safe cache of hostif getRFCParameter() responses.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include "rfcapi_cache.h"
+#include "rfcapi_watch.h"
+#include "rfcapi_internal.h"
+#include "rdk_debug.h"
+using namespace std;
+
+#define RFC_CACHE_TTL_ENV "RFC_CACHE_TTL_MS"
+#define RFC_NEGATIVE_CACHE_TTL_ENV "RFC_NEGATIVE_CACHE_TTL_MS"
+#define RFC_CACHE_MAX_ENTRIES 512
+#define RFC_CACHE_MAX_NEGATIVE 256   /**< Negative entries, counted within RFC_CACHE_MAX_ENTRIES. */
+
+typedef chrono::steady_clock CacheClock;
+
+struct CacheEntry
+{
+   string value;
+   DATA_TYPE type;
+   WDMP_STATUS status;
+   CacheClock::time_point expiry;
+   bool negative;   /**< Unknown or empty parameter; kept under negativeTTL. */
+};
+
+static mutex cacheMutex;
+static unordered_map<string, CacheEntry> cacheEntries;
+static unsigned long cacheGeneration = 0;
+static size_t negativeEntries = 0;   /**< Entries with negative set; guarded by cacheMutex. */
+
+static atomic<unsigned int> cacheTTL(0);
+static atomic<unsigned int> negativeTTL(0);
+static atomic<unsigned long> cacheHits(0);
+static atomic<unsigned long> cacheMisses(0);
+static atomic<unsigned long> cacheInvalidations(0);
+static once_flag cacheEnvOnce;
+
+/** @brief Apply @p name to @p ttl unless it was already set through the API. */
+static void readTTLEnv(const char *name, atomic<unsigned int> &ttl)
+{
+   const char *env = getenv(name);
+   if (env && *env && ttl.load() == 0)
+   {
+      unsigned long value = strtoul(env, NULL, 10);
+      if (value > 0)
+      {
+         ttl.store((unsigned int)value);
+         rfcWatchStart();
+         RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: enabled from %s, ttl=%lu ms\n", __FUNCTION__, name, value);
+      }
+   }
+}
+
+/** @brief Apply RFC_CACHE_TTL_MS and RFC_NEGATIVE_CACHE_TTL_MS unless the TTLs were already set. */
+static void readCacheEnv()
+{
+   call_once(cacheEnvOnce, []() {
+      readTTLEnv(RFC_CACHE_TTL_ENV, cacheTTL);
+      readTTLEnv(RFC_NEGATIVE_CACHE_TTL_ENV, negativeTTL);
+   });
+}
+
+/** @brief Whether a hostif status means the parameter is unknown or has no value. */
+static bool isNegativeStatus(WDMP_STATUS status)
+{
+   return status == WDMP_ERR_INVALID_PARAMETER_NAME || status == WDMP_ERR_NOT_EXIST || status == WDMP_ERR_VALUE_IS_EMPTY;
+}
+
+/** @brief Erase @p it, keeping negativeEntries in step. Caller holds cacheMutex. */
+static unordered_map<string, CacheEntry>::iterator eraseLocked(unordered_map<string, CacheEntry>::iterator it)
+{
+   if (it->second.negative)
+      negativeEntries--;
+   return cacheEntries.erase(it);
+}
+
+/** @brief Drop every entry. Caller holds cacheMutex. */
+static void clearLocked()
+{
+   cacheEntries.clear();
+   negativeEntries = 0;
+}
+
+/** @brief Drop everything if the store changed since the entries were taken. Caller holds cacheMutex. */
+static void syncGenerationLocked()
+{
+   unsigned long generation = rfcStoreGeneration();
+   if (generation != cacheGeneration)
+   {
+      if (!cacheEntries.empty())
+         cacheInvalidations++;
+      clearLocked();
+      cacheGeneration = generation;
+   }
+}
+
+bool rfcCacheEnabled()
+{
+   readCacheEnv();
+   return cacheTTL.load(memory_order_relaxed) != 0 || negativeTTL.load(memory_order_relaxed) != 0;
+}
+
+bool rfcCacheLookupValue(const char *name, char *value, size_t capacity, size_t *length, DATA_TYPE *type, WDMP_STATUS *status)
+{
+   if (!rfcCacheEnabled())
+      return false;
+
+   if (!rfcWatchArmed())
+   {
+      cacheMisses++;
+      return false;
+   }
+
+   // Reused per thread, so a hit does not allocate a key.
+   static thread_local string key;
+   key.assign(name);
+
+   lock_guard<mutex> lock(cacheMutex);
+   syncGenerationLocked();
+
+   unordered_map<string, CacheEntry>::iterator it = cacheEntries.find(key);
+   if (it == cacheEntries.end())
+   {
+      cacheMisses++;
+      return false;
+   }
+   if (CacheClock::now() >= it->second.expiry)
+   {
+      eraseLocked(it);
+      cacheMisses++;
+      return false;
+   }
+
+   *length = rfcCopyValue(value, capacity, it->second.value.data(), it->second.value.size());
+   *type = it->second.type;
+   *status = it->second.status;
+   cacheHits++;
+   return true;
+}
+
+void rfcCacheStoreValue(const char *name, const char *value, DATA_TYPE type, WDMP_STATUS status, unsigned long generation)
+{
+   bool negative = isNegativeStatus(status);
+   if (!negative && status != WDMP_SUCCESS && status != WDMP_ERR_DEFAULT_VALUE)
+      return;
+   unsigned int ttl = negative ? negativeTTL.load(memory_order_relaxed) : cacheTTL.load(memory_order_relaxed);
+   if (ttl == 0 || !rfcWatchArmed())
+      return;
+
+   lock_guard<mutex> lock(cacheMutex);
+   syncGenerationLocked();
+   if (generation != cacheGeneration)
+      return;
+
+   CacheClock::time_point now = CacheClock::now();
+   unordered_map<string, CacheEntry>::iterator existing = cacheEntries.find(name);
+   if (existing == cacheEntries.end() &&
+       (cacheEntries.size() >= RFC_CACHE_MAX_ENTRIES || (negative && negativeEntries >= RFC_CACHE_MAX_NEGATIVE)))
+   {
+      for (unordered_map<string, CacheEntry>::iterator it = cacheEntries.begin(); it != cacheEntries.end(); )
+      {
+         if (now >= it->second.expiry)
+            it = eraseLocked(it);
+         else
+            ++it;
+      }
+      // Names polled once and never again must not crowd out real values.
+      if (cacheEntries.size() >= RFC_CACHE_MAX_ENTRIES || (negative && negativeEntries >= RFC_CACHE_MAX_NEGATIVE))
+         return;
+   }
+
+   // emplace() may rehash, so only the iterator it returns is valid here.
+   pair<unordered_map<string, CacheEntry>::iterator, bool> slot = cacheEntries.emplace(name, CacheEntry());
+   CacheEntry &entry = slot.first->second;
+   if (!slot.second && entry.negative)
+      negativeEntries--;
+   if (negative)
+      negativeEntries++;
+   entry.value = value;
+   entry.type = type;
+   entry.status = status;
+   entry.negative = negative;
+   entry.expiry = now + chrono::milliseconds(ttl);
+}
+
+void rfcCacheStore(const char *name, const RFC_ParamData_t *pstParam, WDMP_STATUS status, unsigned long generation)
+{
+   // hostif may answer with a different name (e.g. an alias); only cache exact matches.
+   if (strcmp(pstParam->name, name) != 0)
+      return;
+   rfcCacheStoreValue(name, pstParam->value, pstParam->type, status, generation);
+}
+
+void setRFCCacheTTL(unsigned int ttlMs)
+{
+   readCacheEnv();
+   cacheTTL.store(ttlMs);
+   if (ttlMs)
+   {
+      rfcWatchStart();
+   }
+   else
+   {
+      lock_guard<mutex> lock(cacheMutex);
+      for (unordered_map<string, CacheEntry>::iterator it = cacheEntries.begin(); it != cacheEntries.end(); )
+      {
+         if (!it->second.negative)
+            it = eraseLocked(it);
+         else
+            ++it;
+      }
+   }
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: parameter cache ttl=%u ms\n", __FUNCTION__, ttlMs);
+}
+
+void setRFCNegativeCacheTTL(unsigned int ttlMs)
+{
+   readCacheEnv();
+   negativeTTL.store(ttlMs);
+   if (ttlMs)
+   {
+      rfcWatchStart();
+   }
+   else
+   {
+      lock_guard<mutex> lock(cacheMutex);
+      for (unordered_map<string, CacheEntry>::iterator it = cacheEntries.begin(); it != cacheEntries.end(); )
+      {
+         if (it->second.negative)
+            it = eraseLocked(it);
+         else
+            ++it;
+      }
+   }
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: negative cache ttl=%u ms\n", __FUNCTION__, ttlMs);
+}
+
+void getRFCCacheStats(RFC_CacheStats_t *pstStats)
+{
+   if (pstStats == NULL)
+      return;
+   pstStats->hits = cacheHits.load();
+   pstStats->misses = cacheMisses.load();
+   pstStats->invalidations = cacheInvalidations.load();
+   lock_guard<mutex> lock(cacheMutex);
+   pstStats->entries = cacheEntries.size();
+}
+
+void clearRFCCache(void)
+{
+   rfcStoreChanged();
+   lock_guard<mutex> lock(cacheMutex);
+   clearLocked();
+}
@@ -0,0 +1,64 @@
+/**
+ * @file rfcapi_cache.h
+ * @brief Internal in-process parameter cache for getRFCParameter().
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_CACHE_H_
+#define RFCAPI_CACHE_H_
+
+#include "rfcapi.h"
+
+/**
+ * @brief Whether the cache is enabled (non-zero TTL for values or for negative results).
+ *
+ * Reads RFC_CACHE_TTL_MS and RFC_NEGATIVE_CACHE_TTL_MS from the environment on first use.
+ */
+bool rfcCacheEnabled();
+
+/**
+ * @brief Serve a parameter value from the cache into a caller buffer.
+ * @param[in]  name      TR181 parameter name.
+ * @param[out] value     Cached value, NUL-terminated and truncated to @p capacity.
+ * @param[in]  capacity  Size of @p value.
+ * @param[out] length    Full length of the cached value, excluding the NUL.
+ * @param[out] type      Cached data type.
+ * @param[out] status    Status the cached hostif response carried.
+ * @retval true  Cache hit; the outputs are valid.
+ * @retval false Miss, expired, invalidated or cache disabled.
+ */
+bool rfcCacheLookupValue(const char *name, char *value, size_t capacity, size_t *length, DATA_TYPE *type, WDMP_STATUS *status);
+
+/**
+ * @brief Remember a hostif response.
+ * @param[in] name       TR181 parameter name.
+ * @param[in] pstParam   Value returned by hostif.
+ * @param[in] status     Status returned by hostif.
+ * @param[in] generation Store generation sampled before the request was sent;
+ *                       the entry is dropped if the store changed meanwhile.
+ */
+void rfcCacheStore(const char *name, const RFC_ParamData_t *pstParam, WDMP_STATUS status, unsigned long generation);
+
+/**
+ * @brief Remember a hostif response already known to be for @p name.
+ * @see rfcCacheStore()
+ */
+void rfcCacheStoreValue(const char *name, const char *value, DATA_TYPE type, WDMP_STATUS status, unsigned long generation);
+
+#endif
@@ -0,0 +1,496 @@
+/**
+ * @file rfcapi_defaults.cpp
+ * @brief Compiles /etc/rfcdefaults into a sorted binary snapshot and maps it.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rfcapi_defaults.h"
+#include "rfcapi_internal.h"
+#include "rdk_debug.h"
+using namespace std;
+
+/*
+ * Snapshot layout, a mapped table (rfcapi_internal.h) without a hash index:
+ *
+ *   DefaultsHeader
+ *   DefaultsComponent[componentCount]   source files, in sorted name order
+ *   DefaultsRecord[recordCount]         sorted by name, then component
+ *   string blob                         names and values, not NUL-terminated
+ */
+#define DEFAULTS_MAGIC    "RFCD"
+#define DEFAULTS_VERSION  2
+/** @brief Milliseconds before retrying a compile that failed while its sources stayed the same. */
+#define DEFAULTS_RETRY_INTERVAL 60000
+
+struct DefaultsHeader
+{
+   RfcTableHeader table;
+   uint32_t componentCount;
+   uint32_t reserved;
+   int64_t dirMtimeSec;      /**< RFCDEFAULTS_ETC_DIR mtime when compiled. */
+   int64_t dirMtimeNsec;
+};
+
+struct DefaultsComponent
+{
+   uint32_t nameOffset;      /**< Source file name, e.g. "rfcdefaults.ini"; from the start of the file. */
+   uint32_t nameLen;
+   int64_t size;
+   int64_t mtimeSec;
+   int64_t mtimeNsec;
+};
+
+struct DefaultsRecord
+{
+   RfcTableRecord text;
+   uint32_t component;
+};
+
+/** Record under construction; name/value still refer to the source buffer. */
+struct PendingRecord
+{
+   string name;
+   string value;
+   uint32_t component;
+};
+
+static bool pendingLess(const PendingRecord &a, const PendingRecord &b)
+{
+   return a.name < b.name;
+}
+
+bool rfcPublishFile(const char *path, const string &data)
+{
+   string tmpl = string(path) + ".XXXXXX";
+   vector<char> tmpPath(tmpl.begin(), tmpl.end());
+   tmpPath.push_back('\0');
+   int fd = mkstemp(&tmpPath[0]);
+   if (fd < 0)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot create temp file for %s: %s\n", __FUNCTION__, path, strerror(errno));
+      return false;
+   }
+   fchmod(fd, 0644);
+
+   bool ok = rfcWriteAll(fd, data);
+   if (close(fd) != 0)
+      ok = false;
+   if (ok && rename(&tmpPath[0], path) != 0)
+      ok = false;
+   if (!ok)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot write %s: %s\n", __FUNCTION__, path, strerror(errno));
+      unlink(&tmpPath[0]);
+   }
+   return ok;
+}
+
+static uint32_t appendString(string &blob, const char *str, size_t len)
+{
+   uint32_t offset = (uint32_t)blob.size();
+   blob.append(str, len);
+   return offset;
+}
+
+/** @brief Whether rfcDefaultsCompile() reads @p fileName, a directory entry of the sources directory. */
+static bool isDefaultsSource(const char *fileName)
+{
+   return strchr(fileName, '/') == NULL && strstr(fileName, ".ini") != NULL;
+}
+
+bool rfcDefaultsCompile(const char *etcDir, const char *snapshotPath, const char *iniPath, string *pImage)
+{
+   // Stamp the directory before reading it, so a file added meanwhile makes the result stale.
+   struct stat dirStat;
+   DIR *dir = opendir(etcDir);
+   if (dir == NULL || fstat(dirfd(dir), &dirStat) != 0)
+   {
+      RDK_LOG (RDK_LOG_ERROR, LOG_RFCAPI,"Could not open dir %s \n", etcDir) ;
+      if (dir != NULL)
+         closedir(dir);
+      return false;
+   }
+   vector<string> files;
+   struct dirent *ent;
+   while ((ent = readdir(dir)) != NULL)
+   {
+      if (isDefaultsSource(ent->d_name))
+         files.push_back(ent->d_name);
+   }
+   closedir(dir);
+   // Sorted, so a name defined by several features always resolves to the same file.
+   sort(files.begin(), files.end());
+
+   string merged;
+   string blob;
+   vector<DefaultsComponent> components;
+   vector<PendingRecord> pending;
+   for (size_t i = 0; i < files.size(); i++)
+   {
+      RDK_LOG (RDK_LOG_DEBUG, LOG_RFCAPI,"rfcdefaults file: %s\n", files[i].c_str());
+      string path = string(etcDir) + files[i];
+      string content;
+      struct stat st;
+      DefaultsComponent component;
+      memset(&component, 0, sizeof(component));
+      component.nameOffset = appendString(blob, files[i].data(), files[i].size());
+      component.nameLen = (uint32_t)files[i].size();
+      if (stat(path.c_str(), &st) == 0)
+      {
+         component.size = st.st_size;
+         component.mtimeSec = st.st_mtim.tv_sec;
+         component.mtimeNsec = st.st_mtim.tv_nsec;
+      }
+      // A component is recorded even if unreadable, so it is not recompiled on every lookup.
+      components.push_back(component);
+      if (!rfcReadFile(path.c_str(), content))
+      {
+         RDK_LOG (RDK_LOG_ERROR, LOG_RFCAPI,"Could not read %s \n", path.c_str());
+         continue;
+      }
+      merged += content;
+      merged += "\n";
+
+      unordered_set<string> seen;
+      size_t pos = 0;
+      while (pos < content.size())
+      {
+         size_t eol = content.find('\n', pos);
+         if (eol == string::npos)
+            eol = content.size();
+         size_t eq = content.find('=', pos);
+         if (eq < eol)
+         {
+            size_t start = pos;
+            size_t ws = content.find_first_of(" \t", pos);
+            if (ws < eq)
+               start = ws + 1;   // Skip an export word before the key.
+            PendingRecord record;
+            record.name.assign(content, start, eq - start);
+            if (seen.insert(record.name).second)
+            {
+               record.value.assign(content, eq + 1, eol - eq - 1);
+               record.component = (uint32_t)(components.size() - 1);
+               pending.push_back(record);
+            }
+         }
+         pos = eol + 1;
+      }
+   }
+   stable_sort(pending.begin(), pending.end(), pendingLess);
+
+   vector<DefaultsRecord> records(pending.size());
+   for (size_t i = 0; i < pending.size(); i++)
+   {
+      records[i].text.nameOffset = appendString(blob, pending[i].name.data(), pending[i].name.size());
+      records[i].text.nameLen = (uint32_t)pending[i].name.size();
+      records[i].text.valueOffset = appendString(blob, pending[i].value.data(), pending[i].value.size());
+      records[i].text.valueLen = (uint32_t)pending[i].value.size();
+      records[i].component = pending[i].component;
+   }
+
+   DefaultsHeader header;
+   memset(&header, 0, sizeof(header));
+   memcpy(header.table.magic, DEFAULTS_MAGIC, sizeof(header.table.magic));
+   header.table.version = DEFAULTS_VERSION;
+   header.table.recordCount = (uint32_t)records.size();
+   header.table.stringsOffset = (uint32_t)(sizeof(header) + components.size() * sizeof(DefaultsComponent) + records.size() * sizeof(DefaultsRecord));
+   header.table.fileSize = (uint32_t)(header.table.stringsOffset + blob.size());
+   header.componentCount = (uint32_t)components.size();
+   header.dirMtimeSec = dirStat.st_mtim.tv_sec;
+   header.dirMtimeNsec = dirStat.st_mtim.tv_nsec;
+   // Offsets were taken within the blob; the file's are from its start.
+   for (size_t i = 0; i < components.size(); i++)
+      components[i].nameOffset += header.table.stringsOffset;
+   for (size_t i = 0; i < records.size(); i++)
+   {
+      records[i].text.nameOffset += header.table.stringsOffset;
+      records[i].text.valueOffset += header.table.stringsOffset;
+   }
+
+   string image;
+   image.reserve(header.table.fileSize);
+   image.append((const char *)&header, sizeof(header));
+   if (!components.empty())
+      image.append((const char *)&components[0], components.size() * sizeof(DefaultsComponent));
+   if (!records.empty())
+      image.append((const char *)&records[0], records.size() * sizeof(DefaultsRecord));
+   image += blob;
+
+   bool ok = rfcPublishFile(iniPath, merged);
+   // Readers only map a snapshot root published, so nobody else needs to try.
+   if (geteuid() == 0)
+      ok = rfcSnapshotDirSafe() && rfcPublishFile(snapshotPath, image) && ok;
+   RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: compiled %zu defaults from %zu files\n", __FUNCTION__, records.size(), files.size());
+   if (pImage != NULL)
+      pImage->swap(image);
+   return ok;
+}
+
+RfcDefaultsSnapshot::RfcDefaultsSnapshot()
+   : base(NULL), mapSize(0), recordCount(0), componentCount(0), records(NULL), components(NULL),
+     dirMtimeSec(0), dirMtimeNsec(0)
+{
+}
+
+RfcDefaultsSnapshot::~RfcDefaultsSnapshot()
+{
+   if (base != NULL)
+      munmap((void *)base, mapSize);
+}
+
+shared_ptr<const RfcDefaultsSnapshot> RfcDefaultsSnapshot::open(const char *path)
+{
+   // Only a file root published in its own directory is trusted; never follow a planted link.
+   int fd = ::open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+   if (fd < 0)
+      return shared_ptr<const RfcDefaultsSnapshot>();
+   struct stat st;
+   void *map = MAP_FAILED;
+   if (fstat(fd, &st) == 0 && rfcPublishedByRoot(st) && (size_t)st.st_size >= sizeof(DefaultsHeader))
+   {
+      // Snapshots are replaced by rename(), never truncated, so the mapping stays valid.
+      map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+   }
+   close(fd);
+   if (map == MAP_FAILED)
+      return shared_ptr<const RfcDefaultsSnapshot>();
+   return adopt(map, (size_t)st.st_size, path);
+}
+
+shared_ptr<const RfcDefaultsSnapshot> RfcDefaultsSnapshot::fromImage(const string &image)
+{
+   if (image.size() < sizeof(DefaultsHeader))
+      return shared_ptr<const RfcDefaultsSnapshot>();
+   void *map = mmap(NULL, image.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+   if (map == MAP_FAILED)
+      return shared_ptr<const RfcDefaultsSnapshot>();
+   memcpy(map, image.data(), image.size());
+   mprotect(map, image.size(), PROT_READ);
+   return adopt(map, image.size(), "compiled defaults");
+}
+
+shared_ptr<const RfcDefaultsSnapshot> RfcDefaultsSnapshot::adopt(void *map, size_t size, const char *what)
+{
+   shared_ptr<RfcDefaultsSnapshot> snapshot(new RfcDefaultsSnapshot());
+   snapshot->base = (const unsigned char *)map;
+   snapshot->mapSize = size;
+
+   const DefaultsHeader *header = (const DefaultsHeader *)map;
+   uint64_t recordsOffset = sizeof(DefaultsHeader) + (uint64_t)header->componentCount * sizeof(DefaultsComponent);
+   bool ok = rfcTableValid(map, snapshot->mapSize, DEFAULTS_MAGIC, DEFAULTS_VERSION, recordsOffset, sizeof(DefaultsRecord), false);
+   if (ok)
+   {
+      snapshot->componentCount = header->componentCount;
+      snapshot->recordCount = header->table.recordCount;
+      snapshot->components = (const DefaultsComponent *)(snapshot->base + sizeof(DefaultsHeader));
+      snapshot->records = (const DefaultsRecord *)(snapshot->base + recordsOffset);
+      snapshot->dirMtimeSec = header->dirMtimeSec;
+      snapshot->dirMtimeNsec = header->dirMtimeNsec;
+      for (size_t i = 0; ok && i < snapshot->componentCount; i++)
+      {
+         const DefaultsComponent &c = snapshot->components[i];
+         ok = c.nameOffset >= header->table.stringsOffset && (uint64_t)c.nameOffset + c.nameLen <= snapshot->mapSize;
+      }
+      for (size_t i = 0; ok && i < snapshot->recordCount; i++)
+         ok = snapshot->records[i].component < snapshot->componentCount;
+   }
+   if (!ok)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: ignoring malformed %s\n", __FUNCTION__, what);
+      return shared_ptr<const RfcDefaultsSnapshot>();
+   }
+   return snapshot;
+}
+
+void RfcDefaultsSnapshot::record(size_t i, const char **name, size_t *nameLen, const char **value, size_t *valueLen) const
+{
+   *name = text(records[i].text.nameOffset);
+   *nameLen = records[i].text.nameLen;
+   *value = text(records[i].text.valueOffset);
+   *valueLen = records[i].text.valueLen;
+}
+
+static int compareName(const char *a, size_t aLen, const char *b, size_t bLen)
+{
+   int c = memcmp(a, b, min(aLen, bLen));
+   if (c != 0)
+      return c;
+   return aLen < bLen ? -1 : (aLen > bLen ? 1 : 0);
+}
+
+bool RfcDefaultsSnapshot::isWinner(size_t i) const
+{
+   return i == 0 || compareName(text(records[i - 1].text.nameOffset), records[i - 1].text.nameLen,
+                                text(records[i].text.nameOffset), records[i].text.nameLen) != 0;
+}
+
+long RfcDefaultsSnapshot::find(const char *name, const char *componentFile) const
+{
+   size_t len = strlen(name);
+   size_t lo = 0, hi = recordCount;
+   while (lo < hi)
+   {
+      size_t mid = lo + (hi - lo) / 2;
+      if (compareName(text(records[mid].text.nameOffset), records[mid].text.nameLen, name, len) < 0)
+         lo = mid + 1;
+      else
+         hi = mid;
+   }
+   size_t fileLen = componentFile ? strlen(componentFile) : 0;
+   for (size_t i = lo; i < recordCount && compareName(text(records[i].text.nameOffset), records[i].text.nameLen, name, len) == 0; i++)
+   {
+      if (componentFile == NULL)
+         return (long)i;
+      const DefaultsComponent &c = components[records[i].component];
+      if (compareName(text(c.nameOffset), c.nameLen, componentFile, fileLen) == 0)
+         return (long)i;
+   }
+   return -1;
+}
+
+bool RfcDefaultsSnapshot::hasComponent(const char *componentFile) const
+{
+   size_t len = strlen(componentFile);
+   for (size_t i = 0; i < componentCount; i++)
+   {
+      if (compareName(text(components[i].nameOffset), components[i].nameLen, componentFile, len) == 0)
+         return true;
+   }
+   return false;
+}
+
+bool RfcDefaultsSnapshot::isStale(const char *etcDir, const char *componentFile) const
+{
+   struct stat st;
+   // Without the sources there is nothing better to compile, keep what we have.
+   if (stat(etcDir, &st) != 0)
+      return false;
+   if (st.st_mtim.tv_sec != dirMtimeSec || st.st_mtim.tv_nsec != dirMtimeNsec)
+      return true;
+   // A file the compiler skips can never be in the snapshot, so its presence changes nothing.
+   if (componentFile == NULL || !isDefaultsSource(componentFile))
+      return false;
+
+   string path = string(etcDir) + componentFile;
+   bool exists = stat(path.c_str(), &st) == 0;
+   size_t len = strlen(componentFile);
+   for (size_t i = 0; i < componentCount; i++)
+   {
+      const DefaultsComponent &c = components[i];
+      if (compareName(text(c.nameOffset), c.nameLen, componentFile, len) == 0)
+         return !exists || st.st_size != c.size || st.st_mtim.tv_sec != c.mtimeSec || st.st_mtim.tv_nsec != c.mtimeNsec;
+   }
+   return exists;
+}
+
+static mutex defaultsMutex;
+static shared_ptr<const RfcDefaultsSnapshot> currentSnapshot;
+static bool currentPublished = false;   /**< currentSnapshot maps RFCDEFAULTS_SNAPSHOT_FILE rather than a private copy. */
+static struct stat publishedStat;       /**< RFCDEFAULTS_SNAPSHOT_FILE when last looked at, trusted or not. */
+static bool compileFailed = false;      /**< The last compile produced no snapshot. */
+static struct stat failedDirStat;       /**< RFCDEFAULTS_ETC_DIR when it failed, zeroed if missing. */
+static chrono::steady_clock::time_point retryAt;
+
+/** @brief Stat @p dir, zeroing @p st if it is missing. */
+static void statDir(const char *dir, struct stat &st)
+{
+   if (stat(dir, &st) != 0)
+      memset(&st, 0, sizeof(st));
+}
+
+/** @brief Whether a compile may run: the last one worked, its sources changed, or the backoff passed. */
+static bool mayCompileLocked()
+{
+   if (!compileFailed || chrono::steady_clock::now() >= retryAt)
+      return true;
+   struct stat st;
+   statDir(RFCDEFAULTS_ETC_DIR, st);
+   return st.st_dev != failedDirStat.st_dev || st.st_ino != failedDirStat.st_ino ||
+          st.st_mtim.tv_sec != failedDirStat.st_mtim.tv_sec || st.st_mtim.tv_nsec != failedDirStat.st_mtim.tv_nsec;
+}
+
+/** @brief Compile the sources and keep a private copy of the result. Caller holds defaultsMutex. */
+static void compileLocked()
+{
+   // Stamped first, so a change made while compiling is not mistaken for the failed state.
+   struct stat dirStat;
+   statDir(RFCDEFAULTS_ETC_DIR, dirStat);
+   string image;
+   rfcDefaultsCompile(RFCDEFAULTS_ETC_DIR, RFCDEFAULTS_SNAPSHOT_FILE, RFCDEFAULTS_FILE, &image);
+   // Root has also published it; the next call switches to that mapping, which every process shares.
+   shared_ptr<const RfcDefaultsSnapshot> snapshot = RfcDefaultsSnapshot::fromImage(image);
+   if (!snapshot)
+   {
+      // Rereading every ini file on each lookup cannot help until the directory changes.
+      compileFailed = true;
+      failedDirStat = dirStat;
+      retryAt = chrono::steady_clock::now() + chrono::milliseconds(DEFAULTS_RETRY_INTERVAL);
+      return;
+   }
+   compileFailed = false;
+   currentSnapshot = snapshot;
+   currentPublished = false;
+}
+
+shared_ptr<const RfcDefaultsSnapshot> rfcDefaultsCurrent(const char *componentFile)
+{
+   lock_guard<mutex> lock(defaultsMutex);
+   struct stat st;
+   if (stat(RFCDEFAULTS_SNAPSHOT_FILE, &st) != 0)
+   {
+      memset(&publishedStat, 0, sizeof(publishedStat));
+      if (currentPublished)
+         currentSnapshot.reset();
+   }
+   else if (st.st_dev != publishedStat.st_dev || st.st_ino != publishedStat.st_ino)
+   {
+      // Republished by another process (or us): remap the new inode, if root published it.
+      publishedStat = st;
+      shared_ptr<const RfcDefaultsSnapshot> snapshot = RfcDefaultsSnapshot::open(RFCDEFAULTS_SNAPSHOT_FILE);
+      if (snapshot)
+      {
+         currentSnapshot = snapshot;
+         currentPublished = true;
+      }
+      else
+      {
+         // Not a snapshot root published: compile our own, which as root also replaces it.
+         currentSnapshot.reset();
+      }
+   }
+
+   if ((!currentSnapshot || currentSnapshot->isStale(RFCDEFAULTS_ETC_DIR, componentFile)) && mayCompileLocked())
+      compileLocked();
+   return currentSnapshot;
+}
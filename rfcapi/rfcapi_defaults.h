@@ -0,0 +1,138 @@
+/**
+ * @file rfcapi_defaults.h
+ * @brief Internal compiled (binary, sorted) rfcdefaults snapshot.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_DEFAULTS_H_
+#define RFCAPI_DEFAULTS_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <memory>
+#include <string>
+
+struct DefaultsComponent;
+struct DefaultsRecord;
+
+/**
+ * @brief Compile every ini file in @p etcDir into a snapshot and a merged ini.
+ *
+ * Files are processed in sorted name order. The snapshot keeps every
+ * (name, component) pair sorted by name, then by file order, so the first
+ * record for a name is the deterministic winner. Both outputs are written to
+ * a temporary file and published with rename(), so concurrent readers never
+ * see a partial file. Only root publishes the snapshot, into RFC_SNAPSHOT_DIR:
+ * readers ignore one anybody else could have written.
+ * @param[in]  etcDir        Directory holding the component ini files.
+ * @param[in]  snapshotPath  Binary snapshot to publish.
+ * @param[in]  iniPath       Merged text file to publish (kept for scripts).
+ * @param[out] pImage        Receives the snapshot, even if it was not published; may be NULL.
+ * @retval true   The text file, and as root the snapshot, were published.
+ * @retval false  @p etcDir could not be read (@p pImage is left empty) or an output could not be written.
+ */
+bool rfcDefaultsCompile(const char *etcDir, const char *snapshotPath, const char *iniPath, std::string *pImage = NULL);
+
+/**
+ * @brief Write @p data to a temporary file next to @p path and rename() it into place.
+ * @retval true   @p path now holds @p data.
+ * @retval false  Nothing was replaced.
+ */
+bool rfcPublishFile(const char *path, const std::string &data);
+
+/**
+ * @class RfcDefaultsSnapshot
+ * @brief Read-only mmap of a compiled snapshot.
+ *
+ * Mapping is safe because snapshots are only ever replaced by rename(), never
+ * rewritten in place. Strings are not NUL-terminated.
+ */
+class RfcDefaultsSnapshot
+{
+public:
+   ~RfcDefaultsSnapshot();
+
+   /** @brief Map and validate @p path; returns NULL if missing, malformed or not published by root. */
+   static std::shared_ptr<const RfcDefaultsSnapshot> open(const char *path);
+
+   /** @brief Validate a private copy of a compiled @p image; returns NULL if malformed. */
+   static std::shared_ptr<const RfcDefaultsSnapshot> fromImage(const std::string &image);
+
+   /** @brief Number of records, including names shadowed by an earlier component. */
+   size_t count() const { return recordCount; }
+
+   /** @brief Name/value of record @p i, in sorted order. */
+   void record(size_t i, const char **name, size_t *nameLen, const char **value, size_t *valueLen) const;
+
+   /** @brief Whether record @p i is the winning (first) record for its name. */
+   bool isWinner(size_t i) const;
+
+   /**
+    * @brief Find a record by name.
+    * @param[in] name           Parameter name.
+    * @param[in] componentFile  Restrict to this source file name (e.g. "foo.ini"), or NULL for the winner.
+    * @return Record index, or -1 if not found.
+    */
+   long find(const char *name, const char *componentFile) const;
+
+   /** @brief Whether @p componentFile is one of the snapshot's sources. */
+   bool hasComponent(const char *componentFile) const;
+
+   /**
+    * @brief Whether the sources changed since the snapshot was compiled.
+    * @param[in] etcDir         Source directory (its mtime tracks added/removed files).
+    * @param[in] componentFile  Also compare this file's size/mtime, or NULL.
+    */
+   bool isStale(const char *etcDir, const char *componentFile) const;
+
+private:
+   RfcDefaultsSnapshot();
+   RfcDefaultsSnapshot(const RfcDefaultsSnapshot &);
+   RfcDefaultsSnapshot &operator=(const RfcDefaultsSnapshot &);
+
+   /** @brief Take ownership of @p size mapped bytes and validate them; @p what names them in the log. */
+   static std::shared_ptr<const RfcDefaultsSnapshot> adopt(void *map, size_t size, const char *what);
+
+   /** @brief String at @p offset from the start of the file. */
+   const char *text(uint32_t offset) const { return (const char *)base + offset; }
+
+   const unsigned char *base;
+   size_t mapSize;
+   size_t recordCount;
+   size_t componentCount;
+   const DefaultsRecord *records;
+   const DefaultsComponent *components;
+   int64_t dirMtimeSec;
+   int64_t dirMtimeNsec;
+};
+
+/**
+ * @brief Current snapshot for this process, compiled on first use.
+ *
+ * Revalidated on each call by stat() of the snapshot and of the rfcdefaults
+ * directory; recompiled if missing or stale. A process that cannot publish
+ * (not root) uses a private copy until root publishes a current one. A
+ * compile that yields nothing is retried only once the rfcdefaults directory
+ * changes or DEFAULTS_RETRY_INTERVAL has passed.
+ * @param[in] componentFile  Also revalidate this component's source file, or NULL.
+ * @return Snapshot, or NULL if none could be compiled.
+ */
+std::shared_ptr<const RfcDefaultsSnapshot> rfcDefaultsCurrent(const char *componentFile);
+
+#endif
@@ -0,0 +1,80 @@
+/**
+ * @file rfcapi_features.cpp
+ * @brief In-memory set of enabled RFC features, refreshed by the store watcher.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <dirent.h>
+#include <string.h>
+#include "rfcapi_features.h"
+#include "rfcapi_watch.h"
+#include "rfcapi_internal.h"
+#include "rdk_debug.h"
+
+#define FEATURE_FILE_PREFIX ".RFC_"
+#define FEATURE_FILE_SUFFIX ".ini"
+
+static std::mutex featureMutex;
+static std::unordered_set<std::string> enabledFeatures;
+static unsigned long featureSetGeneration = 0;   /**< Feature generation the set was built at; 0 = never. */
+
+/** @brief Rescan RFC_FEATURE_DIR for .RFC_<feature>.ini markers. Caller holds featureMutex. */
+static void rebuildLocked(unsigned long generation)
+{
+   const size_t prefixLen = strlen(FEATURE_FILE_PREFIX);
+   const size_t suffixLen = strlen(FEATURE_FILE_SUFFIX);
+
+   enabledFeatures.clear();
+   DIR *dir = opendir(RFC_FEATURE_DIR);
+   if (dir != NULL)
+   {
+      struct dirent *ent;
+      while ((ent = readdir(dir)) != NULL)
+      {
+         size_t len = strlen(ent->d_name);
+         if (len > prefixLen + suffixLen && strncmp(ent->d_name, FEATURE_FILE_PREFIX, prefixLen) == 0 &&
+             strcmp(ent->d_name + len - suffixLen, FEATURE_FILE_SUFFIX) == 0)
+         {
+            enabledFeatures.insert(std::string(ent->d_name + prefixLen, len - prefixLen - suffixLen));
+         }
+      }
+      closedir(dir);
+   }
+   featureSetGeneration = generation;
+   RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: %zu features enabled\n", __FUNCTION__, enabledFeatures.size());
+}
+
+bool rfcFeatureLookup(const char *const *features, size_t count, bool *enabled)
+{
+   // Only rides on a watcher something else opted into; isRFCEnabled() alone does not start a thread.
+   if (!rfcWatchArmed())
+      return false;
+
+   // Sampled before the scan, so an update racing with it triggers another one.
+   unsigned long generation = rfcFeatureGeneration();
+   std::lock_guard<std::mutex> lock(featureMutex);
+   if (generation != featureSetGeneration)
+      rebuildLocked(generation);
+   for (size_t i = 0; i < count; i++)
+      enabled[i] = features[i] != NULL && enabledFeatures.count(features[i]) != 0;
+   return true;
+}
@@ -0,0 +1,41 @@
+/**
+ * @file rfcapi_features.h
+ * @brief Internal in-memory set of enabled RFC features used by isRFCEnabled().
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_FEATURES_H_
+#define RFCAPI_FEATURES_H_
+
+#include <stddef.h>
+
+/**
+ * @brief Answer feature checks from the in-memory enabled set.
+ *
+ * The set is built from one scan of RFC_FEATURE_DIR and rebuilt only after
+ * the store watcher reports a change to a .RFC_<feature>.ini file.
+ * @param[in]  features  Array of @p count feature names (NULL entries are disabled).
+ * @param[in]  count     Number of entries.
+ * @param[out] enabled   Per-feature result.
+ * @retval true   @p enabled is valid.
+ * @retval false  Watcher not armed; the caller must check the files itself.
+ */
+bool rfcFeatureLookup(const char *const *features, size_t count, bool *enabled);
+
+#endif
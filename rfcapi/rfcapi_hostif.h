@@ -0,0 +1,164 @@
+/**
+ * @file rfcapi_hostif.h
+ * @brief Internal building blocks of the hostif HTTP transport, shared by the
+ *        blocking and asynchronous parameter calls.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_HOSTIF_H_
+#define RFCAPI_HOSTIF_H_
+
+#include <string>
+#include <vector>
+#ifndef RFCAPI_LITE_CLIENT
+#include <curl/curl.h>
+#endif
+#include "rfcapi.h"
+
+/** @brief Outcome of a hostif request, whichever HTTP client sent it. */
+typedef enum
+{
+   RFC_HOSTIF_OK = 0,        /**< hostif answered; the body is in the response. */
+   RFC_HOSTIF_UNREACHABLE,   /**< Nothing reached hostif (connection refused or no listener). */
+   RFC_HOSTIF_TIMEOUT,       /**< hostif did not answer in time. */
+   RFC_HOSTIF_ERROR          /**< Any other failure. */
+} RfcHostifResult;
+
+/** @brief One entry of the "parameters" array of a hostif answer. */
+struct RfcHostifEntry
+{
+   bool hasName;
+   bool hasValue;
+   bool hasType;
+   bool hasMessage;
+   std::string name;
+   std::string value;
+   std::string message;
+   int dataType;
+};
+
+/** @brief A hostif answer: {"parameters":[{"name","dataType","value","message"}...],"statusCode":N}. */
+struct RfcHostifResponse
+{
+   bool hasStatusCode;
+   int statusCode;
+   std::vector<RfcHostifEntry> parameters;
+};
+
+/**
+ * @brief Parse a hostif answer without a general-purpose JSON library.
+ *
+ * Parser of the curl-free build (rfcapi_json.cpp). Checks the syntax of the whole value but keeps only the members above,
+ * with the answers cJSON gives: member names match case-insensitively and
+ * the first occurrence wins, string members count only when they are JSON
+ * strings, and numbers are truncated to int. Text after the value is ignored.
+ * @param[in]  body    Response body.
+ * @param[in]  length  Length of @p body.
+ * @param[out] parsed  Receives the members found.
+ * @retval false  @p body does not start with a well-formed JSON value.
+ */
+bool rfcHostifParseJson(const char *body, size_t length, RfcHostifResponse *parsed);
+
+/**
+ * @brief Send one JSON request to hostif on the calling thread's persistent connection.
+ *
+ * HTTP client of the curl-free build (rfcapi_http.cpp). Uses the hostif
+ * Unix domain socket when rfcTransportSocket() says so, and
+ * repeats the request over TCP if the socket cannot be connected. A kept-alive
+ * connection that turns out to be closed is reopened once.
+ * @param[in]  pcCallerID  Caller identifier, sent as the CallerID header.
+ * @param[in]  data        JSON request body.
+ * @param[in]  isSet       true for a set (POST), false for a get.
+ * @param[out] response    Response body.
+ * @param[in]  deadlineMs  Bound on the whole request; 0 keeps the default timeouts
+ *                         (5 s to connect and 10 s in all for a get; a set only bounds
+ *                         the connect, to curl's 300 s).
+ */
+RfcHostifResult rfcHttpRequest(const char *pcCallerID, const std::string &data, bool isSet, std::string *response,
+                               unsigned int deadlineMs);
+
+#ifndef RFCAPI_LITE_CLIENT
+/** @brief curl_global_init(), run once per process; call before curl_multi_init(). */
+void rfcCurlGlobalInit();
+
+/** @brief Map a cURL result code onto a hostif request outcome. */
+RfcHostifResult rfcHostifResultFromCurl(CURLcode res);
+
+/**
+ * @brief Create a hostif request handle with the CallerID header, URL, body and timeouts set.
+ * @param[in]  pcCallerID  Caller identifier, sent as the CallerID header.
+ * @param[in]  data        JSON request body; must outlive the transfer.
+ * @param[in]  isSet       true for a set (POST), false for a get.
+ * @param[out] response    Receives the response body during the transfer.
+ * @param[out] headers     Header list to release with rfcHostifRequestDone().
+ * @param[out] viaSocket   Set to true when the request goes over the hostif Unix domain socket;
+ *                         on CURLE_COULDNT_CONNECT call rfcTransportSocketFailed() and retry.
+ * @param[in]  reuse       Use the calling thread's handle, which keeps its connection to hostif
+ *                         open between requests. Only for transfers run with curl_easy_perform()
+ *                         on the calling thread.
+ * @return Easy handle, or NULL if curl could not be initialised.
+ */
+CURL *rfcHostifRequestCreate(const char *pcCallerID, const std::string &data, bool isSet, std::string *response,
+                             struct curl_slist **headers, bool *viaSocket, bool reuse = false);
+
+/**
+ * @brief Log the outcome of a hostif request and release its handle and headers.
+ *
+ * A thread's reusable handle is kept rather than cleaned up.
+ */
+void rfcHostifRequestDone(CURL *curl_handle, struct curl_slist *headers, CURLcode res, const std::string &response);
+#endif
+
+/**
+ * @brief Answer a get without contacting hostif, where possible.
+ * @retval true   Answered (wildcard rejected, local store before hostif is ready, or cache hit).
+ * @retval false  A hostif request is needed.
+ */
+bool rfcReadParameterLocal(const char *pcParameterName, char *pcName, char *pcValue, size_t capacity,
+                           size_t *pLength, DATA_TYPE *peType, WDMP_STATUS *pStatus);
+
+/** @brief JSON body of a single-parameter hostif get. */
+std::string rfcHostifGetBody(const char *pcParameterName);
+
+/**
+ * @brief Parse the hostif answer to a single-parameter get and cache it.
+ * @return statusCode of the response, or WDMP_FAILURE if it could not be parsed.
+ */
+WDMP_STATUS rfcHostifParseGet(const std::string &response, const char *pcParameterName, char *pcName, char *pcValue,
+                              size_t capacity, size_t *pLength, DATA_TYPE *peType, unsigned long generation);
+
+/** @brief Whether a set entry can be sent to hostif (non-empty name and a value; a wildcard name only if @p allowWildcard). */
+bool rfcSetParamValid(const RFC_SetParamData_t *pstParam, bool allowWildcard);
+
+/** @brief JSON body of a hostif set of the @p pending entries of @p pstParams. */
+std::string rfcHostifSetBody(const RFC_SetParamData_t *pstParams, const std::vector<size_t> &pending);
+
+/** @brief Parse the hostif answer to a set into per-parameter statuses. */
+void rfcHostifParseSet(const std::string &response, const RFC_SetParamData_t *pstParams,
+                       const std::vector<size_t> &pending, WDMP_STATUS *peStatus);
+
+/**
+ * @brief Send the @p pending entries of @p pstParams to hostif as one set, and parse the answer.
+ * @param[in]  deadlineMs  Bound on the request; 0 keeps the default timeouts.
+ * @return Outcome of the request; @p peStatus is filled only for RFC_HOSTIF_OK.
+ */
+RfcHostifResult rfcHostifSetRequest(const char *pcCallerID, const RFC_SetParamData_t *pstParams, const std::vector<size_t> &pending,
+                                    WDMP_STATUS *peStatus, unsigned int deadlineMs);
+
+#endif
@@ -0,0 +1,585 @@
+/**
+ * @file rfcapi_http.cpp
+ * @brief Minimal HTTP/1.1 client for hostif, used by the curl-free build.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Each thread keeps one connection to hostif open between requests, like
+ * the reused curl handle of the default build. Only what hostif sends is
+ * understood: a status line, Content-Length or chunked bodies, and
+ * "Connection: close".
+ */
+
+#include <chrono>
+#include <string>
+#include <errno.h>
+#include <poll.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include "rfcapi_hostif.h"
+#include "rfcapi_stats.h"
+#include "rfcapi_transport.h"
+#include "rfcapi_internal.h"
+#include "rdk_debug.h"
+using namespace std;
+
+#define HOSTIF_ADDRESS "127.0.0.1"
+#define HOSTIF_PORT 11999
+/** Defaults of the curl build: connect and total timeouts of a get, and curl's own connect timeout. */
+#define GET_CONNECT_TIMEOUT_MS 5000
+#define GET_TRANSFER_TIMEOUT_MS 10000
+#define DEFAULT_CONNECT_TIMEOUT_MS 300000
+/** Longest response head accepted. */
+#define HTTP_HEAD_LIMIT 16384
+#define HTTP_READ_SIZE 4096
+/** Largest chunk accepted in a chunked body. */
+#define HTTP_CHUNK_LIMIT (64UL * 1024 * 1024)
+
+typedef chrono::steady_clock HttpClock;
+
+/** @brief When the connect and the whole request must be done; an unset point means no limit. */
+struct HttpDeadline
+{
+   HttpClock::time_point connect;
+   HttpClock::time_point total;
+};
+
+/**
+ * @brief Connection kept by each thread for its requests.
+ *
+ * A connection inherited across fork() shares its socket with the parent;
+ * the child closes its copy and connects again.
+ */
+struct ThreadConnection
+{
+   int fd;
+   pid_t pid;
+   bool viaSocket;
+   string path;       /**< Socket path when viaSocket. */
+   string buffer;     /**< Bytes received and not yet consumed. */
+   size_t offset;     /**< Start of the unconsumed bytes in buffer. */
+
+   ThreadConnection() : fd(-1), pid(0), viaSocket(false), offset(0) {}
+   ~ThreadConnection()
+   {
+      if (fd >= 0)
+         close(fd);
+   }
+
+   void reset()
+   {
+      if (fd >= 0)
+         close(fd);
+      fd = -1;
+      buffer.clear();
+      offset = 0;
+   }
+};
+
+static thread_local ThreadConnection threadConnection;
+
+/** @brief Milliseconds left until @p until for poll(), -1 when it is unset, 0 once passed. */
+static int remainingMs(HttpClock::time_point until)
+{
+   if (until == HttpClock::time_point())
+      return -1;
+   long long ms = chrono::duration_cast<chrono::milliseconds>(until - HttpClock::now()).count();
+   return ms <= 0 ? 0 : (ms > 0x7fffffff ? 0x7fffffff : (int)ms);
+}
+
+/**
+ * @brief Wait until @p fd is ready for @p events.
+ * @retval RFC_HOSTIF_TIMEOUT  @p until passed first.
+ */
+static RfcHostifResult waitFd(int fd, short events, HttpClock::time_point until)
+{
+   struct pollfd pfd = { fd, events, 0 };
+   for (;;)
+   {
+      int timeout = remainingMs(until);
+      if (timeout == 0)
+         return RFC_HOSTIF_TIMEOUT;
+      int n = poll(&pfd, 1, timeout);
+      if (n > 0)
+         return RFC_HOSTIF_OK;
+      if (n == 0)
+         return RFC_HOSTIF_TIMEOUT;
+      if (errno != EINTR)
+         return RFC_HOSTIF_ERROR;
+   }
+}
+
+/** @brief Open a non-blocking connection to hostif on the Unix domain socket or loopback TCP. */
+static RfcHostifResult connectHostif(ThreadConnection *conn, HttpClock::time_point until)
+{
+   struct sockaddr_un sun;
+   struct sockaddr_in sin;
+   struct sockaddr *addr;
+   socklen_t addrLen;
+   int fd;
+   if (conn->viaSocket)
+   {
+      if (conn->path.size() >= sizeof(sun.sun_path))
+         return RFC_HOSTIF_UNREACHABLE;
+      memset(&sun, 0, sizeof(sun));
+      sun.sun_family = AF_UNIX;
+      memcpy(sun.sun_path, conn->path.c_str(), conn->path.size() + 1);
+      addr = (struct sockaddr *)&sun;
+      addrLen = sizeof(sun);
+      fd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+   }
+   else
+   {
+      memset(&sin, 0, sizeof(sin));
+      sin.sin_family = AF_INET;
+      sin.sin_port = htons(HOSTIF_PORT);
+      inet_pton(AF_INET, HOSTIF_ADDRESS, &sin.sin_addr);
+      addr = (struct sockaddr *)&sin;
+      addrLen = sizeof(sin);
+      fd = socket(AF_INET, SOCK_STREAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+   }
+   if (fd < 0)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: socket() failed, errno=%d\n", __FUNCTION__, errno);
+      return RFC_HOSTIF_ERROR;
+   }
+   if (!conn->viaSocket)
+   {
+      // Request and answer are each one write; do not hold them back for coalescing.
+      int one = 1;
+      setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+   }
+
+   int rc;
+   while ((rc = connect(fd, addr, addrLen)) < 0)
+   {
+      if (errno == EINTR)
+         continue;
+      // A Unix domain socket with a full backlog: try again shortly.
+      if (errno == EAGAIN && conn->viaSocket && remainingMs(until) != 0)
+      {
+         poll(NULL, 0, 1);
+         continue;
+      }
+      break;
+   }
+   if (rc < 0 && errno == EAGAIN)
+   {
+      close(fd);
+      return RFC_HOSTIF_TIMEOUT;
+   }
+   if (rc < 0 && errno == EINPROGRESS)
+   {
+      RfcHostifResult res = waitFd(fd, POLLOUT, until);
+      if (res != RFC_HOSTIF_OK)
+      {
+         close(fd);
+         return res;
+      }
+      int err = 0;
+      socklen_t errLen = sizeof(err);
+      getsockopt(fd, SOL_SOCKET, SO_ERROR, &err, &errLen);
+      rc = err ? -1 : 0;
+      errno = err;
+   }
+   if (rc < 0)
+   {
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: cannot connect to %s, errno=%d\n", __FUNCTION__,
+              conn->viaSocket ? conn->path.c_str() : HOSTIF_ADDRESS, errno);
+      close(fd);
+      return RFC_HOSTIF_UNREACHABLE;
+   }
+   conn->fd = fd;
+   conn->pid = getpid();
+   conn->buffer.clear();
+   conn->offset = 0;
+   return RFC_HOSTIF_OK;
+}
+
+/** @brief Write the request head and body. */
+static RfcHostifResult sendRequest(ThreadConnection *conn, const char *head, size_t headLen, const string &data,
+                                   HttpClock::time_point until)
+{
+   struct iovec iov[2];
+   iov[0].iov_base = (void *)head;
+   iov[0].iov_len = headLen;
+   iov[1].iov_base = (void *)data.data();
+   iov[1].iov_len = data.size();
+   struct msghdr msg;
+   memset(&msg, 0, sizeof(msg));
+   msg.msg_iov = iov;
+   msg.msg_iovlen = 2;
+   while (iov[0].iov_len + iov[1].iov_len > 0)
+   {
+      // MSG_NOSIGNAL: a connection hostif closed must not raise SIGPIPE in the caller.
+      ssize_t n = sendmsg(conn->fd, &msg, MSG_NOSIGNAL);
+      if (n < 0)
+      {
+         if (errno == EINTR)
+            continue;
+         if (errno == EAGAIN || errno == EWOULDBLOCK)
+         {
+            RfcHostifResult res = waitFd(conn->fd, POLLOUT, until);
+            if (res != RFC_HOSTIF_OK)
+               return res;
+            continue;
+         }
+         return RFC_HOSTIF_ERROR;
+      }
+      size_t sent = (size_t)n;
+      for (int i = 0; i < 2; i++)
+      {
+         size_t step = sent < iov[i].iov_len ? sent : iov[i].iov_len;
+         iov[i].iov_base = (char *)iov[i].iov_base + step;
+         iov[i].iov_len -= step;
+         sent -= step;
+      }
+      if (iov[0].iov_len == 0)
+      {
+         msg.msg_iov = &iov[1];
+         msg.msg_iovlen = 1;
+      }
+   }
+   return RFC_HOSTIF_OK;
+}
+
+/**
+ * @brief Read more of the response into the connection buffer.
+ * @param[out] closed  Set to true when hostif closed the connection.
+ */
+static RfcHostifResult receiveMore(ThreadConnection *conn, HttpClock::time_point until, bool *closed)
+{
+   if (conn->offset > 0 && conn->offset == conn->buffer.size())
+   {
+      conn->buffer.clear();
+      conn->offset = 0;
+   }
+   size_t used = conn->buffer.size();
+   conn->buffer.resize(used + HTTP_READ_SIZE);
+   for (;;)
+   {
+      ssize_t n = recv(conn->fd, &conn->buffer[used], HTTP_READ_SIZE, 0);
+      if (n > 0)
+      {
+         conn->buffer.resize(used + n);
+         return RFC_HOSTIF_OK;
+      }
+      if (n == 0 || (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK))
+      {
+         conn->buffer.resize(used);
+         *closed = true;
+         return RFC_HOSTIF_ERROR;
+      }
+      if (errno == EINTR)
+         continue;
+      RfcHostifResult res = waitFd(conn->fd, POLLIN, until);
+      if (res != RFC_HOSTIF_OK)
+      {
+         conn->buffer.resize(used);
+         return res;
+      }
+   }
+}
+
+/** @brief Value of header @p name in the head [@p begin, @p end), or NULL; @p valueLen receives its length. */
+static const char *findHeader(const char *begin, const char *end, const char *name, size_t *valueLen)
+{
+   size_t nameLen = strlen(name);
+   const char *line = (const char *)memchr(begin, '\n', end - begin);
+   while (line != NULL && ++line < end)
+   {
+      const char *eol = (const char *)memchr(line, '\n', end - line);
+      if (eol == NULL)
+         eol = end;
+      if ((size_t)(eol - line) > nameLen && line[nameLen] == ':' && strncasecmp(line, name, nameLen) == 0)
+      {
+         const char *value = line + nameLen + 1;
+         while (value < eol && (*value == ' ' || *value == '\t'))
+            value++;
+         const char *stop = eol;
+         while (stop > value && (stop[-1] == '\r' || stop[-1] == ' ' || stop[-1] == '\t'))
+            stop--;
+         *valueLen = stop - value;
+         return value;
+      }
+      line = eol < end ? eol : NULL;
+   }
+   return NULL;
+}
+
+/** @brief Whether the header value [@p value, +@p len) lists @p token. */
+static bool headerHasToken(const char *value, size_t len, const char *token)
+{
+   size_t tokenLen = strlen(token);
+   for (size_t i = 0; i + tokenLen <= len; i++)
+   {
+      if (strncasecmp(value + i, token, tokenLen) == 0)
+         return true;
+   }
+   return false;
+}
+
+/**
+ * @brief Read one response and append its body to @p response.
+ * @param[out] httpCode   HTTP status code.
+ * @param[out] keepAlive  Whether the connection can carry the next request.
+ * @param[out] received   Set to true once any byte of the response arrived.
+ */
+static RfcHostifResult receiveResponse(ThreadConnection *conn, string *response, long *httpCode, bool *keepAlive,
+                                       bool *received, HttpClock::time_point until)
+{
+   bool closed = false;
+   size_t headEnd;
+   for (;;)
+   {
+      // The head; 1xx interim answers are skipped.
+      for (;;)
+      {
+         const char *data = conn->buffer.data() + conn->offset;
+         size_t avail = conn->buffer.size() - conn->offset;
+         const char *found = avail >= 4 ? (const char *)memmem(data, avail, "\r\n\r\n", 4) : NULL;
+         if (found != NULL)
+         {
+            headEnd = found + 4 - conn->buffer.data();
+            break;
+         }
+         if (avail > HTTP_HEAD_LIMIT)
+            return RFC_HOSTIF_ERROR;
+         RfcHostifResult res = receiveMore(conn, until, &closed);
+         if (res != RFC_HOSTIF_OK)
+            return res;
+         *received = true;
+      }
+      const char *head = conn->buffer.data() + conn->offset;
+      const char *headStop = conn->buffer.data() + headEnd;
+      int major = 0, minor = 0, code = 0;
+      if (sscanf(head, "HTTP/%d.%d %d", &major, &minor, &code) != 3)
+      {
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: malformed status line from hostif\n", __FUNCTION__);
+         return RFC_HOSTIF_ERROR;
+      }
+      *httpCode = code;
+      if (code >= 100 && code < 200)
+      {
+         conn->offset = headEnd;
+         continue;
+      }
+
+      size_t len;
+      const char *connection = findHeader(head, headStop, "Connection", &len);
+      if (major == 1 && minor == 0)
+         *keepAlive = connection != NULL && headerHasToken(connection, len, "keep-alive");
+      else
+         *keepAlive = connection == NULL || !headerHasToken(connection, len, "close");
+      const char *encoding = findHeader(head, headStop, "Transfer-Encoding", &len);
+      bool chunked = encoding != NULL && headerHasToken(encoding, len, "chunked");
+      const char *lengthValue = findHeader(head, headStop, "Content-Length", &len);
+      conn->offset = headEnd;
+
+      if (code == 204 || code == 304)
+         return RFC_HOSTIF_OK;
+      if (chunked)
+      {
+         for (;;)
+         {
+            // Chunk size line; extensions after ';' are ignored.
+            const char *data = conn->buffer.data() + conn->offset;
+            size_t avail = conn->buffer.size() - conn->offset;
+            const char *eol = (const char *)memchr(data, '\n', avail);
+            if (eol == NULL)
+            {
+               if (avail > HTTP_HEAD_LIMIT)
+                  return RFC_HOSTIF_ERROR;
+               RfcHostifResult res = receiveMore(conn, until, &closed);
+               if (res != RFC_HOSTIF_OK)
+                  return res;
+               continue;
+            }
+            char *stop;
+            unsigned long size = strtoul(data, &stop, 16);
+            if (stop == data || size > HTTP_CHUNK_LIMIT)
+               return RFC_HOSTIF_ERROR;
+            conn->offset = eol + 1 - conn->buffer.data();
+            if (size == 0)
+            {
+               // Trailers, up to the empty line.
+               for (;;)
+               {
+                  data = conn->buffer.data() + conn->offset;
+                  avail = conn->buffer.size() - conn->offset;
+                  eol = (const char *)memchr(data, '\n', avail);
+                  if (eol == NULL)
+                  {
+                     if (avail > HTTP_HEAD_LIMIT)
+                        return RFC_HOSTIF_ERROR;
+                     RfcHostifResult res = receiveMore(conn, until, &closed);
+                     if (res != RFC_HOSTIF_OK)
+                        return res;
+                     continue;
+                  }
+                  conn->offset = eol + 1 - conn->buffer.data();
+                  if (eol == data || (eol == data + 1 && data[0] == '\r'))
+                     return RFC_HOSTIF_OK;
+               }
+            }
+            // Chunk data and its CRLF.
+            size_t need = size + 2;
+            while (conn->buffer.size() - conn->offset < need)
+            {
+               RfcHostifResult res = receiveMore(conn, until, &closed);
+               if (res != RFC_HOSTIF_OK)
+                  return res;
+            }
+            response->append(conn->buffer.data() + conn->offset, size);
+            conn->offset += need;
+         }
+      }
+      if (lengthValue != NULL)
+      {
+         char *stop;
+         unsigned long long remaining = strtoull(lengthValue, &stop, 10);
+         if (stop == lengthValue)
+            return RFC_HOSTIF_ERROR;
+         for (;;)
+         {
+            size_t avail = conn->buffer.size() - conn->offset;
+            size_t take = avail < remaining ? avail : (size_t)remaining;
+            response->append(conn->buffer.data() + conn->offset, take);
+            conn->offset += take;
+            remaining -= take;
+            if (remaining == 0)
+               return RFC_HOSTIF_OK;
+            RfcHostifResult res = receiveMore(conn, until, &closed);
+            if (res != RFC_HOSTIF_OK)
+               return res;
+         }
+      }
+      // Neither: the body runs to the end of the connection.
+      *keepAlive = false;
+      for (;;)
+      {
+         response->append(conn->buffer.data() + conn->offset, conn->buffer.size() - conn->offset);
+         conn->offset = conn->buffer.size();
+         RfcHostifResult res = receiveMore(conn, until, &closed);
+         if (closed)
+            return RFC_HOSTIF_OK;
+         if (res != RFC_HOSTIF_OK)
+            return res;
+      }
+   }
+}
+
+/**
+ * @brief Send the request on this thread's connection to the chosen transport and read the answer.
+ *
+ * A kept-alive connection that hostif closed in the meantime fails before any
+ * answer arrives; the request is then sent once more on a new connection.
+ */
+static RfcHostifResult exchange(ThreadConnection *conn, const char *head, size_t headLen, const string &data,
+                                string *response, long *httpCode, const HttpDeadline &deadline)
+{
+   for (int attempt = 0; ; attempt++)
+   {
+      bool reused = conn->fd >= 0;
+      if (!reused)
+      {
+         HttpClock::time_point until = deadline.connect;
+         if (deadline.total != HttpClock::time_point() && (until == HttpClock::time_point() || deadline.total < until))
+            until = deadline.total;
+         RfcHostifResult res = connectHostif(conn, until);
+         if (res != RFC_HOSTIF_OK)
+            return res;
+      }
+
+      bool keepAlive = false;
+      bool received = false;
+      response->clear();
+      RfcHostifResult res = sendRequest(conn, head, headLen, data, deadline.total);
+      if (res == RFC_HOSTIF_OK)
+         res = receiveResponse(conn, response, httpCode, &keepAlive, &received, deadline.total);
+      if (res == RFC_HOSTIF_OK && keepAlive && conn->offset == conn->buffer.size())
+         return res;
+      conn->reset();
+      if (res == RFC_HOSTIF_ERROR && reused && !received && attempt == 0)
+      {
+         RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: kept-alive connection was closed, reconnecting\n", __FUNCTION__);
+         continue;
+      }
+      return res;
+   }
+}
+
+RfcHostifResult rfcHttpRequest(const char *pcCallerID, const string &data, bool isSet, string *response, unsigned int deadlineMs)
+{
+   rfcStatsNote(RFC_STATS_FROM_HOSTIF);
+   HttpClock::time_point now = HttpClock::now();
+   HttpDeadline deadline;
+   if (deadlineMs != 0)
+      deadline.connect = deadline.total = now + chrono::milliseconds(deadlineMs);
+   else if (!isSet)
+   {
+      deadline.connect = now + chrono::milliseconds(GET_CONNECT_TIMEOUT_MS);
+      deadline.total = now + chrono::milliseconds(GET_TRANSFER_TIMEOUT_MS);
+   }
+   else
+      deadline.connect = now + chrono::milliseconds(DEFAULT_CONNECT_TIMEOUT_MS);
+
+   // Same request line and headers as the curl build sends.
+   char head[256];
+   int headLen = snprintf(head, sizeof(head),
+                          "%s / HTTP/1.1\r\nHost: %s:%d\r\nAccept: */*\r\nCallerID: %.100s\r\n"
+                          "Content-Length: %zu\r\nContent-Type: application/x-www-form-urlencoded\r\n\r\n",
+                          isSet ? "POST" : "GET", HOSTIF_ADDRESS, HOSTIF_PORT, pcCallerID ? pcCallerID : "Unknown", data.size());
+   if (headLen < 0 || (size_t)headLen >= sizeof(head))
+      return RFC_HOSTIF_ERROR;
+
+   ThreadConnection *conn = &threadConnection;
+   if (conn->fd >= 0 && conn->pid != getpid())
+   {
+      // Only the child's copy of the connection is closed.
+      conn->reset();
+   }
+
+   long httpCode = 0;
+   RfcHostifResult res = RFC_HOSTIF_UNREACHABLE;
+   for (int attempt = 0; attempt < 2; attempt++)
+   {
+      string path;
+      bool viaSocket = rfcTransportSocket(&path);
+      if (conn->fd >= 0 && (viaSocket != conn->viaSocket || path != conn->path))
+         conn->reset();
+      conn->viaSocket = viaSocket;
+      conn->path.swap(path);
+      res = exchange(conn, head, (size_t)headLen, data, response, &httpCode, deadline);
+      if (!(viaSocket && res == RFC_HOSTIF_UNREACHABLE))
+         break;
+      // Nothing reached hostif, so the request can be repeated over TCP.
+      rfcTransportSocketFailed();
+   }
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "hostif request result : %d http response code: %ld\n", res, httpCode);
+   return res;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file rfcapi_internal.cpp
+ * @brief File and mapped table helpers shared between the librfcapi translation units.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "rfcapi_internal.h"
+#include "rdk_debug.h"
+using namespace std;
+
+bool rfcReadAll(int fd, string &data)
+{
+   char buf[4096];
+   for (;;)
+   {
+      ssize_t n = read(fd, buf, sizeof(buf));
+      if (n < 0 && errno == EINTR)
+         continue;
+      if (n < 0)
+         return false;
+      if (n == 0)
+         return true;
+      data.append(buf, (size_t)n);
+   }
+}
+
+bool rfcWriteAll(int fd, const string &data)
+{
+   size_t done = 0;
+   while (done < data.size())
+   {
+      ssize_t n = write(fd, data.data() + done, data.size() - done);
+      if (n < 0 && errno == EINTR)
+         continue;
+      if (n <= 0)
+         return false;
+      done += (size_t)n;
+   }
+   return true;
+}
+
+bool rfcReadFile(const char *path, string &data)
+{
+   int fd = open(path, O_RDONLY | O_CLOEXEC);
+   if (fd < 0)
+      return false;
+   struct stat st;
+   if (fstat(fd, &st) == 0 && st.st_size > 0)
+      data.reserve(data.size() + (size_t)st.st_size + 1);
+   bool ok = rfcReadAll(fd, data);
+   close(fd);
+   return ok;
+}
+
+/** @brief Whether [@p offset, @p offset + @p len) lies in the string blob. */
+static bool inStrings(const RfcTableHeader *hdr, size_t size, uint32_t offset, uint32_t len)
+{
+   return offset >= hdr->stringsOffset && (uint64_t)offset + len <= size;
+}
+
+bool rfcTableValid(const void *map, size_t size, const char *magic, uint32_t version,
+                   uint64_t recordsOffset, size_t recordSize, bool hashed)
+{
+   const unsigned char *base = (const unsigned char *)map;
+   const RfcTableHeader *hdr = (const RfcTableHeader *)map;
+   if (size < sizeof(RfcTableHeader) || memcmp(hdr->magic, magic, sizeof(hdr->magic)) != 0 ||
+       hdr->version != version || hdr->fileSize != size)
+      return false;
+   if (hashed ? hdr->bucketCount == 0 || (hdr->bucketCount & (hdr->bucketCount - 1)) != 0 || hdr->bucketCount <= hdr->recordCount
+              : hdr->bucketCount != 0)
+      return false;
+   // 64-bit, so counts from a damaged header cannot wrap around.
+   uint64_t recordsEnd = recordsOffset + (uint64_t)hdr->recordCount * recordSize;
+   uint64_t bucketsEnd = recordsEnd + (uint64_t)hdr->bucketCount * sizeof(uint32_t);
+   if (recordsOffset < sizeof(RfcTableHeader) || bucketsEnd > hdr->stringsOffset || hdr->stringsOffset > size)
+      return false;
+
+   for (uint32_t i = 0; i < hdr->recordCount; i++)
+   {
+      const RfcTableRecord *rec = (const RfcTableRecord *)(base + recordsOffset + (size_t)i * recordSize);
+      if (!inStrings(hdr, size, rec->nameOffset, rec->nameLen) || !inStrings(hdr, size, rec->valueOffset, rec->valueLen))
+         return false;
+   }
+   const uint32_t *buckets = (const uint32_t *)(base + recordsEnd);
+   for (uint32_t b = 0; b < hdr->bucketCount; b++)
+   {
+      if (buckets[b] > hdr->recordCount)
+         return false;
+   }
+   return true;
+}
+
+bool rfcPublishedByRoot(const struct stat &st)
+{
+   return S_ISREG(st.st_mode) && st.st_uid == 0 && (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+}
+
+bool rfcSnapshotDirSafe()
+{
+   if (mkdir(RFC_SNAPSHOT_DIR, 0755) != 0 && errno != EEXIST)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot create %s: %s\n", __FUNCTION__, RFC_SNAPSHOT_DIR, strerror(errno));
+      return false;
+   }
+   struct stat st;
+   if (lstat(RFC_SNAPSHOT_DIR, &st) != 0 || !S_ISDIR(st.st_mode) || st.st_uid != 0 || (st.st_mode & (S_IWGRP | S_IWOTH)) != 0)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: %s is not a directory only root can write\n", __FUNCTION__, RFC_SNAPSHOT_DIR);
+      return false;
+   }
+   return true;
+}
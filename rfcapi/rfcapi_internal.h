@@ -0,0 +1,161 @@
+/**
+ * @file rfcapi_internal.h
+ * @brief Definitions shared between the librfcapi translation units.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_INTERNAL_H_
+#define RFCAPI_INTERNAL_H_
+
+#define LOG_RFCAPI  "LOG.RDK.RFCAPI"  /**< RDK Logger module name for rfcapi. */
+#define TR181_RFC_PREFIX   "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC"
+#define BOOTSTRAP_FILE "/opt/secure/RFC/bootstrap.ini"
+#define RFCDEFAULTS_FILE "/tmp/rfcdefaults.ini"
+#define RFC_SNAPSHOT_DIR "/run/rfc/"  /**< Root-owned; only root may publish there. */
+#define RFCDEFAULTS_SNAPSHOT_FILE RFC_SNAPSHOT_DIR "rfcdefaults.bin"  /**< Compiled form of RFCDEFAULTS_FILE (rfcapi_defaults.cpp). */
+#define RFC_SNAPSHOT_FILE RFC_SNAPSHOT_DIR "rfcsnapshot.bin"  /**< Applied RFC parameters, published by rfcMgr (rfcapi_snapshot.cpp). */
+#define RFC_STATS_SEGMENT "/rfcapi_stats"  /**< shm_open() name of the per-caller statistics (rfcapi_stats.cpp). */
+#define RFC_STATS_ENABLE_FILE "/opt/rfcapi_stats.enable"  /**< Enables the statistics in every process while present. */
+#define RFCDEFAULTS_ETC_DIR "/etc/rfcdefaults/"
+#define RFC_FEATURE_DIR "/opt/secure/RFC/"
+#define RFC_WRITE_BEHIND_FILE RFC_FEATURE_DIR "rfcapi_setjournal.bin"  /**< Sets queued until hostif is ready (rfcapi_writebehind.cpp). */
+#ifdef USE_NONSECURE_TR181_LOCALSTORE
+#define TR181_LOCAL_STORE_DIR "/opt/persistent/"
+#else
+#define TR181_LOCAL_STORE_DIR RFC_FEATURE_DIR
+#endif
+#define TR181_LOCAL_STORE_NAME "tr181localstore.ini"  /**< Local store snapshot (rfcapi_localstore.cpp). */
+#define TR181_LOCAL_STORE_INDEX_NAME "tr181localstore.bin"  /**< Hash index of the snapshot, mapped by readers. */
+#define TR181_LOCAL_STORE_JOURNAL_NAME "tr181localstore.journal"  /**< Local sets and clears since the snapshot. */
+#define TR181_LOCAL_STORE_LOCK_NAME "tr181localstore.lock"  /**< fcntl() lock taken by local store writers. */
+#define TR69HOSTIF_READY_DIR "/tmp"
+#define TR69HOSTIF_READY_NAME ".tr69hostif_http_server_ready"  /**< Written by hostif once its HTTP server accepts requests. */
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+/** @brief Compile the /etc/rfcdefaults ini files into RFCDEFAULTS_SNAPSHOT_FILE and RFCDEFAULTS_FILE (rfcapi.cpp). */
+bool init_rfcdefaults();
+#ifdef __cplusplus
+}
+#endif
+
+#ifdef __cplusplus
+#include <stdint.h>
+#include <string.h>
+#include <string>
+
+#define RFC_HASH_SEED 2166136261u  /**< FNV-1a offset basis; rfcHash() of no bytes. */
+
+/**
+ * @brief Copy a value into a caller buffer, NUL-terminated and truncated to @p capacity.
+ * @return @p len, so callers can report the size they would have needed.
+ */
+static inline size_t rfcCopyValue(char *dst, size_t capacity, const char *src, size_t len)
+{
+   if (capacity > 0)
+   {
+      size_t n = len < capacity ? len : capacity - 1;
+      memcpy(dst, src, n);
+      dst[n] = '\0';
+   }
+   return len;
+}
+
+/**
+ * @brief FNV-1a hash of @p len bytes, continuing from @p h.
+ *
+ * Keys the hash indexes of the mapped tables and checksums journal records.
+ * rfc::hash() in the public rfcflag.h is the same function, evaluated at
+ * compile time.
+ */
+static inline uint32_t rfcHash(const void *data, size_t len, uint32_t h = RFC_HASH_SEED)
+{
+   const unsigned char *p = (const unsigned char *)data;
+   for (size_t i = 0; i < len; i++)
+      h = (h ^ p[i]) * 16777619u;
+   return h;
+}
+
+/** @brief Append everything up to end of file on @p fd to @p data; false on a read error. */
+bool rfcReadAll(int fd, std::string &data);
+
+/** @brief Write all of @p data to @p fd; false on a write error. */
+bool rfcWriteAll(int fd, const std::string &data);
+
+/** @brief Append the contents of @p path to @p data; false if it cannot be opened or read. */
+bool rfcReadFile(const char *path, std::string &data);
+
+struct stat;
+
+/** @brief Whether @p st is a regular file only root could have put in place. */
+bool rfcPublishedByRoot(const struct stat &st);
+
+/** @brief Create RFC_SNAPSHOT_DIR if needed and check nobody but root can write to it. */
+bool rfcSnapshotDirSafe();
+
+/*
+ * Mapped table files: rfcdefaults.bin, rfcsnapshot.bin and tr181localstore.bin.
+ * Host byte order, the files never leave the device. Each is published with
+ * rename() and never truncated, so a mapping stays valid:
+ *
+ *   header          starts with RfcTableHeader
+ *   (format's own fixed-size tables, if any)
+ *   records         recordCount of them, each starting with RfcTableRecord
+ *   uint32_t[bucketCount]   open-addressing hash index: record + 1, 0 = empty
+ *   string blob     names and values, not NUL-terminated, from stringsOffset to the end
+ */
+struct RfcTableHeader
+{
+   char magic[4];
+   uint32_t version;
+   uint32_t fileSize;
+   uint32_t recordCount;
+   uint32_t bucketCount;     /**< Power of two, larger than recordCount; 0 without a hash index. */
+   uint32_t stringsOffset;
+};
+
+struct RfcTableRecord
+{
+   uint32_t nameOffset;      /**< From the start of the file. */
+   uint32_t nameLen;
+   uint32_t valueOffset;
+   uint32_t valueLen;
+};
+
+/**
+ * @brief Check a mapped table file before any of it is used.
+ *
+ * Checks the magic, version and size, that the records, buckets and strings
+ * fit in order, and that every record's strings and every bucket point
+ * inside the file.
+ * @param[in] map            Mapping of the whole file, at least sizeof(RfcTableHeader) bytes.
+ * @param[in] size           Size of the mapping.
+ * @param[in] magic          Expected 4 magic bytes.
+ * @param[in] version        Expected format version.
+ * @param[in] recordsOffset  Where the records start: after the header and the format's own tables.
+ * @param[in] recordSize     Size of one record.
+ * @param[in] hashed         Whether the format has a hash index.
+ */
+bool rfcTableValid(const void *map, size_t size, const char *magic, uint32_t version,
+                   uint64_t recordsOffset, size_t recordSize, bool hashed);
+#endif
+
+#endif
@@ -0,0 +1,415 @@
+/**
+ * @file rfcapi_json.cpp
+ * @brief Special-purpose parser for hostif answers, used by the curl-free build.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include "rfcapi_hostif.h"
+using namespace std;
+
+/** Deepest nesting accepted, as in cJSON. */
+#define JSON_NESTING_LIMIT 1000
+
+/** Members of an entry already met; later duplicates are skipped. */
+#define SEEN_NAME     0x1
+#define SEEN_VALUE    0x2
+#define SEEN_MESSAGE  0x4
+#define SEEN_TYPE     0x8
+
+namespace
+{
+
+/** @brief Which members of the value being parsed are kept. */
+enum JsonTarget
+{
+   JSON_SKIP,         /**< Check the syntax only. */
+   JSON_RESPONSE,     /**< Top-level object. */
+   JSON_PARAMETERS,   /**< "parameters" array. */
+   JSON_ENTRY         /**< One element of "parameters". */
+};
+
+/**
+ * @brief Recursive-descent parser over one response body.
+ *
+ * Nothing is allocated for values that are skipped; kept strings are
+ * decoded straight into the response.
+ */
+class JsonParser
+{
+public:
+   JsonParser(const char *body, size_t length)
+      : p(body), end(body + length), depth(0), response(NULL), seenParameters(false), entrySeen(0) {}
+
+   bool parseResponse(RfcHostifResponse *parsed)
+   {
+      parsed->hasStatusCode = false;
+      parsed->statusCode = 0;
+      parsed->parameters.clear();
+      response = parsed;
+      // A UTF-8 byte order mark is skipped, as cJSON does.
+      if (end - p >= 3 && memcmp(p, "\xEF\xBB\xBF", 3) == 0)
+         p += 3;
+      return value(JSON_RESPONSE, NULL, NULL);
+   }
+
+private:
+   const char *p;
+   const char *end;
+   int depth;
+   RfcHostifResponse *response;
+   bool seenParameters;
+   unsigned int entrySeen;   /**< SEEN_ flags of the entry being parsed. */
+
+   void skipSpace()
+   {
+      while (p < end && (unsigned char)*p <= ' ')
+         p++;
+   }
+
+   bool literal(const char *word, size_t len)
+   {
+      if ((size_t)(end - p) < len || memcmp(p, word, len) != 0)
+         return false;
+      p += len;
+      return true;
+   }
+
+   static int hexDigit(char c)
+   {
+      if (c >= '0' && c <= '9')
+         return c - '0';
+      if (c >= 'a' && c <= 'f')
+         return c - 'a' + 10;
+      if (c >= 'A' && c <= 'F')
+         return c - 'A' + 10;
+      return -1;
+   }
+
+   bool hex4(unsigned int *code)
+   {
+      if (end - p < 4)
+         return false;
+      unsigned int v = 0;
+      for (int i = 0; i < 4; i++)
+      {
+         int d = hexDigit(p[i]);
+         if (d < 0)
+            return false;
+         v = (v << 4) | (unsigned int)d;
+      }
+      p += 4;
+      *code = v;
+      return true;
+   }
+
+   static void appendUtf8(string *out, unsigned int code)
+   {
+      if (code < 0x80)
+         *out += (char)code;
+      else if (code < 0x800)
+      {
+         *out += (char)(0xC0 | (code >> 6));
+         *out += (char)(0x80 | (code & 0x3F));
+      }
+      else if (code < 0x10000)
+      {
+         *out += (char)(0xE0 | (code >> 12));
+         *out += (char)(0x80 | ((code >> 6) & 0x3F));
+         *out += (char)(0x80 | (code & 0x3F));
+      }
+      else
+      {
+         *out += (char)(0xF0 | (code >> 18));
+         *out += (char)(0x80 | ((code >> 12) & 0x3F));
+         *out += (char)(0x80 | ((code >> 6) & 0x3F));
+         *out += (char)(0x80 | (code & 0x3F));
+      }
+   }
+
+   /**
+    * @brief Parse a string at @p p (on its opening quote).
+    * @param[out] out  Receives the decoded text, or NULL to only check it.
+    */
+   bool str(string *out)
+   {
+      p++;
+      const char *run = p;
+      if (out != NULL)
+         out->clear();
+      for (;;)
+      {
+         const char *stop = run;
+         while (stop < end && *stop != '"' && *stop != '\\')
+            stop++;
+         if (stop == end)
+            return false;
+         if (out != NULL)
+            out->append(run, stop - run);
+         p = stop + 1;
+         if (*stop == '"')
+            return true;
+         if (p == end)
+            return false;
+         char c = *p++;
+         unsigned int code;
+         switch (c)
+         {
+         case '"': case '\\': case '/':
+            break;
+         case 'b': c = '\b'; break;
+         case 'f': c = '\f'; break;
+         case 'n': c = '\n'; break;
+         case 'r': c = '\r'; break;
+         case 't': c = '\t'; break;
+         case 'u':
+            if (!hex4(&code) || (code >= 0xDC00 && code <= 0xDFFF))
+               return false;
+            if (code >= 0xD800 && code <= 0xDBFF)
+            {
+               unsigned int low;
+               if (end - p < 2 || p[0] != '\\' || p[1] != 'u')
+                  return false;
+               p += 2;
+               if (!hex4(&low) || low < 0xDC00 || low > 0xDFFF)
+                  return false;
+               code = 0x10000 + (((code & 0x3FF) << 10) | (low & 0x3FF));
+            }
+            if (out != NULL)
+               appendUtf8(out, code);
+            run = p;
+            continue;
+         default:
+            return false;
+         }
+         if (out != NULL)
+            *out += c;
+         run = p;
+      }
+   }
+
+   /** @brief Parse a number at @p p, truncated to int the way cJSON fills valueint. */
+   bool number(int *out)
+   {
+      // Like cJSON: hand at most 63 number characters to strtod() and carry on after what it used.
+      char buffer[64];
+      size_t len = 0;
+      while (len < sizeof(buffer) - 1 && p + len < end &&
+             ((p[len] >= '0' && p[len] <= '9') || p[len] == '-' || p[len] == '+' || p[len] == '.' || p[len] == 'e' || p[len] == 'E'))
+      {
+         buffer[len] = p[len];
+         len++;
+      }
+      buffer[len] = '\0';
+      char *stop;
+      double d = strtod(buffer, &stop);
+      if (stop == buffer)
+         return false;
+      p += stop - buffer;
+      if (out != NULL)
+      {
+         if (d >= INT_MAX)
+            *out = INT_MAX;
+         else if (d <= (double)INT_MIN)
+            *out = INT_MIN;
+         else
+            *out = (int)d;
+      }
+      return true;
+   }
+
+   /**
+    * @brief Parse any value at @p p.
+    * @param[in]  target   Which members to keep if it is an object or array.
+    * @param[out] text     Receives it if it is a string; may be NULL.
+    * @param[out] integer  Receives it if it is a number, 1 for true, otherwise 0; may be NULL.
+    * @param[out] isString Set to whether it was a string; may be NULL.
+    */
+   bool value(JsonTarget target, string *text, int *integer, bool *isString = NULL)
+   {
+      skipSpace();
+      if (p == end)
+         return false;
+      if (isString != NULL)
+         *isString = *p == '"';
+      if (integer != NULL)
+         *integer = 0;
+      switch (*p)
+      {
+      case '"':
+         return str(text);
+      case '{':
+         return object(target);
+      case '[':
+         return array(target);
+      case 'n':
+         return literal("null", 4);
+      case 't':
+         // cJSON sets valueint to 1 for true.
+         if (integer != NULL)
+            *integer = 1;
+         return literal("true", 4);
+      case 'f':
+         return literal("false", 5);
+      default:
+         return number(integer);
+      }
+   }
+
+   /** @brief Parse an array; elements of "parameters" become entries. */
+   bool array(JsonTarget target)
+   {
+      if (++depth > JSON_NESTING_LIMIT)
+         return false;
+      p++;
+      skipSpace();
+      if (p < end && *p == ']')
+      {
+         p++;
+         depth--;
+         return true;
+      }
+      for (;;)
+      {
+         if (!element(target))
+            return false;
+         skipSpace();
+         if (p == end)
+            return false;
+         if (*p == ']')
+            break;
+         if (*p != ',')
+            return false;
+         p++;
+      }
+      p++;
+      depth--;
+      return true;
+   }
+
+   /** @brief Parse one element of an array; each element of "parameters" becomes an entry. */
+   bool element(JsonTarget target)
+   {
+      if (target != JSON_PARAMETERS)
+         return value(JSON_SKIP, NULL, NULL);
+      response->parameters.push_back(RfcHostifEntry());
+      RfcHostifEntry &entry = response->parameters.back();
+      entry.hasName = entry.hasValue = entry.hasType = entry.hasMessage = false;
+      entry.dataType = 0;
+      entrySeen = 0;
+      return value(JSON_ENTRY, NULL, NULL);
+   }
+
+   /** @brief Parse an object, keeping the members @p target asks for. */
+   bool object(JsonTarget target)
+   {
+      if (++depth > JSON_NESTING_LIMIT)
+         return false;
+      p++;
+      skipSpace();
+      if (p < end && *p == '}')
+      {
+         p++;
+         depth--;
+         return true;
+      }
+      string key;
+      for (;;)
+      {
+         skipSpace();
+         if (p == end || *p != '"' || !str(&key))
+            return false;
+         skipSpace();
+         if (p == end || *p != ':')
+            return false;
+         p++;
+         if (!member(target, key.c_str()))
+            return false;
+         skipSpace();
+         if (p == end)
+            return false;
+         if (*p == '}')
+            break;
+         if (*p != ',')
+            return false;
+         p++;
+      }
+      p++;
+      depth--;
+      return true;
+   }
+
+   /** @brief Parse a string member of an entry, keeping it only if it is a string. */
+   bool entryString(unsigned int flag, string *text, bool *present)
+   {
+      entrySeen |= flag;
+      return value(JSON_SKIP, text, NULL, present);
+   }
+
+   /** @brief Parse the value of member @p key; only its first occurrence is kept. */
+   bool member(JsonTarget target, const char *key)
+   {
+      if (target == JSON_RESPONSE)
+      {
+         if (strcasecmp(key, "statusCode") == 0 && !response->hasStatusCode)
+         {
+            response->hasStatusCode = true;
+            return value(JSON_SKIP, NULL, &response->statusCode);
+         }
+         if (strcasecmp(key, "parameters") == 0 && !seenParameters)
+         {
+            seenParameters = true;
+            return value(JSON_PARAMETERS, NULL, NULL);
+         }
+      }
+      else if (target == JSON_PARAMETERS)
+      {
+         // cJSON walks the members of a "parameters" object like array elements.
+         return element(target);
+      }
+      else if (target == JSON_ENTRY)
+      {
+         RfcHostifEntry &entry = response->parameters.back();
+         if (!(entrySeen & SEEN_NAME) && strcasecmp(key, "name") == 0)
+            return entryString(SEEN_NAME, &entry.name, &entry.hasName);
+         if (!(entrySeen & SEEN_VALUE) && strcasecmp(key, "value") == 0)
+            return entryString(SEEN_VALUE, &entry.value, &entry.hasValue);
+         if (!(entrySeen & SEEN_MESSAGE) && strcasecmp(key, "message") == 0)
+            return entryString(SEEN_MESSAGE, &entry.message, &entry.hasMessage);
+         if (!(entrySeen & SEEN_TYPE) && strcasecmp(key, "dataType") == 0)
+         {
+            entrySeen |= SEEN_TYPE;
+            entry.hasType = true;
+            return value(JSON_SKIP, NULL, &entry.dataType);
+         }
+      }
+      return value(JSON_SKIP, NULL, NULL);
+   }
+};
+
+} // namespace
+
+bool rfcHostifParseJson(const char *body, size_t length, RfcHostifResponse *parsed)
+{
+   JsonParser parser(body, length);
+   return parser.parseResponse(parsed);
+}
@@ -0,0 +1,986 @@
+/**
+ * @file rfcapi_localstore.cpp
+ * @brief tr181 local store kept as a snapshot plus an append-only journal.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * tr181localstore.ini keeps its "name=value" format and is the snapshot.
+ * Every compaction also publishes tr181localstore.bin, the same parameters
+ * sorted by name with a hash index, which readers mmap() instead of parsing
+ * the text. The index records the size, inode and mtime of the snapshot it
+ * was written with; if the snapshot no longer matches (an upgrade from a
+ * release without the index, or an edit by hand) readers parse the text as
+ * before and the next write publishes a new index. Lookups use the hash;
+ * wildcard clears and subtree reads binary-search the sorted names, so they
+ * cost the size of the subtree rather than of the store.
+ *
+ * Sets and clears are appended to tr181localstore.journal as checksummed
+ * records, so a write costs one small append and one fsync; a batch of
+ * changes is wrapped in one record so it applies whole. Readers apply
+ * the journal on top of the snapshot; each process keeps the journal's
+ * effect in memory and reads only the journal bytes added since its last
+ * look. Once the journal passes LOCAL_JOURNAL_MAX_RECORDS or
+ * LOCAL_JOURNAL_MAX_BYTES, the writer compacts it: the merged view goes to a
+ * new snapshot and index, each published with rename(), and the journal is
+ * removed. Records are absolute, so replaying a journal over a snapshot that
+ * already contains it changes nothing; a crash between the steps is
+ * harmless. Readers open the journal before the snapshot for the same
+ * reason, and the index before the text, which is renamed first. Scripts
+ * read tr181localstore.ini directly, so a process that wrote also compacts
+ * when it exits, and syncLocalParams() compacts on demand.
+ *
+ * Writers hold an exclusive fcntl() lock on tr181localstore.lock, which the
+ * kernel drops if the holder dies. Readers take no lock at all: every record
+ * is checksummed, a reader stops at one that is not complete yet, and the
+ * snapshot and index are only ever replaced whole. Readers in one process
+ * share the view under a mutex, and never wait for a writer blocked on the
+ * file lock.
+ */
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rfcapi_localstore.h"
+#include "rfcapi_internal.h"
+#include "rdk_debug.h"
+using namespace std;
+
+#define LOCAL_STORE_FILE TR181_LOCAL_STORE_DIR TR181_LOCAL_STORE_NAME
+#define LOCAL_INDEX_FILE TR181_LOCAL_STORE_DIR TR181_LOCAL_STORE_INDEX_NAME
+#define LOCAL_JOURNAL_FILE TR181_LOCAL_STORE_DIR TR181_LOCAL_STORE_JOURNAL_NAME
+#define LOCAL_STORE_LOCK_FILE TR181_LOCAL_STORE_DIR TR181_LOCAL_STORE_LOCK_NAME
+#ifdef F_OFD_SETLKW
+#define LOCAL_STORE_SETLKW F_OFD_SETLKW
+#else
+#define LOCAL_STORE_SETLKW F_SETLKW   /* Per-process locks; writeMutex keeps this process's threads apart. */
+#endif
+#define LOCAL_JOURNAL_MAGIC 0x544c4a31u   /* "TLJ1" */
+#define LOCAL_INDEX_MAGIC "TLSI"
+#define LOCAL_INDEX_VERSION 1
+/** Compaction thresholds. */
+#define LOCAL_JOURNAL_MAX_RECORDS 256
+#define LOCAL_JOURNAL_MAX_BYTES (64 * 1024)
+/** Sanity bound on one field; anything larger is treated as corruption. */
+#define LOCAL_JOURNAL_FIELD_MAX (1024 * 1024)
+
+enum LocalOp
+{
+   LOCAL_OP_SET = 1,
+   LOCAL_OP_CLEAR = 2,  /**< The name is a parameter name or a wildcard. */
+   LOCAL_OP_BATCH = 3   /**< The value holds further records, applied together or not at all. */
+};
+
+/** @brief On-disk record header, followed by the name and value bytes. */
+struct LocalRecordHeader
+{
+   uint32_t magic;
+   uint32_t checksum;   /**< FNV-1a of the header (with this field 0), name and value. */
+   uint32_t op;
+   uint32_t nameLen;
+   uint32_t valueLen;
+};
+
+/** @brief Identity of a file; size -1 if it does not exist. */
+struct LocalStamp
+{
+   int64_t dev;
+   int64_t ino;
+   int64_t size;
+   int64_t mtimeSec;
+   int64_t mtimeNsec;
+};
+
+/*
+ * Index layout, a mapped table (rfcapi_internal.h):
+ *
+ *   LocalIndexHeader
+ *   LocalIndexRecord[recordCount]   sorted by name
+ *   uint32_t[bucketCount]           open-addressing hash index: record + 1, 0 = empty
+ *   string blob                     names and values, not NUL-terminated
+ */
+struct LocalIndexHeader
+{
+   RfcTableHeader table;
+   LocalStamp snapshot;      /**< tr181localstore.ini as published with this index. */
+};
+
+struct LocalIndexRecord
+{
+   RfcTableRecord text;
+   uint32_t hash;
+};
+
+/**
+ * @class LocalIndex
+ * @brief Read-only mapping of one published tr181localstore.bin.
+ */
+class LocalIndex
+{
+public:
+   ~LocalIndex()
+   {
+      munmap((void *)base, mapSize);
+   }
+
+   /** @brief Map and validate the index open on @p fd; returns NULL if malformed. */
+   static shared_ptr<LocalIndex> open(int fd, const struct stat &st);
+
+   /** @brief Index of the record for @p name, or -1. */
+   long find(const char *name, size_t len) const
+   {
+      uint32_t h = rfcHash(name, len);
+      uint32_t mask = header->table.bucketCount - 1;
+      for (uint32_t b = h & mask; buckets[b] != 0; b = (b + 1) & mask)
+      {
+         const LocalIndexRecord &rec = records[buckets[b] - 1];
+         if (rec.hash == h && rec.text.nameLen == len && memcmp(base + rec.text.nameOffset, name, len) == 0)
+            return (long)(buckets[b] - 1);
+      }
+      return -1;
+   }
+
+   /** @brief Index of the first record whose name is not below @p name; count() if none. */
+   uint32_t lowerBound(const string &name) const
+   {
+      uint32_t lo = 0, hi = header->table.recordCount;
+      while (lo < hi)
+      {
+         uint32_t mid = lo + (hi - lo) / 2;
+         const RfcTableRecord &rec = records[mid].text;
+         int cmp = memcmp(base + rec.nameOffset, name.data(), rec.nameLen < name.size() ? rec.nameLen : name.size());
+         if (cmp < 0 || (cmp == 0 && rec.nameLen < name.size()))
+            lo = mid + 1;
+         else
+            hi = mid;
+      }
+      return lo;
+   }
+
+   uint32_t count() const { return header->table.recordCount; }
+   string name(long i) const { return string((const char *)base + records[i].text.nameOffset, records[i].text.nameLen); }
+   string value(long i) const { return string((const char *)base + records[i].text.valueOffset, records[i].text.valueLen); }
+   const LocalStamp &snapshot() const { return header->snapshot; }
+
+private:
+   LocalIndex() : base(NULL), mapSize(0), header(NULL), records(NULL), buckets(NULL) {}
+   LocalIndex(const LocalIndex &);
+   LocalIndex &operator=(const LocalIndex &);
+
+   const unsigned char *base;
+   size_t mapSize;
+   const LocalIndexHeader *header;
+   const LocalIndexRecord *records;
+   const uint32_t *buckets;
+};
+
+/** @brief A name the journal set or cleared. */
+struct LocalEntry
+{
+   bool present;   /**< false: cleared, hiding any value in the snapshot. */
+   string value;
+};
+
+/** @brief This process's copy of the store, and the files it was built from. */
+struct LocalView
+{
+   bool loaded;
+   LocalStamp snapshot;
+   LocalStamp indexFile;
+   shared_ptr<LocalIndex> index;             /**< The snapshot's contents, if the index matches it. */
+   map<string, string> parsed;               /**< The snapshot's contents otherwise. */
+   bool journalPresent;
+   dev_t journalDev;
+   ino_t journalIno;
+   off_t journalSize;      /**< Size when last read. */
+   off_t journalEnd;       /**< End of the last good record. */
+   size_t journalRecords;
+   map<string, LocalEntry> journal;   /**< Effect of the journal on the snapshot. */
+
+   LocalView() : loaded(false), journalPresent(false), journalDev(0), journalIno(0), journalSize(0), journalEnd(0), journalRecords(0)
+   {
+      memset(&snapshot, 0, sizeof(snapshot));
+      memset(&indexFile, 0, sizeof(indexFile));
+   }
+};
+
+static mutex viewMutex;
+static LocalView view;   /**< Guarded by viewMutex. */
+static mutex writeMutex;   /**< Serialises this process's writers; the lock file covers the others. */
+static int lockFd = -1;    /**< Open on LOCAL_STORE_LOCK_FILE; guarded by writeMutex. */
+static pid_t lockPid = 0;  /**< Process that opened lockFd. */
+static bool exitFlushArmed = false;   /**< flushAtExit() is registered; guarded by writeMutex. */
+
+static uint32_t recordChecksum(LocalRecordHeader header, const char *name, const char *value)
+{
+   header.checksum = 0;
+   uint32_t h = rfcHash(&header, sizeof(header));
+   h = rfcHash(name, header.nameLen, h);
+   return rfcHash(value, header.valueLen, h);
+}
+
+static void appendRecord(string &buf, LocalOp op, const string &name, const string &value)
+{
+   LocalRecordHeader header;
+   header.magic = LOCAL_JOURNAL_MAGIC;
+   header.op = op;
+   header.nameLen = (uint32_t)name.size();
+   header.valueLen = (uint32_t)value.size();
+   header.checksum = recordChecksum(header, name.data(), value.data());
+   buf.append((const char *)&header, sizeof(header));
+   buf.append(name);
+   buf.append(value);
+}
+
+static void stampOf(const struct stat &st, LocalStamp *stamp)
+{
+   memset(stamp, 0, sizeof(*stamp));
+   stamp->dev = (int64_t)st.st_dev;
+   stamp->ino = (int64_t)st.st_ino;
+   stamp->size = (int64_t)st.st_size;
+   stamp->mtimeSec = (int64_t)st.st_mtim.tv_sec;
+   stamp->mtimeNsec = (int64_t)st.st_mtim.tv_nsec;
+}
+
+static void stampPath(const char *path, LocalStamp *stamp)
+{
+   struct stat st;
+   if (stat(path, &st) == 0)
+      stampOf(st, stamp);
+   else
+   {
+      memset(stamp, 0, sizeof(*stamp));
+      stamp->size = -1;
+   }
+}
+
+static bool sameStamp(const LocalStamp &a, const LocalStamp &b)
+{
+   return memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+shared_ptr<LocalIndex> LocalIndex::open(int fd, const struct stat &st)
+{
+   if (st.st_size < (off_t)sizeof(LocalIndexHeader) || st.st_size > (off_t)UINT32_MAX)
+      return shared_ptr<LocalIndex>();
+   // Published by rename(), never rewritten in place, so the mapping stays valid.
+   void *map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+   if (map == MAP_FAILED)
+      return shared_ptr<LocalIndex>();
+
+   shared_ptr<LocalIndex> index(new LocalIndex());
+   index->base = (const unsigned char *)map;
+   index->mapSize = (size_t)st.st_size;
+   if (!rfcTableValid(map, index->mapSize, LOCAL_INDEX_MAGIC, LOCAL_INDEX_VERSION, sizeof(LocalIndexHeader), sizeof(LocalIndexRecord), true))
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: ignoring malformed %s\n", __FUNCTION__, LOCAL_INDEX_FILE);
+      return shared_ptr<LocalIndex>();
+   }
+   index->header = (const LocalIndexHeader *)map;
+   index->records = (const LocalIndexRecord *)(index->base + sizeof(LocalIndexHeader));
+   index->buckets = (const uint32_t *)(index->records + index->header->table.recordCount);
+   return index;
+}
+
+/** @brief Build an index of @p values, which is published along with a snapshot stamped @p snapshot. */
+static string buildIndex(const map<string, string> &values, const LocalStamp &snapshot)
+{
+   uint32_t bucketCount = 8;
+   while (bucketCount < values.size() * 2)
+      bucketCount <<= 1;
+   size_t stringsOffset = sizeof(LocalIndexHeader) + values.size() * sizeof(LocalIndexRecord) + bucketCount * sizeof(uint32_t);
+
+   string blob;
+   vector<LocalIndexRecord> records;
+   vector<uint32_t> buckets(bucketCount, 0);
+   records.reserve(values.size());
+   for (map<string, string>::const_iterator it = values.begin(); it != values.end(); ++it)
+   {
+      LocalIndexRecord rec;
+      rec.text.nameOffset = (uint32_t)(stringsOffset + blob.size());
+      rec.text.nameLen = (uint32_t)it->first.size();
+      blob.append(it->first);
+      rec.text.valueOffset = (uint32_t)(stringsOffset + blob.size());
+      rec.text.valueLen = (uint32_t)it->second.size();
+      blob.append(it->second);
+      rec.hash = rfcHash(it->first.data(), it->first.size());
+      uint32_t b = rec.hash & (bucketCount - 1);
+      while (buckets[b] != 0)
+         b = (b + 1) & (bucketCount - 1);
+      records.push_back(rec);
+      buckets[b] = (uint32_t)records.size();
+   }
+
+   LocalIndexHeader header;
+   memset(&header, 0, sizeof(header));
+   memcpy(header.table.magic, LOCAL_INDEX_MAGIC, 4);
+   header.table.version = LOCAL_INDEX_VERSION;
+   header.table.fileSize = (uint32_t)(stringsOffset + blob.size());
+   header.table.recordCount = (uint32_t)records.size();
+   header.table.bucketCount = bucketCount;
+   header.table.stringsOffset = (uint32_t)stringsOffset;
+   header.snapshot = snapshot;
+
+   string image;
+   image.reserve(header.table.fileSize);
+   image.append((const char *)&header, sizeof(header));
+   if (!records.empty())
+      image.append((const char *)&records[0], records.size() * sizeof(LocalIndexRecord));
+   image.append((const char *)&buckets[0], buckets.size() * sizeof(uint32_t));
+   image.append(blob);
+   return image;
+}
+
+static bool hasPrefix(const string &name, const string &prefix)
+{
+   return name.compare(0, prefix.size(), prefix) == 0;
+}
+
+static bool isWildcard(const string &pattern)
+{
+   return !pattern.empty() && pattern[pattern.size() - 1] == '.';
+}
+
+/** @brief Whether @p pattern clears @p name: the name itself, or a name under a wildcard ending in '.'. */
+static bool clearMatches(const string &name, const string &pattern)
+{
+   return name == pattern || (isWildcard(pattern) && hasPrefix(name, pattern));
+}
+
+/** @brief Look @p name up in the snapshot, ignoring the journal. */
+static bool snapshotFind(const string &name, string *value)
+{
+   if (view.index)
+   {
+      long i = view.index->find(name.data(), name.size());
+      if (i < 0)
+         return false;
+      *value = view.index->value(i);
+      return true;
+   }
+   map<string, string>::const_iterator it = view.parsed.find(name);
+   if (it == view.parsed.end())
+      return false;
+   *value = it->second;
+   return true;
+}
+
+/** @brief Look @p name up in the view. */
+static bool viewFind(const string &name, string *value)
+{
+   map<string, LocalEntry>::const_iterator it = view.journal.find(name);
+   if (it == view.journal.end())
+      return snapshotFind(name, value);
+   if (it->second.present)
+      *value = it->second.value;
+   return it->second.present;
+}
+
+/**
+ * @class SnapshotCursor
+ * @brief Walks the snapshot's names under a prefix in sorted order, whichever form it was loaded in.
+ */
+class SnapshotCursor
+{
+public:
+   explicit SnapshotCursor(const string &prefix) : pfx(prefix), pos(0), it(view.parsed.lower_bound(prefix)), ok(false)
+   {
+      if (view.index)
+         pos = view.index->lowerBound(prefix);
+      load();
+   }
+
+   bool valid() const { return ok; }
+   const string &name() const { return current; }
+   string value() const { return view.index ? view.index->value(pos) : it->second; }
+
+   void next()
+   {
+      if (view.index)
+         pos++;
+      else
+         ++it;
+      load();
+   }
+
+private:
+   void load()
+   {
+      if (view.index)
+      {
+         ok = pos < view.index->count();
+         if (ok)
+            current = view.index->name(pos);
+      }
+      else
+      {
+         ok = it != view.parsed.end();
+         if (ok)
+            current = it->first;
+      }
+      ok = ok && hasPrefix(current, pfx);
+   }
+
+   string pfx;
+   uint32_t pos;
+   map<string, string>::const_iterator it;
+   bool ok;
+   string current;
+};
+
+/** @brief Call @p fn(name, value) for every parameter in the view whose name starts with @p prefix, in name order. */
+template <typename Fn>
+static void forEachValue(const string &prefix, Fn fn)
+{
+   // Both sides are sorted: merge the two ranges, the journal winning on equal names.
+   SnapshotCursor base(prefix);
+   map<string, LocalEntry>::const_iterator j = view.journal.lower_bound(prefix);
+   for (;;)
+   {
+      bool haveJournal = j != view.journal.end() && hasPrefix(j->first, prefix);
+      if (haveJournal && (!base.valid() || j->first <= base.name()))
+      {
+         if (base.valid() && j->first == base.name())
+            base.next();
+         if (j->second.present)
+            fn(j->first, j->second.value);
+         ++j;
+      }
+      else if (base.valid())
+      {
+         fn(base.name(), base.value());
+         base.next();
+      }
+      else
+         break;
+   }
+}
+
+static void applyClear(const string &pattern)
+{
+   LocalEntry cleared;
+   cleared.present = false;
+   if (!isWildcard(pattern))
+   {
+      view.journal[pattern] = cleared;
+      return;
+   }
+   // Only the subtree is visited: tombstones hide what the snapshot holds under the wildcard.
+   for (map<string, LocalEntry>::iterator it = view.journal.lower_bound(pattern); it != view.journal.end() && hasPrefix(it->first, pattern); ++it)
+      it->second = cleared;
+   for (SnapshotCursor base(pattern); base.valid(); base.next())
+      view.journal[base.name()] = cleared;
+}
+
+/** @brief Apply the records in @p data to the view; returns the bytes used, up to the first damaged record. */
+static size_t applyRecords(const string &data)
+{
+   size_t pos = 0;
+   while (data.size() - pos >= sizeof(LocalRecordHeader))
+   {
+      LocalRecordHeader header;
+      memcpy(&header, data.data() + pos, sizeof(header));
+      if (header.magic != LOCAL_JOURNAL_MAGIC || header.nameLen > LOCAL_JOURNAL_FIELD_MAX || header.valueLen > LOCAL_JOURNAL_FIELD_MAX)
+         break;
+      size_t len = sizeof(header) + header.nameLen + header.valueLen;
+      if (data.size() - pos < len)
+         break;
+      const char *name = data.data() + pos + sizeof(header);
+      const char *value = name + header.nameLen;
+      if (recordChecksum(header, name, value) != header.checksum)
+         break;
+      if (header.op == LOCAL_OP_BATCH)
+         applyRecords(string(value, header.valueLen));   // Counts its own records.
+      else
+      {
+         if (header.op == LOCAL_OP_SET)
+         {
+            LocalEntry &entry = view.journal[string(name, header.nameLen)];
+            entry.present = true;
+            entry.value.assign(value, header.valueLen);
+         }
+         else if (header.op == LOCAL_OP_CLEAR)
+            applyClear(string(name, header.nameLen));
+         view.journalRecords++;
+      }
+      pos += len;
+   }
+   return pos;
+}
+
+/** @brief Parse the text snapshot: "name=value" lines, the last one for a name wins. */
+static void loadSnapshot(const string &data)
+{
+   size_t pos = 0;
+   while (pos < data.size())
+   {
+      size_t eol = data.find('\n', pos);
+      if (eol == string::npos)
+         eol = data.size();
+      size_t splitterPos = data.find('=', pos);
+      if (splitterPos < eol)
+         view.parsed[data.substr(pos, splitterPos - pos)] = data.substr(splitterPos + 1, eol - splitterPos - 1);
+      pos = eol + 1;
+   }
+}
+
+/** @brief Read the journal of @p fd from the view's good end onwards. */
+static void readJournal(int fd, const struct stat &st)
+{
+   string data;
+   off_t from = view.journalEnd;
+   view.journalSize = st.st_size;
+   if (lseek(fd, from, SEEK_SET) == from && rfcReadAll(fd, data))
+   {
+      view.journalEnd += applyRecords(data);
+      view.journalSize = from + (off_t)data.size();
+   }
+   view.journalPresent = true;
+   view.journalDev = st.st_dev;
+   view.journalIno = st.st_ino;
+}
+
+/** @brief Rebuild the view from the files. */
+static void reloadView()
+{
+   view.index.reset();
+   view.parsed.clear();
+   view.journal.clear();
+   view.journalPresent = false;
+   view.journalSize = 0;
+   view.journalEnd = 0;
+   view.journalRecords = 0;
+   view.loaded = true;
+
+   // Journal first: a compaction publishes the snapshot before it removes the journal.
+   // Index before text: the text is renamed into place first.
+   int journalFd = open(LOCAL_JOURNAL_FILE, O_RDONLY | O_CLOEXEC);
+   int indexFd = open(LOCAL_INDEX_FILE, O_RDONLY | O_CLOEXEC);
+   int snapshotFd = open(LOCAL_STORE_FILE, O_RDONLY | O_CLOEXEC);
+   struct stat st;
+   shared_ptr<LocalIndex> index;
+   memset(&view.indexFile, 0, sizeof(view.indexFile));
+   view.indexFile.size = -1;
+   if (indexFd >= 0)
+   {
+      if (fstat(indexFd, &st) == 0)
+      {
+         stampOf(st, &view.indexFile);
+         index = LocalIndex::open(indexFd, st);
+      }
+      close(indexFd);
+   }
+   memset(&view.snapshot, 0, sizeof(view.snapshot));
+   view.snapshot.size = -1;
+   if (snapshotFd >= 0)
+   {
+      if (fstat(snapshotFd, &st) == 0)
+      {
+         stampOf(st, &view.snapshot);
+         if (index && sameStamp(index->snapshot(), view.snapshot))
+            view.index = index;
+         else
+         {
+            string data;
+            if (rfcReadAll(snapshotFd, data))
+               loadSnapshot(data);
+         }
+      }
+      close(snapshotFd);
+   }
+   if (journalFd >= 0)
+   {
+      if (fstat(journalFd, &st) == 0)
+         readJournal(journalFd, st);
+      close(journalFd);
+   }
+}
+
+/** @brief Bring the view up to date; reads only new journal records when the snapshot is unchanged. */
+static void refreshView()
+{
+   LocalStamp snapshot, indexFile;
+   struct stat js;
+   bool journalPresent = stat(LOCAL_JOURNAL_FILE, &js) == 0;
+   stampPath(LOCAL_INDEX_FILE, &indexFile);
+   stampPath(LOCAL_STORE_FILE, &snapshot);
+   if (!view.loaded || !sameStamp(snapshot, view.snapshot) || !sameStamp(indexFile, view.indexFile))
+   {
+      reloadView();
+      return;
+   }
+   if (!journalPresent)
+   {
+      if (view.journalPresent)
+         reloadView();
+      return;
+   }
+   if (view.journalPresent && (js.st_dev != view.journalDev || js.st_ino != view.journalIno || js.st_size < view.journalSize))
+   {
+      reloadView();
+      return;
+   }
+   if (view.journalPresent && js.st_size == view.journalSize)
+      return;
+
+   int fd = open(LOCAL_JOURNAL_FILE, O_RDONLY | O_CLOEXEC);
+   struct stat st;
+   if (fd < 0 || fstat(fd, &st) != 0 || st.st_dev != js.st_dev || st.st_ino != js.st_ino)
+   {
+      // Replaced since the stat().
+      if (fd >= 0)
+         close(fd);
+      reloadView();
+      return;
+   }
+   readJournal(fd, st);
+   close(fd);
+}
+
+/** @brief Take or drop the cross-process write lock. Caller holds writeMutex. */
+static bool lockStoreFile(short type)
+{
+   if (lockFd >= 0 && lockPid != getpid())
+   {
+      // Inherited across fork(): the description, and any lock on it, is the parent's.
+      close(lockFd);
+      lockFd = -1;
+   }
+   if (lockFd < 0)
+   {
+      lockFd = open(LOCAL_STORE_LOCK_FILE, O_RDWR | O_CREAT | O_CLOEXEC, 0666);
+      if (lockFd < 0)
+      {
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot open %s, errno=%d\n", __FUNCTION__, LOCAL_STORE_LOCK_FILE, errno);
+         return false;
+      }
+      lockPid = getpid();
+   }
+   struct flock fl;
+   memset(&fl, 0, sizeof(fl));
+   fl.l_type = type;
+   fl.l_whence = SEEK_SET;
+   while (fcntl(lockFd, LOCAL_STORE_SETLKW, &fl) != 0)
+   {
+      if (errno != EINTR)
+      {
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot lock %s, errno=%d\n", __FUNCTION__, LOCAL_STORE_LOCK_FILE, errno);
+         return false;
+      }
+   }
+   return true;
+}
+
+/** @brief Exclusive right to change the store, within this process and across processes. */
+class StoreWriteLock
+{
+public:
+   StoreWriteLock() : local(writeMutex), locked(lockStoreFile(F_WRLCK)) {}
+   ~StoreWriteLock()
+   {
+      if (locked)
+         lockStoreFile(F_UNLCK);
+   }
+   bool held() const { return locked; }
+
+private:
+   lock_guard<mutex> local;
+   bool locked;
+};
+
+/** @brief Append @p records to the journal and read them back into the view. Caller holds the write lock. */
+static bool appendJournal(const string &records)
+{
+   int fd = open(LOCAL_JOURNAL_FILE, O_WRONLY | O_APPEND | O_CREAT | O_CLOEXEC, 0666);
+   if (fd < 0)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot open %s, errno=%d\n", __FUNCTION__, LOCAL_JOURNAL_FILE, errno);
+      return false;
+   }
+   struct stat st;
+   if (fstat(fd, &st) != 0)
+   {
+      close(fd);
+      return false;
+   }
+   off_t goodEnd;
+   {
+      lock_guard<mutex> lock(viewMutex);
+      refreshView();
+      goodEnd = view.journalEnd;
+   }
+   if (st.st_size > goodEnd)
+   {
+      // A write torn by a crash; records after it would never be read.
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: dropping %lld damaged bytes at the end of %s\n", __FUNCTION__,
+              (long long)(st.st_size - goodEnd), LOCAL_JOURNAL_FILE);
+      if (ftruncate(fd, goodEnd) != 0)
+      {
+         close(fd);
+         return false;
+      }
+      st.st_size = goodEnd;
+   }
+   // Readers do not take the lock; they stop at a record that is not complete yet.
+   bool ok = rfcWriteAll(fd, records) && fsync(fd) == 0;
+   if (!ok)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot write %s, errno=%d\n", __FUNCTION__, LOCAL_JOURNAL_FILE, errno);
+      // Do not leave part of a record behind.
+      if (ftruncate(fd, st.st_size) != 0)
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot truncate %s, errno=%d\n", __FUNCTION__, LOCAL_JOURNAL_FILE, errno);
+   }
+   close(fd);
+   lock_guard<mutex> lock(viewMutex);
+   refreshView();
+   return ok;
+}
+
+/**
+ * @brief Durably replace @p path with @p data, keeping its mode.
+ * @param[out] published  Receives the identity of the new file.
+ */
+static bool publishFile(const char *path, const string &data, LocalStamp *published)
+{
+   string tmp = string(path) + ".tmp";
+   int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666);
+   if (fd < 0)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot create %s, errno=%d\n", __FUNCTION__, tmp.c_str(), errno);
+      return false;
+   }
+   struct stat st;
+   if (stat(path, &st) == 0 && fchmod(fd, st.st_mode & 07777) != 0)
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: cannot keep the mode of %s, errno=%d\n", __FUNCTION__, path, errno);
+   // rename() keeps the inode, size and mtime, so the stamp taken here is the published file's.
+   bool ok = rfcWriteAll(fd, data) && fsync(fd) == 0 && fstat(fd, &st) == 0;
+   close(fd);
+   if (!ok || rename(tmp.c_str(), path) != 0)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot publish %s, errno=%d\n", __FUNCTION__, path, errno);
+      unlink(tmp.c_str());
+      return false;
+   }
+   stampOf(st, published);
+   return true;
+}
+
+/** @brief Write the view to a new snapshot and index, and drop the journal. Caller holds the write lock. */
+static bool compactJournal()
+{
+   map<string, string> sorted;
+   size_t records;
+   {
+      lock_guard<mutex> lock(viewMutex);
+      refreshView();
+      if (!view.journalPresent && view.index)
+         return true;
+      records = view.journalRecords;
+      forEachValue("", [&sorted](const string &name, const string &value) { sorted.insert(sorted.end(), make_pair(name, value)); });
+   }
+   string data;
+   for (map<string, string>::const_iterator it = sorted.begin(); it != sorted.end(); ++it)
+   {
+      data += it->first;
+      data += '=';
+      data += it->second;
+      data += '\n';
+   }
+
+   // Text first: an index is only used with the text it was published with.
+   LocalStamp snapshot, indexFile;
+   if (!publishFile(LOCAL_STORE_FILE, data, &snapshot) || !publishFile(LOCAL_INDEX_FILE, buildIndex(sorted, snapshot), &indexFile))
+      return false;
+   // Both must be durable before the journal they replace goes.
+   int dirFd = open(TR181_LOCAL_STORE_DIR, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+   if (dirFd >= 0)
+   {
+      fsync(dirFd);
+      close(dirFd);
+   }
+   if (unlink(LOCAL_JOURNAL_FILE) != 0 && errno != ENOENT)
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot remove %s, errno=%d\n", __FUNCTION__, LOCAL_JOURNAL_FILE, errno);
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: folded %zu record(s) into %s\n", __FUNCTION__, records, LOCAL_STORE_FILE);
+   return true;
+}
+
+/** @brief Fold what is left in the journal into tr181localstore.ini when a process that wrote exits. */
+static void flushAtExit()
+{
+   rfcLocalStoreCompact();
+}
+
+/**
+ * @brief Append, then compact if the journal has grown past its thresholds
+ * or the snapshot has no usable index. Caller holds the write lock.
+ */
+static bool commitRecords(const string &records)
+{
+   if (!appendJournal(records))
+      return false;
+   bool compact;
+   {
+      lock_guard<mutex> lock(viewMutex);
+      compact = view.journalRecords >= LOCAL_JOURNAL_MAX_RECORDS || view.journalEnd >= LOCAL_JOURNAL_MAX_BYTES || !view.index;
+   }
+   if (compact)
+      compactJournal();   // On failure the journal is kept, and the next set tries again.
+   // Scripts read tr181localstore.ini directly: do not leave this process's sets only in the journal.
+   if (!exitFlushArmed)
+      exitFlushArmed = atexit(flushAtExit) == 0;
+   return true;
+}
+
+bool rfcLocalStoreGet(const char *pcParameterName, string *value)
+{
+   lock_guard<mutex> lock(viewMutex);
+   refreshView();
+   return viewFind(pcParameterName, value);
+}
+
+void rfcLocalStoreGetMany(const char **ppcParameterNames, size_t count, vector<string> *values, vector<bool> *found)
+{
+   values->assign(count, string());
+   found->assign(count, false);
+   lock_guard<mutex> lock(viewMutex);
+   refreshView();
+   for (size_t i = 0; i < count; i++)
+   {
+      if (ppcParameterNames[i] != NULL)
+         (*found)[i] = viewFind(ppcParameterNames[i], &(*values)[i]);
+   }
+}
+
+bool rfcLocalStoreSet(const char *pcParameterName, const char *pcValue)
+{
+   RfcLocalChange change = { pcParameterName, pcValue };
+   return rfcLocalStoreUpdate(&change, 1);
+}
+
+bool rfcLocalStoreUpdate(const RfcLocalChange *changes, size_t count)
+{
+   for (size_t i = 0; i < count; i++)
+   {
+      const char *name = changes[i].name;
+      const char *value = changes[i].value;
+      if (name == NULL || (value != NULL && (strchr(name, '=') != NULL || strchr(name, '\n') != NULL || strchr(value, '\n') != NULL)))
+      {
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: %s cannot be stored in %s\n", __FUNCTION__, name ? name : "(null)", LOCAL_STORE_FILE);
+         return false;
+      }
+   }
+   StoreWriteLock writeLock;
+   if (!writeLock.held())
+      return false;
+   string records;
+   size_t written = 0;
+   {
+      lock_guard<mutex> lock(viewMutex);
+      refreshView();
+      bool cleared = false;
+      unordered_set<string> touched;   // Names set earlier in the batch.
+      for (size_t i = 0; i < count; i++)
+      {
+         if (changes[i].value == NULL)
+         {
+            appendRecord(records, LOCAL_OP_CLEAR, changes[i].name, "");
+            cleared = true;
+            written++;
+            continue;
+         }
+         string current;
+         if (!cleared && touched.insert(changes[i].name).second && viewFind(changes[i].name, &current) && current == changes[i].value)
+            continue;   // Unchanged; spare the flash.
+         appendRecord(records, LOCAL_OP_SET, changes[i].name, changes[i].value);
+         written++;
+      }
+   }
+   if (written == 0)
+      return true;
+   if (written > 1)
+   {
+      if (records.size() > LOCAL_JOURNAL_FIELD_MAX)
+      {
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: %zu changes are too large for one record\n", __FUNCTION__, count);
+         return false;
+      }
+      string batch;
+      appendRecord(batch, LOCAL_OP_BATCH, "", records);
+      records.swap(batch);
+   }
+   return commitRecords(records);
+}
+
+bool rfcLocalStoreClear(const char *pcPattern, size_t *pCleared)
+{
+   StoreWriteLock writeLock;
+   if (!writeLock.held())
+      return false;
+   string pattern(pcPattern);
+   size_t cleared = 0;
+   {
+      lock_guard<mutex> lock(viewMutex);
+      refreshView();
+      forEachValue(pattern, [&pattern, &cleared](const string &name, const string &) {
+         if (clearMatches(name, pattern))
+         {
+            RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "Clearing param: %s\n", name.c_str());
+            cleared++;
+         }
+      });
+   }
+   if (pCleared != NULL)
+      *pCleared = cleared;
+   if (cleared == 0)
+   {
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "Key %s not present. Nothing to clear.\n", pcPattern);
+      return true;
+   }
+   string records;
+   appendRecord(records, LOCAL_OP_CLEAR, pcPattern, "");
+   return commitRecords(records);
+}
+
+void rfcLocalStoreRead(map<string, string> *values)
+{
+   rfcLocalStoreReadTree("", values);
+}
+
+void rfcLocalStoreReadTree(const char *pcPrefix, map<string, string> *values)
+{
+   lock_guard<mutex> lock(viewMutex);
+   refreshView();
+   values->clear();
+   forEachValue(pcPrefix, [values](const string &name, const string &value) { values->insert(values->end(), make_pair(name, value)); });
+}
+
+bool rfcLocalStoreCompact()
+{
+   StoreWriteLock writeLock;
+   return writeLock.held() && compactJournal();
+}
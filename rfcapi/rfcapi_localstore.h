@@ -0,0 +1,105 @@
+/**
+ * @file rfcapi_localstore.h
+ * @brief Internal access to the tr181 local store (tr181localstore.ini, its index and its journal).
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * Used by tr181api's getLocalParam(), setLocalParam() and clearLocalParam(),
+ * and by the subscription dispatcher. Every function may be called from any
+ * thread and process; writers lock the store themselves, readers never wait
+ * for them.
+ */
+
+#ifndef RFCAPI_LOCALSTORE_H_
+#define RFCAPI_LOCALSTORE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+
+/** @brief One change of an rfcLocalStoreUpdate() batch. */
+struct RfcLocalChange
+{
+   const char *name;    /**< Parameter name, or the name or wildcard to clear. */
+   const char *value;   /**< New value; NULL clears @p name. */
+};
+
+/**
+ * @brief Look up a local parameter.
+ * @param[in]  pcParameterName  TR181 parameter name.
+ * @param[out] value            Receives the value, which may be empty.
+ * @retval true   The parameter is in the local store.
+ * @retval false  It is not, or the store cannot be read.
+ */
+bool rfcLocalStoreGet(const char *pcParameterName, std::string *value);
+
+/**
+ * @brief Look up several local parameters against one view of the store.
+ * @param[in]  ppcParameterNames  Array of @p count names; NULL entries are not found.
+ * @param[out] values             Receives one value per name; empty if not found.
+ * @param[out] found              Receives whether each name is in the local store.
+ */
+void rfcLocalStoreGetMany(const char **ppcParameterNames, size_t count, std::vector<std::string> *values, std::vector<bool> *found);
+
+/**
+ * @brief Set a local parameter by appending one record to the journal.
+ * @retval true   The record is synced to disk.
+ * @retval false  The journal could not be written; nothing changed.
+ */
+bool rfcLocalStoreSet(const char *pcParameterName, const char *pcValue);
+
+/**
+ * @brief Apply several sets and clears as one journal record.
+ *
+ * Readers, and a restart after a crash, see either all of the changes or
+ * none of them. Changes apply in order; sets of the current value are
+ * dropped unless an earlier change in the batch touched the store.
+ * @retval true   The record is synced to disk, or there was nothing to write.
+ * @retval false  A change cannot be stored or the journal could not be written; nothing changed.
+ */
+bool rfcLocalStoreUpdate(const RfcLocalChange *changes, size_t count);
+
+/**
+ * @brief Remove a local parameter, or every parameter under a wildcard ending in '.'.
+ * @param[in]  pcPattern  Parameter name or wildcard.
+ * @param[out] pCleared   Number of parameters removed; may be NULL.
+ * @retval true   Done, or nothing matched and nothing was written.
+ * @retval false  The journal could not be written; nothing changed.
+ */
+bool rfcLocalStoreClear(const char *pcPattern, size_t *pCleared);
+
+/** @brief Copy every local parameter into @p values. */
+void rfcLocalStoreRead(std::map<std::string, std::string> *values);
+
+/**
+ * @brief Copy the local parameters whose names start with @p pcPrefix into @p values.
+ *
+ * Costs a binary search plus the size of the subtree, not of the store.
+ */
+void rfcLocalStoreReadTree(const char *pcPrefix, std::map<std::string, std::string> *values);
+
+/**
+ * @brief Fold the journal into tr181localstore.ini and publish its index.
+ *
+ * Runs by itself once the journal passes its size or record threshold.
+ * @retval true   The journal is empty.
+ * @retval false  The snapshot could not be written; the journal is kept.
+ */
+bool rfcLocalStoreCompact();
+
+#endif
@@ -0,0 +1,245 @@
+/**
+ * @file rfcapi_ready.cpp
+ * @brief Tracker of whether the hostif HTTP server can be used.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include "rfcapi_ready.h"
+#include "rfcapi_internal.h"
+#include "rfcapi_watch.h"
+#include "rdk_debug.h"
+using namespace std;
+
+/** Re-probe interval after hostif refused a connection while its marker stayed in place, in ms. */
+#define HOSTIF_REPROBE_INTERVAL 5000
+/** Marker poll interval of waitForRFCHostifReady() when inotify is unavailable, in ms. */
+#define HOSTIF_POLL_INTERVAL 100
+/** Marker recheck interval while the watch is live but has reported nothing, in ms. */
+#define HOSTIF_RECHECK_INTERVAL 1000
+#define READY_EVENT_MASK (IN_CREATE | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE | IN_MOVED_FROM | IN_DELETE_SELF | IN_MOVE_SELF)
+
+typedef chrono::steady_clock ReadyClock;
+
+static atomic<bool> hostifReady(false);
+
+static mutex readyMutex;                /**< Guards everything below. */
+static bool readyArmed = false;         /**< Arming was attempted. */
+static int readyFd = -1;                /**< Non-blocking inotify fd, or -1 if inotify is unavailable. */
+static pid_t readyPid = 0;              /**< Process that opened readyFd. */
+static int readyWd = -1;                /**< Watch on TR69HOSTIF_READY_DIR, or -1 while not watched. */
+static bool unreachable = false;        /**< hostif refused a connection since it was last seen ready. */
+static ReadyClock::time_point reprobeAt;
+static ReadyClock::time_point recheckAt;
+
+static bool markerExists()
+{
+   struct stat st;
+   return stat(TR69HOSTIF_READY_DIR "/" TR69HOSTIF_READY_NAME, &st) == 0;
+}
+
+/** @brief Flip the state and log the transition. Caller holds readyMutex. */
+static void setReadyLocked(bool ready, const char *reason)
+{
+   if (ready)
+   {
+      unreachable = false;
+      // Not needed while ready (a restart shows up as a refused connection), and a
+      // watch on a busy /tmp would queue events nobody reads.
+      if (readyWd >= 0)
+      {
+         inotify_rm_watch(readyFd, readyWd);
+         readyWd = -1;
+      }
+   }
+   if (hostifReady.load(memory_order_relaxed) == ready)
+      return;
+   hostifReady.store(ready, memory_order_release);
+   // Answers switch between hostif and the store files.
+   rfcStoreChanged();
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "rfcHostifReady: http server is %s (%s)\n", ready ? "ready" : "not ready", reason);
+}
+
+/** @brief (Re)establish the directory watch and pick up the current marker state. Caller holds readyMutex. */
+static void watchLocked()
+{
+   readyWd = inotify_add_watch(readyFd, TR69HOSTIF_READY_DIR, READY_EVENT_MASK);
+   if (readyWd < 0)
+      return;
+   // The marker may have been written before the watch existed.
+   if (!unreachable && markerExists())
+      setReadyLocked(true, "marker present");
+}
+
+/** @brief Apply the queued marker events without blocking. Caller holds readyMutex. */
+static void readEventsLocked()
+{
+   if (readyArmed && readyPid != getpid())
+   {
+      // Forked: the inherited fd shares one event queue with the parent, which may
+      // already have read the events meant for us. Open our own and look at the marker.
+      if (readyFd >= 0)
+         close(readyFd);
+      readyFd = -1;
+      readyWd = -1;
+      readyArmed = false;
+      reprobeAt = ReadyClock::time_point();
+      recheckAt = ReadyClock::time_point();
+   }
+   if (!readyArmed)
+   {
+      readyArmed = true;
+      readyPid = getpid();
+      readyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+      if (readyFd < 0)
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: inotify_init1 failed, errno=%d. Polling the hostif ready marker\n", __FUNCTION__, errno);
+   }
+   if (readyFd < 0)
+      return;
+   if (readyWd < 0)
+   {
+      watchLocked();
+      if (readyWd < 0)
+         return;
+   }
+
+   bool overflow = false;
+   char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+   for (;;)
+   {
+      ssize_t len = read(readyFd, buf, sizeof(buf));
+      if (len < 0 && errno == EINTR)
+         continue;
+      if (len <= 0)
+         break;
+      for (char *ptr = buf; ptr < buf + len; )
+      {
+         const struct inotify_event *event = (const struct inotify_event *)ptr;
+         if (event->mask & IN_Q_OVERFLOW)
+         {
+            overflow = true;
+         }
+         else if (event->wd != readyWd)
+         {
+            // Left over from a watch removed when hostif became ready.
+         }
+         else if (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))
+         {
+            readyWd = -1;
+         }
+         else if (event->len > 0 && strcmp(event->name, TR69HOSTIF_READY_NAME) == 0)
+         {
+            if (event->mask & (IN_DELETE | IN_MOVED_FROM))
+               setReadyLocked(false, "marker removed");
+            else
+               setReadyLocked(true, "marker written");
+         }
+         ptr += sizeof(struct inotify_event) + event->len;
+      }
+   }
+   if (overflow && !unreachable)
+      setReadyLocked(markerExists(), "inotify overflow");
+}
+
+bool rfcHostifReady()
+{
+   if (hostifReady.load(memory_order_acquire))
+      return true;
+
+   lock_guard<mutex> lock(readyMutex);
+   readEventsLocked();
+   if (hostifReady.load(memory_order_relaxed))
+      return true;
+
+   if (unreachable)
+   {
+      // hostif may have restarted without rewriting its marker; let one request through now and then.
+      ReadyClock::time_point now = ReadyClock::now();
+      if (now < reprobeAt)
+         return false;
+      reprobeAt = now + chrono::milliseconds(HOSTIF_REPROBE_INTERVAL);
+      if (markerExists())
+         setReadyLocked(true, "retrying after a refused connection");
+   }
+   else
+   {
+      // Without a watch, check the marker on each call; with one, still check now and then in case an event was lost.
+      ReadyClock::time_point now = ReadyClock::now();
+      if (readyWd < 0 || now >= recheckAt)
+      {
+         recheckAt = now + chrono::milliseconds(HOSTIF_RECHECK_INTERVAL);
+         if (markerExists())
+            setReadyLocked(true, "marker present");
+      }
+   }
+   return hostifReady.load(memory_order_relaxed);
+}
+
+void rfcHostifUnreachable()
+{
+   lock_guard<mutex> lock(readyMutex);
+   unreachable = true;
+   reprobeAt = ReadyClock::now() + chrono::milliseconds(HOSTIF_REPROBE_INTERVAL);
+   if (hostifReady.load(memory_order_relaxed))
+   {
+      hostifReady.store(false, memory_order_release);
+      rfcStoreChanged();
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: http server refused the connection, using local store\n", __FUNCTION__);
+   }
+   // Watch again for hostif rewriting its marker when it comes back.
+   readEventsLocked();
+}
+
+bool waitForRFCHostifReady(unsigned int timeoutMs)
+{
+   ReadyClock::time_point deadline = ReadyClock::now() + chrono::milliseconds(timeoutMs);
+   for (;;)
+   {
+      if (rfcHostifReady())
+         return true;
+      ReadyClock::time_point now = ReadyClock::now();
+      if (now >= deadline)
+         return false;
+
+      ReadyClock::time_point wakeAt = deadline;
+      int fd;
+      {
+         lock_guard<mutex> lock(readyMutex);
+         fd = readyWd >= 0 ? readyFd : -1;
+         if (unreachable && reprobeAt < wakeAt)
+            wakeAt = reprobeAt;
+         else if (!unreachable && fd >= 0 && recheckAt < wakeAt)
+            wakeAt = recheckAt;
+      }
+      if (fd < 0 && now + chrono::milliseconds(HOSTIF_POLL_INTERVAL) < wakeAt)
+         wakeAt = now + chrono::milliseconds(HOSTIF_POLL_INTERVAL);
+      long waitMs = (long)chrono::duration_cast<chrono::milliseconds>(wakeAt - now).count() + 1;
+
+      struct pollfd pfd = { fd, POLLIN, 0 };
+      poll(&pfd, fd >= 0 ? 1 : 0, (int)waitMs);
+   }
+}
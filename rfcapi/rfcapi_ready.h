@@ -0,0 +1,48 @@
+/**
+ * @file rfcapi_ready.h
+ * @brief Internal tracker of whether the hostif HTTP server can be used.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_READY_H_
+#define RFCAPI_READY_H_
+
+#include "rfcapi.h"
+
+/**
+ * @brief Whether requests should go to hostif.
+ *
+ * Becomes true when the ready marker appears (seen through inotify, or by
+ * a periodic check of the marker) and stays true until rfcHostifUnreachable()
+ * is called. Once ready this is a single atomic load. A forked child opens
+ * its own inotify watch on its first call.
+ * @retval true   Send requests to hostif.
+ * @retval false  Answer from the local store files.
+ */
+bool rfcHostifReady();
+
+/**
+ * @brief Record that hostif refused a connection (it stopped or is restarting).
+ *
+ * Requests fall back to the local store files until hostif rewrites the ready
+ * marker, or until a periodic re-probe finds the marker still present.
+ */
+void rfcHostifUnreachable();
+
+#endif
@@ -0,0 +1,434 @@
+/**
+ * @file rfcapi_snapshot.cpp
+ * @brief Applied-parameter snapshot: published by rfcMgr, mapped read-only by
+ *        every librfcapi client.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rfcapi_snapshot.h"
+#include "rfcapi_defaults.h"
+#include "rfcapi_internal.h"
+#include "rfcapi_ready.h"
+#include "rfcapi_watch.h"
+#include "rdk_debug.h"
+using namespace std;
+
+/*
+ * Snapshot layout, a mapped table (rfcapi_internal.h):
+ *
+ *   SnapshotHeader
+ *   SnapshotRecord[recordCount]   sorted by name
+ *   uint32_t[bucketCount]         open-addressing index: record + 1, 0 = empty
+ *   string blob                   names and values, not NUL-terminated
+ *
+ * A published file is never rewritten, apart from the superseded word: the
+ * publisher sets it once a newer snapshot has been renamed over the path, so
+ * readers notice the replacement with a load from their mapping instead of a
+ * stat() per call.
+ */
+#define SNAPSHOT_MAGIC    "RFCS"
+#define SNAPSHOT_VERSION  1
+#define RFC_SNAPSHOT_ENV  "RFC_SNAPSHOT"
+/** Interval between attempts to open the snapshot while none has been published, in ms. */
+#define SNAPSHOT_RETRY_INTERVAL 1000
+
+/** Identity of a store file when the snapshot was taken; size is -1 if the file did not exist. */
+struct SnapshotStamp
+{
+   int64_t dev;
+   int64_t ino;
+   int64_t size;
+   int64_t mtimeSec;
+   int64_t mtimeNsec;
+};
+
+/** Store files whose contents the snapshot mirrors; any change to them makes it untrustworthy. */
+static const char *stampedFiles[] = { TR181STORE_FILE, BOOTSTRAP_FILE };
+#define STAMPED_FILE_COUNT (sizeof(stampedFiles) / sizeof(stampedFiles[0]))
+
+struct SnapshotHeader
+{
+   RfcTableHeader table;
+   uint64_t sequence;        /**< Bumped on every publish. */
+   uint32_t superseded;      /**< Set in place once a newer snapshot replaced this file. */
+   uint32_t reserved;
+   SnapshotStamp stamps[STAMPED_FILE_COUNT];
+};
+
+struct SnapshotRecord
+{
+   RfcTableRecord text;
+   uint32_t hash;
+   int32_t type;
+};
+
+typedef chrono::steady_clock SnapshotClock;
+
+static void stampFile(const char *path, SnapshotStamp *stamp)
+{
+   struct stat st;
+   memset(stamp, 0, sizeof(*stamp));
+   if (stat(path, &st) != 0)
+   {
+      stamp->size = -1;
+      return;
+   }
+   stamp->dev = (int64_t)st.st_dev;
+   stamp->ino = (int64_t)st.st_ino;
+   stamp->size = (int64_t)st.st_size;
+   stamp->mtimeSec = (int64_t)st.st_mtim.tv_sec;
+   stamp->mtimeNsec = (int64_t)st.st_mtim.tv_nsec;
+}
+
+/**
+ * @class SnapshotMap
+ * @brief Read-only mapping of one published snapshot file.
+ */
+class SnapshotMap
+{
+public:
+   ~SnapshotMap()
+   {
+      munmap((void *)base, mapSize);
+   }
+
+   /** @brief Map and validate @p path; returns NULL if missing or malformed. */
+   static shared_ptr<SnapshotMap> open(const char *path);
+
+   /** @brief Whether a newer snapshot has been published since this one was mapped. */
+   bool superseded() const
+   {
+      return __atomic_load_n(&header->superseded, __ATOMIC_ACQUIRE) != 0;
+   }
+
+   /** @brief Whether the store files are still the ones the snapshot was taken from. */
+   bool storesUnchanged() const
+   {
+      for (size_t i = 0; i < STAMPED_FILE_COUNT; i++)
+      {
+         SnapshotStamp now;
+         stampFile(stampedFiles[i], &now);
+         if (memcmp(&now, &header->stamps[i], sizeof(now)) != 0)
+            return false;
+      }
+      return true;
+   }
+
+   /** @brief Index of the record for @p name, or -1. */
+   long find(const char *name, size_t len) const
+   {
+      uint32_t h = rfcHash(name, len);
+      uint32_t mask = header->table.bucketCount - 1;
+      for (uint32_t b = h & mask; buckets[b] != 0; b = (b + 1) & mask)
+      {
+         const SnapshotRecord &rec = records[buckets[b] - 1];
+         if (rec.hash == h && rec.text.nameLen == len && memcmp(base + rec.text.nameOffset, name, len) == 0)
+            return (long)(buckets[b] - 1);
+      }
+      return -1;
+   }
+
+   const SnapshotRecord &record(long i) const { return records[i]; }
+   const char *text(uint32_t offset) const { return (const char *)base + offset; }
+   uint64_t sequence() const { return header->sequence; }
+
+   /** Store generation the store files were last compared at; 0 = never. */
+   atomic<unsigned long> checkedGeneration;
+   /** Result of that comparison. */
+   atomic<bool> trusted;
+
+private:
+   SnapshotMap() : checkedGeneration(0), trusted(false), base(NULL), mapSize(0), header(NULL), records(NULL), buckets(NULL) {}
+   SnapshotMap(const SnapshotMap &);
+   SnapshotMap &operator=(const SnapshotMap &);
+
+   const unsigned char *base;
+   size_t mapSize;
+   const SnapshotHeader *header;
+   const SnapshotRecord *records;
+   const uint32_t *buckets;
+};
+
+shared_ptr<SnapshotMap> SnapshotMap::open(const char *path)
+{
+   int fd = ::open(path, O_RDONLY | O_NOFOLLOW | O_CLOEXEC);
+   if (fd < 0)
+      return shared_ptr<SnapshotMap>();
+   struct stat st;
+   void *map = MAP_FAILED;
+   if (fstat(fd, &st) == 0 && rfcPublishedByRoot(st) && st.st_size >= (off_t)sizeof(SnapshotHeader) && st.st_size <= (off_t)UINT32_MAX)
+      map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+   close(fd);
+   if (map == MAP_FAILED)
+      return shared_ptr<SnapshotMap>();
+
+   shared_ptr<SnapshotMap> snap(new SnapshotMap());
+   snap->base = (const unsigned char *)map;
+   snap->mapSize = (size_t)st.st_size;
+   if (!rfcTableValid(map, snap->mapSize, SNAPSHOT_MAGIC, SNAPSHOT_VERSION, sizeof(SnapshotHeader), sizeof(SnapshotRecord), true))
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: ignoring malformed snapshot %s\n", __FUNCTION__, path);
+      return shared_ptr<SnapshotMap>();
+   }
+   snap->header = (const SnapshotHeader *)map;
+   snap->records = (const SnapshotRecord *)(snap->base + sizeof(SnapshotHeader));
+   snap->buckets = (const uint32_t *)(snap->records + snap->header->table.recordCount);
+   return snap;
+}
+
+static atomic<bool> snapshotEnabled(false);
+static atomic<bool> snapshotConfigured(false);   /**< setRFCSnapshotEnabled() was called; the env var is ignored. */
+static once_flag snapshotEnvOnce;
+
+static mutex snapshotMutex;                      /**< Serialises remapping. */
+static shared_ptr<SnapshotMap> currentSnapshot;  /**< Accessed with atomic_load()/atomic_store(). */
+static SnapshotClock::time_point retryAt;        /**< Guarded by snapshotMutex. */
+
+/** @brief Apply RFC_SNAPSHOT unless setRFCSnapshotEnabled() was already called. */
+static void readSnapshotEnv()
+{
+   call_once(snapshotEnvOnce, []() {
+      const char *env = getenv(RFC_SNAPSHOT_ENV);
+      if (env && strcmp(env, "1") == 0 && !snapshotConfigured.load())
+      {
+         snapshotEnabled.store(true);
+         rfcWatchStart();
+         RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: snapshot reads enabled from %s\n", __FUNCTION__, RFC_SNAPSHOT_ENV);
+      }
+   });
+}
+
+/**
+ * @brief Current snapshot if it can be trusted at store generation @p generation.
+ *
+ * The fast path is a handful of atomic loads. The mapping is replaced only
+ * when the publisher marked it superseded, and the store files are compared
+ * with the snapshot's stamps only when the store generation moved.
+ */
+static shared_ptr<SnapshotMap> trustedSnapshot(unsigned long generation)
+{
+   shared_ptr<SnapshotMap> snap = atomic_load(&currentSnapshot);
+   if (snap && !snap->superseded() && snap->checkedGeneration.load(memory_order_acquire) == generation)
+      return snap->trusted.load(memory_order_relaxed) ? snap : shared_ptr<SnapshotMap>();
+
+   lock_guard<mutex> lock(snapshotMutex);
+   snap = atomic_load(&currentSnapshot);
+   if (!snap || snap->superseded())
+   {
+      SnapshotClock::time_point now = SnapshotClock::now();
+      if (!snap && now < retryAt)
+         return shared_ptr<SnapshotMap>();
+      snap = SnapshotMap::open(RFC_SNAPSHOT_FILE);
+      atomic_store(&currentSnapshot, snap);
+      if (!snap)
+      {
+         retryAt = now + chrono::milliseconds(SNAPSHOT_RETRY_INTERVAL);
+         return snap;
+      }
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: mapped snapshot %llu\n", __FUNCTION__, (unsigned long long)snap->sequence());
+   }
+   if (snap->checkedGeneration.load(memory_order_relaxed) != generation)
+   {
+      bool trusted = snap->storesUnchanged();
+      if (!trusted && snap->trusted.load(memory_order_relaxed))
+         RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: store changed since snapshot %llu, using hostif\n", __FUNCTION__, (unsigned long long)snap->sequence());
+      snap->trusted.store(trusted, memory_order_relaxed);
+      snap->checkedGeneration.store(generation, memory_order_release);
+   }
+   return snap->trusted.load(memory_order_relaxed) ? snap : shared_ptr<SnapshotMap>();
+}
+
+bool rfcSnapshotLookupValue(const char *name, char *value, size_t capacity, size_t *length, DATA_TYPE *type)
+{
+   readSnapshotEnv();
+   if (!snapshotEnabled.load(memory_order_relaxed))
+      return false;
+   if (strncmp(name, TR181_RFC_PREFIX ".", sizeof(TR181_RFC_PREFIX)) != 0)
+      return false;
+   // Without the watch a local set or a hostif write would go unnoticed.
+   if (!rfcWatchArmed())
+      return false;
+
+   shared_ptr<SnapshotMap> snap = trustedSnapshot(rfcStoreGeneration());
+   if (!snap)
+      return false;
+   long i = snap->find(name, strlen(name));
+   if (i < 0)
+      return false;
+   const SnapshotRecord &rec = snap->record(i);
+   *length = rfcCopyValue(value, capacity, snap->text(rec.text.valueOffset), rec.text.valueLen);
+   *type = (DATA_TYPE)rec.type;
+   return true;
+}
+
+void setRFCSnapshotEnabled(bool enable)
+{
+   snapshotConfigured.store(true);
+   snapshotEnabled.store(enable);
+   if (enable)
+      rfcWatchStart();
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: snapshot reads %s\n", __FUNCTION__, enable ? "enabled" : "disabled");
+}
+
+/** Parameter collected for publishing. */
+struct SnapshotEntry
+{
+   string name;
+   string value;
+   DATA_TYPE type;
+};
+
+static bool entryLess(const SnapshotEntry &a, const SnapshotEntry &b)
+{
+   return a.name < b.name;
+}
+
+static void collectSnapshotEntry(const RFC_ParamData_t *pstParam, void *pUserData)
+{
+   // Only hostif reports types; store-file answers (WDMP_NONE) must not be published.
+   if (pstParam->type == WDMP_NONE)
+      return;
+   SnapshotEntry entry;
+   entry.name = pstParam->name;
+   entry.value = pstParam->value;
+   entry.type = pstParam->type;
+   ((vector<SnapshotEntry> *)pUserData)->push_back(entry);
+}
+
+WDMP_STATUS publishRFCSnapshot(const char *pcCallerID)
+{
+   if (!rfcHostifReady())
+   {
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: hostif not ready, snapshot not published\n", __FUNCTION__);
+      return WDMP_FAILURE;
+   }
+
+   // Stamp the store files before reading, so a write racing with the read leaves the snapshot untrusted.
+   SnapshotHeader header;
+   memset(&header, 0, sizeof(header));
+   for (size_t i = 0; i < STAMPED_FILE_COUNT; i++)
+      stampFile(stampedFiles[i], &header.stamps[i]);
+
+   vector<SnapshotEntry> entries;
+   WDMP_STATUS ret = getRFCParameterTree(pcCallerID, TR181_RFC_PREFIX ".", collectSnapshotEntry, &entries);
+   if (ret != WDMP_SUCCESS || entries.empty())
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: could not read %s. from hostif, status=%d\n", __FUNCTION__, TR181_RFC_PREFIX, ret);
+      return ret != WDMP_SUCCESS ? ret : WDMP_FAILURE;
+   }
+   stable_sort(entries.begin(), entries.end(), entryLess);
+   size_t kept = 0;
+   for (size_t i = 0; i < entries.size(); i++)
+   {
+      if (kept > 0 && entries[kept - 1].name == entries[i].name)
+         continue;
+      if (kept != i)
+         entries[kept] = entries[i];
+      kept++;
+   }
+   entries.resize(kept);
+
+   uint32_t bucketCount = 8;
+   while (bucketCount < entries.size() * 2)
+      bucketCount <<= 1;
+   size_t stringsOffset = sizeof(SnapshotHeader) + entries.size() * sizeof(SnapshotRecord) + bucketCount * sizeof(uint32_t);
+
+   string blob;
+   vector<SnapshotRecord> records(entries.size());
+   vector<uint32_t> buckets(bucketCount, 0);
+   for (size_t i = 0; i < entries.size(); i++)
+   {
+      SnapshotRecord &rec = records[i];
+      rec.text.nameOffset = (uint32_t)(stringsOffset + blob.size());
+      rec.text.nameLen = (uint32_t)entries[i].name.size();
+      blob.append(entries[i].name);
+      rec.text.valueOffset = (uint32_t)(stringsOffset + blob.size());
+      rec.text.valueLen = (uint32_t)entries[i].value.size();
+      blob.append(entries[i].value);
+      rec.hash = rfcHash(entries[i].name.data(), entries[i].name.size());
+      rec.type = (int32_t)entries[i].type;
+      uint32_t b = rec.hash & (bucketCount - 1);
+      while (buckets[b] != 0)
+         b = (b + 1) & (bucketCount - 1);
+      buckets[b] = (uint32_t)i + 1;
+   }
+
+   if (!rfcSnapshotDirSafe())
+      return WDMP_FAILURE;
+   // Held across the rename so the replaced file can be marked superseded for readers still mapping it.
+   // Only a snapshot this code published is ever written to.
+   int oldFd = open(RFC_SNAPSHOT_FILE, O_RDWR | O_NOFOLLOW | O_CLOEXEC);
+   struct stat oldSt;
+   SnapshotHeader oldHeader;
+   if (oldFd >= 0 && (fstat(oldFd, &oldSt) != 0 || !rfcPublishedByRoot(oldSt) ||
+                      pread(oldFd, &oldHeader, sizeof(oldHeader), 0) != (ssize_t)sizeof(oldHeader) ||
+                      memcmp(oldHeader.table.magic, SNAPSHOT_MAGIC, 4) != 0 || oldHeader.table.version != SNAPSHOT_VERSION))
+   {
+      close(oldFd);
+      oldFd = -1;
+   }
+   header.sequence = oldFd >= 0 ? oldHeader.sequence + 1 : 1;
+
+   memcpy(header.table.magic, SNAPSHOT_MAGIC, 4);
+   header.table.version = SNAPSHOT_VERSION;
+   header.table.fileSize = (uint32_t)(stringsOffset + blob.size());
+   header.table.recordCount = (uint32_t)entries.size();
+   header.table.bucketCount = bucketCount;
+   header.table.stringsOffset = (uint32_t)stringsOffset;
+
+   string image;
+   image.reserve(header.table.fileSize);
+   image.append((const char *)&header, sizeof(header));
+   if (!records.empty())
+      image.append((const char *)&records[0], records.size() * sizeof(SnapshotRecord));
+   image.append((const char *)&buckets[0], buckets.size() * sizeof(uint32_t));
+   image.append(blob);
+
+   bool ok = rfcPublishFile(RFC_SNAPSHOT_FILE, image);
+   if (oldFd >= 0)
+   {
+      if (ok)
+      {
+         uint32_t superseded = 1;
+         if (pwrite(oldFd, &superseded, sizeof(superseded), offsetof(SnapshotHeader, superseded)) != (ssize_t)sizeof(superseded))
+            RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot mark the previous snapshot superseded: %s\n", __FUNCTION__, strerror(errno));
+      }
+      close(oldFd);
+   }
+   if (!ok)
+      return WDMP_FAILURE;
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: published snapshot %llu with %zu parameters\n", __FUNCTION__, (unsigned long long)header.sequence, entries.size());
+   return WDMP_SUCCESS;
+}
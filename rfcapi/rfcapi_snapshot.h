@@ -0,0 +1,44 @@
+/**
+ * @file rfcapi_snapshot.h
+ * @brief Internal reader of the applied-parameter snapshot published by rfcMgr.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_SNAPSHOT_H_
+#define RFCAPI_SNAPSHOT_H_
+
+#include "rfcapi.h"
+
+/**
+ * @brief Serve an RFC parameter from the mapped snapshot.
+ *
+ * Only names under TR181_RFC_PREFIX are answered. Once the snapshot is
+ * mapped and checked against the current store generation, a lookup is a
+ * few atomic loads and one hash probe, with no system calls.
+ * @param[in]  name      TR181 parameter name.
+ * @param[out] value     Value, NUL-terminated and truncated to @p capacity.
+ * @param[in]  capacity  Size of @p value.
+ * @param[out] length    Full value length, excluding the NUL.
+ * @param[out] type      Data type hostif reported when the snapshot was taken.
+ * @retval true  Answered.
+ * @retval false Snapshot reads disabled, no trusted snapshot, or @p name not in it.
+ */
+bool rfcSnapshotLookupValue(const char *name, char *value, size_t capacity, size_t *length, DATA_TYPE *type);
+
+#endif
@@ -0,0 +1,361 @@
+/**
+ * @file rfcapi_stats.cpp
+ * @brief Lock-free per-caller call counters in a shared memory segment.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "rfcapi_stats.h"
+#include "rfcapi_internal.h"
+#include "rdk_debug.h"
+using namespace std;
+
+/*
+ * Segment layout (host byte order, the segment never leaves the device):
+ *
+ *   StatsHeader
+ *   StatsSlot[RFC_STATS_SLOTS]   open-addressing table keyed by (callerID, op)
+ *
+ * Every process with statistics enabled maps the same segment. A slot is
+ * claimed once with a compare-and-swap on its state and never released;
+ * after that its counters are only ever incremented with relaxed atomics, so
+ * neither writers nor readers take a lock.
+ */
+
+#define RFC_STATS_MAGIC   0x54534652u   /* "RFST" */
+/** The segment is shared by every uid that links librfcapi. */
+#define RFC_STATS_MODE    0666
+#define RFC_STATS_VERSION 1u
+#define RFC_STATS_SLOTS   256
+/** Spins on a slot another process is claiming before treating it as foreign. */
+#define RFC_STATS_CLAIM_SPINS 1000
+
+enum SlotState
+{
+   SLOT_EMPTY = 0,
+   SLOT_CLAIMING,
+   SLOT_READY
+};
+
+struct StatsSlot
+{
+   atomic<uint32_t> state;
+   uint32_t op;
+   char callerID[RFC_STATS_CALLER_LEN];
+   atomic<uint64_t> calls;
+   atomic<uint64_t> hostif;
+   atomic<uint64_t> file;
+   atomic<uint64_t> memory;
+   atomic<uint64_t> errors;
+   atomic<uint64_t> totalUs;
+   atomic<uint64_t> latency[RFC_STATS_LATENCY_BUCKETS];
+};
+
+struct StatsHeader
+{
+   atomic<uint32_t> magic;
+   uint32_t version;
+   uint32_t slotCount;
+   uint32_t bucketCount;
+   atomic<uint64_t> dropped;   /**< Calls not counted because the table was full. */
+};
+
+struct StatsSegment
+{
+   StatsHeader header;
+   StatsSlot slots[RFC_STATS_SLOTS];
+};
+
+/** -1 = not decided yet, 0 = off, 1 = on. */
+static atomic<int> statsState(-1);
+static mutex segmentMutex;
+static StatsSegment *segment = NULL;
+static bool segmentFailed = false;
+static thread_local RfcStatsSource *currentSource = NULL;
+
+static uint32_t hashKey(const char *callerID, uint32_t op)
+{
+   return rfcHash(callerID, strlen(callerID), RFC_HASH_SEED ^ op);
+}
+
+/**
+ * @brief Map the segment, creating it if this is the first process to count.
+ * @param[in] create  false to only attach to an existing segment (readers).
+ * @return The segment, or NULL.
+ */
+static StatsSegment *mapSegment(bool create)
+{
+   int fd = -1;
+   if (create)
+   {
+      // Components run under different uids and all count into the same
+      // segment, so whoever creates it opens it to everyone, past the umask.
+      fd = shm_open(RFC_STATS_SEGMENT, O_RDWR | O_CREAT | O_EXCL, RFC_STATS_MODE);
+      if (fd >= 0)
+         fchmod(fd, RFC_STATS_MODE);
+      else if (errno == EEXIST)
+         fd = shm_open(RFC_STATS_SEGMENT, O_RDWR, 0);
+   }
+   else
+   {
+      fd = shm_open(RFC_STATS_SEGMENT, O_RDONLY, 0);
+   }
+   if (fd < 0)
+      return NULL;
+   struct stat st;
+   if (fstat(fd, &st) != 0 || (st.st_size < (off_t)sizeof(StatsSegment) && (!create || ftruncate(fd, sizeof(StatsSegment)) != 0)))
+   {
+      close(fd);
+      return NULL;
+   }
+   void *addr = mmap(NULL, sizeof(StatsSegment), create ? (PROT_READ | PROT_WRITE) : PROT_READ, MAP_SHARED, fd, 0);
+   close(fd);
+   if (addr == MAP_FAILED)
+      return NULL;
+
+   StatsSegment *seg = (StatsSegment *)addr;
+   if (create && seg->header.magic.load(memory_order_acquire) == 0)
+   {
+      // ftruncate() zero-fills. Concurrent creators write the same layout
+      // fields, and the magic is published last.
+      seg->header.version = RFC_STATS_VERSION;
+      seg->header.slotCount = RFC_STATS_SLOTS;
+      seg->header.bucketCount = RFC_STATS_LATENCY_BUCKETS;
+      uint32_t expected = 0;
+      seg->header.magic.compare_exchange_strong(expected, RFC_STATS_MAGIC, memory_order_acq_rel);
+   }
+   // Counters shared between processes must not fall back to process-local locks.
+   if (seg->header.magic.load(memory_order_acquire) != RFC_STATS_MAGIC || seg->header.version != RFC_STATS_VERSION ||
+       seg->header.slotCount != RFC_STATS_SLOTS || seg->header.bucketCount != RFC_STATS_LATENCY_BUCKETS ||
+       !seg->header.dropped.is_lock_free())
+   {
+      munmap(addr, sizeof(StatsSegment));
+      return NULL;
+   }
+   return seg;
+}
+
+static StatsSegment *writableSegment()
+{
+   lock_guard<mutex> lock(segmentMutex);
+   if (segment == NULL && !segmentFailed)
+   {
+      segment = mapSegment(true);
+      if (segment == NULL)
+      {
+         segmentFailed = true;
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot map %s, errno=%d. Call statistics disabled\n", __FUNCTION__, RFC_STATS_SEGMENT, errno);
+      }
+   }
+   return segment;
+}
+
+/** @brief Find or claim the slot of (@p callerID, @p op); NULL if the table is full. */
+static StatsSlot *findSlot(StatsSegment *seg, const char *callerID, RFC_StatsOp_t op)
+{
+   char key[RFC_STATS_CALLER_LEN];
+   strncpy(key, callerID, sizeof(key));
+   key[sizeof(key) - 1] = '\0';
+   uint32_t start = hashKey(key, op) % RFC_STATS_SLOTS;
+   for (uint32_t i = 0; i < RFC_STATS_SLOTS; i++)
+   {
+      StatsSlot &slot = seg->slots[(start + i) % RFC_STATS_SLOTS];
+      uint32_t state = slot.state.load(memory_order_acquire);
+      if (state == SLOT_EMPTY)
+      {
+         uint32_t expected = SLOT_EMPTY;
+         if (slot.state.compare_exchange_strong(expected, SLOT_CLAIMING, memory_order_acq_rel))
+         {
+            slot.op = op;
+            memcpy(slot.callerID, key, sizeof(key));
+            slot.state.store(SLOT_READY, memory_order_release);
+            return &slot;
+         }
+         state = expected;
+      }
+      // A process that died while claiming leaves the slot unusable, not the table stuck.
+      for (int spin = 0; state == SLOT_CLAIMING && spin < RFC_STATS_CLAIM_SPINS; spin++)
+      {
+         sched_yield();
+         state = slot.state.load(memory_order_acquire);
+      }
+      if (state == SLOT_READY && slot.op == (uint32_t)op && strcmp(slot.callerID, key) == 0)
+         return &slot;
+   }
+   return NULL;
+}
+
+/** @brief Latency bucket: i holds [2^i, 2^(i+1)) microseconds, the last one everything above. */
+static unsigned latencyBucket(uint64_t us)
+{
+   unsigned bucket = 0;
+   while (us > 1 && bucket < RFC_STATS_LATENCY_BUCKETS - 1)
+   {
+      us >>= 1;
+      bucket++;
+   }
+   return bucket;
+}
+
+bool rfcStatsEnabled()
+{
+   int state = statsState.load(memory_order_acquire);
+   if (state < 0)
+   {
+      const char *env = getenv("RFC_STATS");
+      bool enable = (env != NULL && strcmp(env, "1") == 0) || access(RFC_STATS_ENABLE_FILE, F_OK) == 0;
+      int expected = -1;
+      statsState.compare_exchange_strong(expected, enable ? 1 : 0);
+      state = statsState.load(memory_order_acquire);
+   }
+   return state == 1;
+}
+
+void setRFCStatsEnabled(bool enable)
+{
+   statsState.store(enable ? 1 : 0, memory_order_release);
+}
+
+void rfcStatsRecord(const char *callerID, RFC_StatsOp_t op, RfcStatsSource source, WDMP_STATUS status,
+                    chrono::steady_clock::time_point started)
+{
+   if (!rfcStatsEnabled() || (unsigned)op >= RFC_STATS_OP_COUNT)
+      return;
+   uint64_t us = chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - started).count();
+   StatsSegment *seg = writableSegment();
+   if (seg == NULL)
+      return;
+
+   // Callers normally use one ID from one thread; remember the last slot to skip the probe.
+   static thread_local StatsSlot *lastSlot = NULL;
+   if (callerID == NULL)
+      callerID = "Unknown";
+   StatsSlot *slot = lastSlot;
+   if (slot == NULL || slot->op != (uint32_t)op || strncmp(slot->callerID, callerID, RFC_STATS_CALLER_LEN - 1) != 0)
+   {
+      slot = findSlot(seg, callerID, op);
+      if (slot == NULL)
+      {
+         seg->header.dropped.fetch_add(1, memory_order_relaxed);
+         return;
+      }
+      lastSlot = slot;
+   }
+
+   slot->calls.fetch_add(1, memory_order_relaxed);
+   if (source == RFC_STATS_FROM_HOSTIF)
+      slot->hostif.fetch_add(1, memory_order_relaxed);
+   else if (source == RFC_STATS_FROM_FILE)
+      slot->file.fetch_add(1, memory_order_relaxed);
+   else
+      slot->memory.fetch_add(1, memory_order_relaxed);
+   if (status != WDMP_SUCCESS && status != WDMP_ERR_DEFAULT_VALUE)
+      slot->errors.fetch_add(1, memory_order_relaxed);
+   slot->totalUs.fetch_add(us, memory_order_relaxed);
+   slot->latency[latencyBucket(us)].fetch_add(1, memory_order_relaxed);
+}
+
+void rfcStatsNote(RfcStatsSource source)
+{
+   if (currentSource != NULL && source > *currentSource)
+      *currentSource = source;
+}
+
+RfcStatsTrace::RfcStatsTrace(RfcStatsSource &source) : previous_(currentSource)
+{
+   if (previous_ == NULL)
+      currentSource = &source;
+}
+
+RfcStatsTrace::~RfcStatsTrace()
+{
+   if (previous_ == NULL)
+      currentSource = NULL;
+}
+
+RfcStatsScope::RfcStatsScope(const char *callerID, RFC_StatsOp_t op)
+   : callerID_(callerID), op_(op), active_(false), status_(WDMP_FAILURE), source_(RFC_STATS_FROM_MEMORY), previous_(currentSource)
+{
+   if (previous_ == NULL && rfcStatsEnabled())
+   {
+      active_ = true;
+      started_ = chrono::steady_clock::now();
+      currentSource = &source_;
+   }
+}
+
+RfcStatsScope::~RfcStatsScope()
+{
+   if (!active_)
+      return;
+   currentSource = NULL;
+   rfcStatsRecord(callerID_, op_, source_, status_, started_);
+}
+
+WDMP_STATUS getRFCCallerStats(RFC_CallerStatsCallback_t callback, void *pUserData)
+{
+   if (callback == NULL)
+      return WDMP_ERR_INVALID_PARAM;
+   StatsSegment *seg = mapSegment(false);
+   if (seg == NULL)
+   {
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: no statistics segment %s\n", __FUNCTION__, RFC_STATS_SEGMENT);
+      return WDMP_FAILURE;
+   }
+
+   RFC_CallerStats_t stats;
+   for (size_t i = 0; i < RFC_STATS_SLOTS; i++)
+   {
+      const StatsSlot &slot = seg->slots[i];
+      if (slot.state.load(memory_order_acquire) != SLOT_READY)
+         continue;
+      memset(&stats, 0, sizeof(stats));
+      memcpy(stats.callerID, slot.callerID, sizeof(stats.callerID));
+      stats.callerID[sizeof(stats.callerID) - 1] = '\0';
+      stats.op = (RFC_StatsOp_t)slot.op;
+      stats.calls = slot.calls.load(memory_order_relaxed);
+      stats.hostif = slot.hostif.load(memory_order_relaxed);
+      stats.file = slot.file.load(memory_order_relaxed);
+      stats.memory = slot.memory.load(memory_order_relaxed);
+      stats.errors = slot.errors.load(memory_order_relaxed);
+      stats.totalUs = slot.totalUs.load(memory_order_relaxed);
+      for (size_t b = 0; b < RFC_STATS_LATENCY_BUCKETS; b++)
+         stats.latency[b] = slot.latency[b].load(memory_order_relaxed);
+      callback(&stats, pUserData);
+   }
+   munmap(seg, sizeof(StatsSegment));
+   return WDMP_SUCCESS;
+}
+
+const char *getRFCStatsOpName(RFC_StatsOp_t op)
+{
+   static const char *names[RFC_STATS_OP_COUNT] = { "get", "getMulti", "getTree", "set", "setMulti", "getAsync", "setAsync" };
+   return (unsigned)op < RFC_STATS_OP_COUNT ? names[op] : "unknown";
+}
@@ -0,0 +1,116 @@
+/**
+ * @file rfcapi_stats.h
+ * @brief Internal per-caller call counters, published in shared memory.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_STATS_H_
+#define RFCAPI_STATS_H_
+
+#include <chrono>
+#include "rfcapi.h"
+
+/** @brief Where a call got its answer, in increasing order of precedence. */
+enum RfcStatsSource
+{
+   RFC_STATS_FROM_MEMORY = 0,   /**< Cache or snapshot; no I/O. */
+   RFC_STATS_FROM_HOSTIF,       /**< A hostif request. */
+   RFC_STATS_FROM_FILE          /**< The local store files, as fallback. */
+};
+
+/**
+ * @brief Whether calls are being counted.
+ *
+ * Decided on first use from RFC_STATS and RFC_STATS_ENABLE_FILE, or set with
+ * setRFCStatsEnabled(). One atomic load afterwards.
+ */
+bool rfcStatsEnabled();
+
+/**
+ * @brief Count one finished call.
+ * @param[in] callerID  Caller identifier; NULL counts as "Unknown".
+ * @param[in] op        Operation.
+ * @param[in] source    Where the answer came from.
+ * @param[in] status    Result of the call.
+ * @param[in] started   When the call started.
+ */
+void rfcStatsRecord(const char *callerID, RFC_StatsOp_t op, RfcStatsSource source, WDMP_STATUS status,
+                    std::chrono::steady_clock::time_point started);
+
+/** @brief Report that the current call used @p source; no-op outside an RfcStatsTrace. */
+void rfcStatsNote(RfcStatsSource source);
+
+/**
+ * @class RfcStatsTrace
+ * @brief Collect rfcStatsNote() reports made on this thread into @p source.
+ *
+ * Only the outermost trace on a thread collects, so public calls made from
+ * inside another one are attributed to the outer call.
+ */
+class RfcStatsTrace
+{
+public:
+   explicit RfcStatsTrace(RfcStatsSource &source);
+   ~RfcStatsTrace();
+
+private:
+   RfcStatsTrace(const RfcStatsTrace &);
+   RfcStatsTrace &operator=(const RfcStatsTrace &);
+
+   RfcStatsSource *previous_;
+};
+
+/**
+ * @class RfcStatsScope
+ * @brief Times and counts one synchronous public call.
+ *
+ * @code
+ * RfcStatsScope stats(pcCallerID, RFC_STATS_GET);
+ * ...
+ * return stats.done(ret);
+ * @endcode
+ * Costs one atomic load when statistics are off.
+ */
+class RfcStatsScope
+{
+public:
+   RfcStatsScope(const char *callerID, RFC_StatsOp_t op);
+   ~RfcStatsScope();
+
+   /** @brief Set the status to record, and pass it through. */
+   WDMP_STATUS done(WDMP_STATUS status)
+   {
+      status_ = status;
+      return status;
+   }
+
+private:
+   RfcStatsScope(const RfcStatsScope &);
+   RfcStatsScope &operator=(const RfcStatsScope &);
+
+   const char *callerID_;
+   RFC_StatsOp_t op_;
+   bool active_;
+   WDMP_STATUS status_;
+   RfcStatsSource source_;
+   std::chrono::steady_clock::time_point started_;
+   RfcStatsSource *previous_;
+};
+
+#endif
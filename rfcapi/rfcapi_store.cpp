@@ -0,0 +1,332 @@
+/**
+ * @file rfcapi_store.cpp
+ * @brief Hashed, change-aware index over the pre-hostif RFC store files.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include <sys/stat.h>
+#include "rfcapi_store.h"
+#include "rfcapi_defaults.h"
+#include "rfcapi_internal.h"
+#include "rfcapi_stats.h"
+#include "rdk_debug.h"
+using namespace std;
+
+/** Identity of a store file at the time it was indexed. */
+struct FileStamp
+{
+   bool exists;
+   dev_t dev;
+   ino_t ino;
+   off_t size;
+   struct timespec mtime;
+};
+
+/** Non-owning view into a loaded file buffer. */
+struct StrRef
+{
+   const char *ptr;
+   size_t len;
+};
+
+struct StrRefHash
+{
+   size_t operator()(const StrRef &s) const
+   {
+      return rfcHash(s.ptr, s.len);
+   }
+};
+
+struct StrRefEqual
+{
+   bool operator()(const StrRef &a, const StrRef &b) const
+   {
+      return a.len == b.len && memcmp(a.ptr, b.ptr, a.len) == 0;
+   }
+};
+
+static bool strRefLess(const StrRef &a, const StrRef &b)
+{
+   int c = memcmp(a.ptr, b.ptr, min(a.len, b.len));
+   return c < 0 || (c == 0 && a.len < b.len);
+}
+
+struct StoreEntry
+{
+   StrRef value;
+   WDMP_STATUS status;   /**< WDMP_SUCCESS or WDMP_ERR_VALUE_IS_EMPTY. */
+};
+
+typedef unordered_map<StrRef, StoreEntry, StrRefHash, StrRefEqual> StoreMap;
+
+/**
+ * @brief One lookup chain: a list of files in priority order merged into a
+ *        single hash index, so resolving a name costs one probe.
+ */
+struct StoreIndex
+{
+   StoreIndex(const char *const *paths, size_t count) : paths(paths), count(count), loaded(false) {}
+
+   const char *const *paths;
+   size_t count;
+   bool loaded;
+   vector<FileStamp> stamps;
+   vector<string> buffers;   /**< File contents; StrRefs point into these. */
+   shared_ptr<const RfcDefaultsSnapshot> defaults;   /**< Mapped last layer of the chain, if compiled. */
+   StoreMap byName;
+   vector<StrRef> sorted;    /**< Names with a non-empty value, in name order. */
+};
+
+/**
+ * tr181store.ini, then bootstrap.ini, then rfcdefaults.ini - the order getRFCParameter() falls back in.
+ * The compiled rfcdefaults snapshot stands in for the last file whenever it is available.
+ */
+static const char *const chainFiles[] = { TR181STORE_FILE, BOOTSTRAP_FILE, RFCDEFAULTS_FILE };
+/** RFC_xxxx shell variables live in their own file. */
+static const char *const varFiles[] = { RFCVAR_FILE };
+
+static mutex storeMutex;
+static StoreIndex chainIndex(chainFiles, sizeof(chainFiles) / sizeof(chainFiles[0]));
+static StoreIndex varIndex(varFiles, sizeof(varFiles) / sizeof(varFiles[0]));
+
+static FileStamp stampFile(const char *path)
+{
+   FileStamp stamp;
+   struct stat st;
+   memset(&stamp, 0, sizeof(stamp));
+   if (stat(path, &st) == 0)
+   {
+      stamp.exists = true;
+      stamp.dev = st.st_dev;
+      stamp.ino = st.st_ino;
+      stamp.size = st.st_size;
+      stamp.mtime = st.st_mtim;
+   }
+   return stamp;
+}
+
+static bool sameStamp(const FileStamp &a, const FileStamp &b)
+{
+   return a.exists == b.exists && a.dev == b.dev && a.ino == b.ino && a.size == b.size &&
+          a.mtime.tv_sec == b.mtime.tv_sec && a.mtime.tv_nsec == b.mtime.tv_nsec;
+}
+
+/**
+ * @brief Merge one name into @p index.
+ *
+ * A non-empty value from a higher-priority layer wins; an empty one lets the
+ * next layer supply the name, and only reports WDMP_ERR_VALUE_IS_EMPTY from
+ * the last layer.
+ */
+static void mergeEntry(const StrRef &key, const StrRef &value, bool lastLayer, StoreIndex &index)
+{
+   StoreMap::iterator it = index.byName.find(key);
+   if (value.len > 0)
+   {
+      if (it == index.byName.end())
+      {
+         StoreEntry entry = { value, WDMP_SUCCESS };
+         index.byName.insert(make_pair(key, entry));
+      }
+      else if (it->second.status != WDMP_SUCCESS)
+      {
+         it->second.value = value;
+         it->second.status = WDMP_SUCCESS;
+      }
+   }
+   else if (lastLayer && it == index.byName.end())
+   {
+      StoreEntry entry = { value, WDMP_ERR_VALUE_IS_EMPTY };
+      index.byName.insert(make_pair(key, entry));
+   }
+}
+
+/**
+ * @brief Merge one loaded file into @p index.
+ *
+ * Each line is split at its first '=', after dropping a leading word such as
+ * "export" before the key, and only the first occurrence of a name in a file
+ * counts.
+ */
+static void indexBuffer(const string &buffer, bool lastFile, StoreIndex &index)
+{
+   unordered_set<StrRef, StrRefHash, StrRefEqual> seen;
+   const char *p = buffer.data();
+   const char *end = p + buffer.size();
+   while (p < end)
+   {
+      const char *eol = (const char *)memchr(p, '\n', end - p);
+      if (eol == NULL)
+         eol = end;
+
+      const char *eq = (const char *)memchr(p, '=', eol - p);
+      if (eq != NULL)
+      {
+         // Skip any export word that may be before the key (rfcVariable.ini).
+         const char *start = p;
+         for (const char *q = p; q < eq; q++)
+         {
+            if (*q == ' ' || *q == '\t')
+            {
+               start = q + 1;
+               break;
+            }
+         }
+         StrRef key = { start, (size_t)(eq - start) };
+         StrRef value = { eq + 1, (size_t)(eol - eq - 1) };
+         if (seen.insert(key).second)
+            mergeEntry(key, value, lastFile, index);
+      }
+      p = eol + 1;
+   }
+}
+
+/** @brief Merge the winning record of each name in the compiled defaults snapshot. */
+static void indexSnapshot(const RfcDefaultsSnapshot &defaults, StoreIndex &index)
+{
+   for (size_t i = 0; i < defaults.count(); i++)
+   {
+      if (!defaults.isWinner(i))
+         continue;
+      StrRef key, value;
+      defaults.record(i, &key.ptr, &key.len, &value.ptr, &value.len);
+      mergeEntry(key, value, true, index);
+   }
+}
+
+/** @brief Rebuild @p index if any of its layers changed since it was built. Caller holds storeMutex. */
+static void refreshLocked(StoreIndex &index)
+{
+   shared_ptr<const RfcDefaultsSnapshot> defaults;
+   size_t textCount = index.count;
+   if (index.paths == chainFiles)
+   {
+      // Compiles the snapshot on first use; the text file is only read if that fails.
+      defaults = rfcDefaultsCurrent(NULL);
+      if (defaults)
+         textCount = index.count - 1;
+   }
+
+   vector<FileStamp> stamps(index.count);
+   for (size_t i = 0; i < textCount; i++)
+      stamps[i] = stampFile(index.paths[i]);
+
+   if (index.loaded && defaults == index.defaults)
+   {
+      bool changed = false;
+      for (size_t i = 0; i < index.count && !changed; i++)
+         changed = !sameStamp(stamps[i], index.stamps[i]);
+      if (!changed)
+         return;
+   }
+
+   index.byName.clear();
+   index.sorted.clear();
+   index.buffers.assign(index.count, string());
+   // Read rather than mmap'd: hostif and rfcMgr rewrite these files in place,
+   // and a truncation under a live mapping would SIGBUS readers.
+   for (size_t i = 0; i < textCount; i++)
+   {
+      if (stamps[i].exists && rfcReadFile(index.paths[i], index.buffers[i]))
+         indexBuffer(index.buffers[i], i == index.count - 1, index);
+   }
+   if (defaults)
+      indexSnapshot(*defaults, index);
+   for (StoreMap::const_iterator it = index.byName.begin(); it != index.byName.end(); ++it)
+   {
+      if (it->second.status == WDMP_SUCCESS)
+         index.sorted.push_back(it->first);
+   }
+   sort(index.sorted.begin(), index.sorted.end(), strRefLess);
+   index.stamps.swap(stamps);
+   index.defaults = defaults;
+   index.loaded = true;
+   RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: indexed %zu parameters from %s\n", __FUNCTION__, index.byName.size(), index.paths[0]);
+}
+
+WDMP_STATUS rfcStoreLookupValue(const char *pcParameterName, char *pcValue, size_t capacity, size_t *pLength)
+{
+   rfcStatsNote(RFC_STATS_FROM_FILE);
+   bool isVariable = strncmp(pcParameterName, "RFC_", 4) == 0 && strchr(pcParameterName, '.') == NULL;
+   StoreIndex &index = isVariable ? varIndex : chainIndex;
+   StrRef key = { pcParameterName, strlen(pcParameterName) };
+
+   lock_guard<mutex> lock(storeMutex);
+   refreshLocked(index);
+   StoreMap::const_iterator it = index.byName.find(key);
+   if (it == index.byName.end())
+      return WDMP_FAILURE;
+   if (it->second.status != WDMP_SUCCESS)
+      return it->second.status;
+
+   *pLength = rfcCopyValue(pcValue, capacity, it->second.value.ptr, it->second.value.len);
+   RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "Found Key = %s : Value = %.*s\n", pcParameterName, (int)it->second.value.len, it->second.value.ptr);
+   return WDMP_SUCCESS;
+}
+
+WDMP_STATUS rfcStoreLookup(const char *pcParameterName, RFC_ParamData_t *pstParam)
+{
+   size_t length;
+   WDMP_STATUS status = rfcStoreLookupValue(pcParameterName, pstParam->value, MAX_PARAM_LEN, &length);
+   if (status != WDMP_SUCCESS)
+      return status;
+
+   strncpy(pstParam->name, pcParameterName, MAX_PARAM_LEN);
+   pstParam->name[MAX_PARAM_LEN - 1] = '\0';
+   pstParam->type = WDMP_NONE; //The caller must know what type they are expecting if they are requesting a param before the hostif is ready.
+   return WDMP_SUCCESS;
+}
+
+size_t rfcStoreForEach(const char *prefix, RFC_ParamCallback_t callback, void *pUserData)
+{
+   rfcStatsNote(RFC_STATS_FROM_FILE);
+   StrRef key = { prefix, strlen(prefix) };
+   vector<pair<string, string> > matches;
+   {
+      lock_guard<mutex> lock(storeMutex);
+      refreshLocked(chainIndex);
+      for (vector<StrRef>::const_iterator it = lower_bound(chainIndex.sorted.begin(), chainIndex.sorted.end(), key, strRefLess);
+           it != chainIndex.sorted.end() && it->len >= key.len && memcmp(it->ptr, key.ptr, key.len) == 0; ++it)
+      {
+         const StrRef &value = chainIndex.byName.find(*it)->second.value;
+         matches.push_back(make_pair(string(it->ptr, it->len), string(value.ptr, value.len)));
+      }
+   }
+
+   // Callbacks run unlocked so they may call back into librfcapi.
+   RFC_ParamData_t param;
+   for (size_t i = 0; i < matches.size(); i++)
+   {
+      strncpy(param.name, matches[i].first.c_str(), MAX_PARAM_LEN);
+      param.name[MAX_PARAM_LEN - 1] = '\0';
+      strncpy(param.value, matches[i].second.c_str(), MAX_PARAM_LEN);
+      param.value[MAX_PARAM_LEN - 1] = '\0';
+      param.type = WDMP_NONE; // Types are unknown before hostif is ready.
+      callback(&param, pUserData);
+   }
+   return matches.size();
+}
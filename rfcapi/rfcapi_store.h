@@ -0,0 +1,64 @@
+/**
+ * @file rfcapi_store.h
+ * @brief Internal hashed/sorted index over the pre-hostif RFC store files.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_STORE_H_
+#define RFCAPI_STORE_H_
+
+#include "rfcapi.h"
+
+/**
+ * @brief Resolve a parameter from the local store files in one hash probe.
+ *
+ * RFC_xxxx names (no dot) come from rfcVariable.ini. Everything else is
+ * resolved across tr181store.ini, bootstrap.ini and rfcdefaults.ini, in that
+ * priority, with the same results as reading the files one after another.
+ * Each index is rebuilt only when one of its files changes (inode, size or
+ * mtime).
+ * @param[in]  pcParameterName  Parameter name.
+ * @param[out] pstParam         Filled with name/value on success; type is WDMP_NONE.
+ * @return WDMP_SUCCESS, WDMP_ERR_VALUE_IS_EMPTY or WDMP_FAILURE.
+ */
+WDMP_STATUS rfcStoreLookup(const char *pcParameterName, RFC_ParamData_t *pstParam);
+
+/**
+ * @brief rfcStoreLookup() into a caller buffer.
+ * @param[in]  pcParameterName  Parameter name.
+ * @param[out] pcValue          Value, NUL-terminated and truncated to @p capacity.
+ * @param[in]  capacity         Size of @p pcValue.
+ * @param[out] pLength          Full value length, excluding the NUL (set on WDMP_SUCCESS).
+ * @return WDMP_SUCCESS, WDMP_ERR_VALUE_IS_EMPTY or WDMP_FAILURE.
+ */
+WDMP_STATUS rfcStoreLookupValue(const char *pcParameterName, char *pcValue, size_t capacity, size_t *pLength);
+
+/**
+ * @brief Report every parameter under @p prefix from the local store files.
+ *
+ * tr181store.ini, bootstrap.ini and rfcdefaults.ini are merged with the same
+ * priority and parsing rules as rfcStoreLookup(), and share its index.
+ * @param[in] prefix     Parameter name prefix, normally ending in '.'.
+ * @param[in] callback   Invoked once per parameter, in name order.
+ * @param[in] pUserData  Passed through to @p callback.
+ * @return Number of parameters reported.
+ */
+size_t rfcStoreForEach(const char *prefix, RFC_ParamCallback_t callback, void *pUserData);
+
+#endif
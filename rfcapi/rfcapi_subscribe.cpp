@@ -0,0 +1,307 @@
+/**
+ * @file rfcapi_subscribe.cpp
+ * @brief Change notifications for RFC parameters, driven by the store watcher.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include <string.h>
+#include "rfcapi.h"
+#include "rfcapi_store.h"
+#include "rfcapi_localstore.h"
+#include "rfcapi_watch.h"
+#include "rfcapi_internal.h"
+#include "rdk_debug.h"
+using namespace std;
+
+/**
+ * Once the watcher reports a change, wait until the store has been quiet for
+ * this long before diffing, so that rfcMgr's clear/set/ClearDBEnd sequence is
+ * seen as one new configuration rather than a stream of partial ones.
+ */
+#define SUBSCRIBE_SETTLE_MS 200
+/** Upper bound on the settling delay while the store keeps changing. */
+#define SUBSCRIBE_SETTLE_MAX_MS 2000
+/** Idle wait of the dispatcher between changes. */
+#define SUBSCRIBE_IDLE_WAIT_MS 60000
+
+typedef map<string, string> ParamView;
+
+/** @brief One subscribeRFCParameter() registration. */
+struct Subscription
+{
+   RFC_SubscriptionHandle_t handle;
+   string prefix;
+   RFC_ChangeCallback_t callback;
+   void *userData;
+   atomic<bool> active;
+   ParamView storeView;   /**< Last values reported from the RFC store files. */
+   ParamView localView;   /**< Last values reported from the local store. */
+};
+
+typedef shared_ptr<Subscription> SubscriptionPtr;
+
+static atomic<bool> dispatchStarted(false);   /**< A dispatcher thread runs in this process; cleared in a forked child. */
+static mutex startMutex;
+static atomic<unsigned long> nextHandle(1);
+static mutex listMutex;
+static map<RFC_SubscriptionHandle_t, SubscriptionPtr> subscriptions;
+/** Held while views are read and callbacks run; serialises subscribe against a dispatch in progress. */
+static mutex dispatchMutex;
+static thread_local bool onDispatcher = false;
+
+static void collectParam(const RFC_ParamData_t *pstParam, void *pUserData)
+{
+   ((ParamView *)pUserData)->insert(make_pair(string(pstParam->name), string(pstParam->value)));
+}
+
+static ParamView readStoreView(const string &prefix)
+{
+   ParamView view;
+   rfcStoreForEach(prefix.c_str(), collectParam, &view);
+   return view;
+}
+
+/** @brief Current local store: tr181localstore.ini with its journal applied. */
+static ParamView readLocalStore()
+{
+   ParamView view;
+   rfcLocalStoreRead(&view);
+   return view;
+}
+
+static ParamView filterView(const ParamView &all, const string &prefix)
+{
+   ParamView view;
+   for (ParamView::const_iterator it = all.lower_bound(prefix); it != all.end() && it->first.compare(0, prefix.size(), prefix) == 0; ++it)
+      view.insert(*it);
+   return view;
+}
+
+/** @brief Report the differences between @p oldView and @p newView, then adopt @p newView. */
+static void notifyChanges(Subscription &sub, ParamView &oldView, ParamView &newView)
+{
+   ParamView::const_iterator o = oldView.begin();
+   ParamView::const_iterator n = newView.begin();
+   while ((o != oldView.end() || n != newView.end()) && sub.active.load(memory_order_acquire))
+   {
+      if (o == oldView.end() || (n != newView.end() && n->first < o->first))
+      {
+         sub.callback(sub.handle, n->first.c_str(), n->second.c_str(), sub.userData);
+         ++n;
+      }
+      else if (n == newView.end() || o->first < n->first)
+      {
+         sub.callback(sub.handle, o->first.c_str(), NULL, sub.userData);
+         ++o;
+      }
+      else
+      {
+         if (o->second != n->second)
+            sub.callback(sub.handle, n->first.c_str(), n->second.c_str(), sub.userData);
+         ++o;
+         ++n;
+      }
+   }
+   oldView.swap(newView);
+}
+
+/**
+ * @brief Diff every subscription against the files that changed.
+ * @param[in] storeChanged  The RFC store files changed since the last dispatch.
+ * @param[in] localChanged  The local store changed since the last dispatch.
+ */
+static void dispatchChanges(bool storeChanged, bool localChanged)
+{
+   lock_guard<mutex> dispatchLock(dispatchMutex);
+   vector<SubscriptionPtr> subs;
+   {
+      lock_guard<mutex> lock(listMutex);
+      for (map<RFC_SubscriptionHandle_t, SubscriptionPtr>::const_iterator it = subscriptions.begin(); it != subscriptions.end(); ++it)
+         subs.push_back(it->second);
+   }
+   if (subs.empty())
+      return;
+
+   ParamView local;
+   if (localChanged)
+      local = readLocalStore();
+   for (size_t i = 0; i < subs.size(); i++)
+   {
+      Subscription &sub = *subs[i];
+      if (storeChanged)
+      {
+         ParamView view = readStoreView(sub.prefix);
+         notifyChanges(sub, sub.storeView, view);
+      }
+      if (localChanged)
+      {
+         ParamView view = filterView(local, sub.prefix);
+         notifyChanges(sub, sub.localView, view);
+      }
+   }
+}
+
+/** @brief Dispatcher thread body: wait for a change, let it settle, then diff. */
+static void dispatchLoop()
+{
+   onDispatcher = true;
+   // Start from "everything changed": the first subscriber's baseline may
+   // predate this thread, and a diff against it costs one file read.
+   unsigned long sequence = 0;
+   unsigned long storeGeneration = 0;
+   unsigned long localGeneration = 0;
+   for (;;)
+   {
+      unsigned long next = rfcWatchWait(sequence, SUBSCRIBE_IDLE_WAIT_MS);
+      if (next == sequence)
+         continue;
+      chrono::steady_clock::time_point start = chrono::steady_clock::now();
+      do
+      {
+         sequence = next;
+         next = rfcWatchWait(sequence, SUBSCRIBE_SETTLE_MS);
+      } while (next != sequence && chrono::steady_clock::now() - start < chrono::milliseconds(SUBSCRIBE_SETTLE_MAX_MS));
+      sequence = next;
+
+      unsigned long store = rfcStoreGeneration();
+      unsigned long local = rfcLocalStoreGeneration();
+      dispatchChanges(store != storeGeneration, local != localGeneration);
+      storeGeneration = store;
+      localGeneration = local;
+   }
+}
+
+/*
+ * Threads do not survive fork(): the child must not inherit a held lock, and
+ * needs a dispatcher of its own. A fork() from a callback is left alone: the
+ * child then continues on its copy of the dispatcher thread.
+ */
+static void prepareFork()
+{
+   startMutex.lock();
+   if (!onDispatcher)
+      dispatchMutex.lock();
+   listMutex.lock();
+}
+
+static void parentAfterFork()
+{
+   listMutex.unlock();
+   if (!onDispatcher)
+      dispatchMutex.unlock();
+   startMutex.unlock();
+}
+
+static void childAfterFork()
+{
+   listMutex.unlock();
+   if (!onDispatcher)
+   {
+      dispatchMutex.unlock();
+      dispatchStarted.store(false, memory_order_release);
+   }
+   startMutex.unlock();
+}
+
+static bool startDispatcher()
+{
+   if (dispatchStarted.load(memory_order_acquire))
+      return true;
+   lock_guard<mutex> lock(startMutex);
+   if (dispatchStarted.load(memory_order_acquire))
+      return true;
+   static bool forkHandlersInstalled = false;
+   if (!forkHandlersInstalled)
+   {
+      pthread_atfork(prepareFork, parentAfterFork, childAfterFork);
+      forkHandlersInstalled = true;
+   }
+   try
+   {
+      thread(dispatchLoop).detach();
+      dispatchStarted.store(true, memory_order_release);
+   }
+   catch (const exception &e)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "startDispatcher: failed to start subscription thread: %s\n", e.what());
+   }
+   return dispatchStarted.load(memory_order_acquire);
+}
+
+RFC_SubscriptionHandle_t subscribeRFCParameter(const char *pcPrefix, RFC_ChangeCallback_t callback, void *pUserData)
+{
+   if (pcPrefix == NULL || callback == NULL)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: prefix and callback are required\n", __FUNCTION__);
+      return 0;
+   }
+   rfcWatchStart();
+   if (!startDispatcher())
+      return 0;
+
+   SubscriptionPtr sub = make_shared<Subscription>();
+   sub->handle = nextHandle.fetch_add(1, memory_order_relaxed);
+   sub->prefix = pcPrefix;
+   sub->callback = callback;
+   sub->userData = pUserData;
+   sub->active.store(true, memory_order_relaxed);
+
+   // The baseline and the insertion happen between two dispatches, so a
+   // change is either part of the baseline or reported.
+   unique_lock<mutex> dispatchLock(dispatchMutex, defer_lock);
+   if (!onDispatcher)
+      dispatchLock.lock();
+   sub->storeView = readStoreView(sub->prefix);
+   sub->localView = filterView(readLocalStore(), sub->prefix);
+   {
+      lock_guard<mutex> lock(listMutex);
+      subscriptions[sub->handle] = sub;
+   }
+   RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: handle %lu watches %s\n", __FUNCTION__, sub->handle, pcPrefix);
+   return sub->handle;
+}
+
+bool unsubscribeRFCParameter(RFC_SubscriptionHandle_t handle)
+{
+   SubscriptionPtr sub;
+   {
+      lock_guard<mutex> lock(listMutex);
+      map<RFC_SubscriptionHandle_t, SubscriptionPtr>::iterator it = subscriptions.find(handle);
+      if (it == subscriptions.end())
+         return false;
+      sub = it->second;
+      subscriptions.erase(it);
+   }
+   sub->active.store(false, memory_order_release);
+   // Wait out a callback already running for it, unless we are that callback.
+   if (!onDispatcher)
+   {
+      lock_guard<mutex> dispatchLock(dispatchMutex);
+   }
+   return true;
+}
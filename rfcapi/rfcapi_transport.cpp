@@ -0,0 +1,107 @@
+/**
+ * @file rfcapi_transport.cpp
+ * @brief Choice between the hostif Unix domain socket and loopback TCP.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include "rfcapi_transport.h"
+#include "rfcapi_internal.h"
+#include "rdk_debug.h"
+using namespace std;
+
+#define RFC_HOSTIF_SOCKET_ENV "RFC_HOSTIF_SOCKET"
+/** Seconds to stay on TCP after the socket refused a connection. */
+#define RFC_SOCKET_RETRY_INTERVAL 30
+
+typedef chrono::steady_clock TransportClock;
+
+static mutex transportMutex;
+static string socketPath;
+static bool socketConfigured = false;         /**< setRFCHostifSocket() was called; the env var is ignored. */
+static bool socketFailed = false;
+static TransportClock::time_point retryAt;
+/** No socket is configured; lets every thread skip transportMutex on the common path. */
+static atomic<bool> tcpOnly(false);
+
+/** @brief Apply RFC_HOSTIF_SOCKET unless setRFCHostifSocket() was already called. Caller holds transportMutex. */
+static void readTransportEnvLocked()
+{
+   if (socketConfigured)
+      return;
+   socketConfigured = true;
+   const char *env = getenv(RFC_HOSTIF_SOCKET_ENV);
+   if (env && *env)
+   {
+      socketPath = env;
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: hostif socket %s from %s\n", __FUNCTION__, env, RFC_HOSTIF_SOCKET_ENV);
+   }
+   tcpOnly.store(socketPath.empty(), memory_order_release);
+}
+
+bool rfcTransportSocket(string *path)
+{
+   if (tcpOnly.load(memory_order_acquire))
+      return false;
+   string candidate;
+   {
+      lock_guard<mutex> lock(transportMutex);
+      readTransportEnvLocked();
+      if (socketPath.empty())
+         return false;
+      if (socketFailed)
+      {
+         if (TransportClock::now() < retryAt)
+            return false;
+         socketFailed = false;
+      }
+      candidate = socketPath;
+   }
+
+   // hostif creates the socket when it starts; until then TCP is the only way in.
+   struct stat st;
+   if (stat(candidate.c_str(), &st) != 0 || !S_ISSOCK(st.st_mode))
+      return false;
+   *path = candidate;
+   return true;
+}
+
+void rfcTransportSocketFailed()
+{
+   lock_guard<mutex> lock(transportMutex);
+   if (!socketFailed)
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: cannot connect to %s, using TCP for %d s\n", __FUNCTION__, socketPath.c_str(), RFC_SOCKET_RETRY_INTERVAL);
+   socketFailed = true;
+   retryAt = TransportClock::now() + chrono::seconds(RFC_SOCKET_RETRY_INTERVAL);
+}
+
+void setRFCHostifSocket(const char *pcPath)
+{
+   lock_guard<mutex> lock(transportMutex);
+   socketConfigured = true;
+   socketFailed = false;
+   socketPath = pcPath ? pcPath : "";
+   tcpOnly.store(socketPath.empty(), memory_order_release);
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: hostif socket %s\n", __FUNCTION__, socketPath.empty() ? "disabled" : socketPath.c_str());
+}
@@ -0,0 +1,44 @@
+/**
+ * @file rfcapi_transport.h
+ * @brief Internal choice between the hostif Unix domain socket and loopback TCP.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_TRANSPORT_H_
+#define RFCAPI_TRANSPORT_H_
+
+#include <string>
+#include "rfcapi.h"
+
+/**
+ * @brief Pick the transport for the next hostif request.
+ *
+ * Reads RFC_HOSTIF_SOCKET from the environment on first use.
+ * @param[out] path  Socket path when the Unix domain socket should be used.
+ * @retval true   Use the socket at @p path.
+ * @retval false  Use TCP (no socket configured, socket missing, or in back-off after a failure).
+ */
+bool rfcTransportSocket(std::string *path);
+
+/**
+ * @brief Record that connecting to the socket failed; TCP is used for a while.
+ */
+void rfcTransportSocketFailed();
+
+#endif
@@ -0,0 +1,322 @@
+/**
+ * @file rfcapi_watch.cpp
+ * @brief inotify based change tracking for the RFC store files.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include "rfcapi.h"
+#include "rfcapi_watch.h"
+#include "rfcapi_internal.h"
+#include "rdk_debug.h"
+
+#define WATCH_RETRY_INTERVAL 1
+#define WATCH_EVENT_MASK (IN_CLOSE_WRITE | IN_MODIFY | IN_MOVED_FROM | IN_MOVED_TO | IN_CREATE | IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF)
+
+static std::atomic<unsigned long> storeGeneration(1);
+static std::atomic<unsigned long> featureGeneration(1);
+static std::atomic<unsigned long> localGeneration(1);
+static std::atomic<unsigned long> changeSequence(1);
+static std::mutex changeMutex;
+/**
+ * Never destroyed: the subscription thread may still wait on it at exit, and glibc's destructor would block until it returns.
+ * A forked child gets a new one, since the parent's waiters are still recorded in it.
+ */
+static std::condition_variable *changeCond = new std::condition_variable;
+static std::atomic<bool> watchArmed(false);
+static std::atomic<bool> watchStarted(false);       /**< A watcher thread was started in this process. */
+static std::atomic<bool> restartAfterFork(false);   /**< This is a child of a process that had one; start ours when asked. */
+static std::mutex startMutex;
+
+/** Files in RFC_FEATURE_DIR whose changes invalidate cached parameters. */
+static const char *watchedFiles[] = { "tr181store.ini", "bootstrap.ini", "rfcVariable.ini" };
+
+static bool isWatchedFile(const char *name)
+{
+   for (size_t i = 0; i < sizeof(watchedFiles) / sizeof(watchedFiles[0]); i++)
+   {
+      if (strcmp(name, watchedFiles[i]) == 0)
+         return true;
+   }
+   return false;
+}
+
+/** @brief Bump @p generation and wake rfcWatchWait() callers. */
+static void bump(std::atomic<unsigned long> &generation)
+{
+   generation.fetch_add(1, std::memory_order_acq_rel);
+   {
+      // Taken so a waiter cannot miss the wakeup between its check and its wait.
+      std::lock_guard<std::mutex> lock(changeMutex);
+      changeSequence.fetch_add(1, std::memory_order_acq_rel);
+   }
+   changeCond->notify_all();
+}
+
+/** @brief Whether @p name is the local store snapshot or its journal. */
+static bool isLocalStoreFile(const char *name)
+{
+   return strcmp(name, TR181_LOCAL_STORE_NAME) == 0 || strcmp(name, TR181_LOCAL_STORE_JOURNAL_NAME) == 0;
+}
+
+/** @brief Whether @p name is a .RFC_<feature>.ini marker read by isRFCEnabled(). */
+static bool isFeatureFile(const char *name)
+{
+   size_t len = strlen(name);
+   return len > 9 && strncmp(name, ".RFC_", 5) == 0 && strcmp(name + len - 4, ".ini") == 0;
+}
+
+/** @brief Whether the local store lives outside RFC_FEATURE_DIR and needs its own watch. */
+static bool localStoreSeparate()
+{
+   return strcmp(TR181_LOCAL_STORE_DIR, RFC_FEATURE_DIR) != 0;
+}
+
+/**
+ * @brief Watcher thread body.
+ *
+ * (Re)establishes the directory watch, bumps the store generation on every
+ * event touching a store file, the local store generation on every event
+ * touching tr181localstore.ini or its journal and the feature generation on every event
+ * touching a feature marker, and drops back to the disarmed state if the
+ * directory itself goes away. A local store kept in another directory gets
+ * a second, best-effort watch, retried whenever the main watch is rearmed.
+ */
+static void watchLoop()
+{
+   int fd = inotify_init1(IN_CLOEXEC);
+   if (fd < 0)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: inotify_init1 failed, errno=%d. RFC caches stay disabled\n", __FUNCTION__, errno);
+      return;
+   }
+
+   bool logged = false;
+   for (;;)
+   {
+      int wd = inotify_add_watch(fd, RFC_FEATURE_DIR, WATCH_EVENT_MASK);
+      if (wd < 0)
+      {
+         if (!logged)
+         {
+            RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: cannot watch %s yet, errno=%d. Retrying\n", __FUNCTION__, RFC_FEATURE_DIR, errno);
+            logged = true;
+         }
+         sleep(WATCH_RETRY_INTERVAL);
+         continue;
+      }
+      logged = false;
+      int localWd = wd;
+      if (localStoreSeparate())
+      {
+         localWd = inotify_add_watch(fd, TR181_LOCAL_STORE_DIR, WATCH_EVENT_MASK);
+         if (localWd < 0)
+            RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: cannot watch %s, errno=%d\n", __FUNCTION__, TR181_LOCAL_STORE_DIR, errno);
+      }
+      // Anything may have changed while we were not watching.
+      watchArmed.store(true, std::memory_order_release);
+      bump(storeGeneration);
+      bump(localGeneration);
+      featureGeneration.fetch_add(1, std::memory_order_acq_rel);
+      RDK_LOG(RDK_LOG_DEBUG, LOG_RFCAPI, "%s: watching %s\n", __FUNCTION__, RFC_FEATURE_DIR);
+
+      bool rewatch = false;
+      char buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+      while (!rewatch)
+      {
+         ssize_t len = read(fd, buf, sizeof(buf));
+         if (len < 0)
+         {
+            if (errno == EINTR)
+               continue;
+            RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: inotify read failed, errno=%d\n", __FUNCTION__, errno);
+            watchArmed.store(false, std::memory_order_release);
+            bump(storeGeneration);
+            bump(localGeneration);
+            featureGeneration.fetch_add(1, std::memory_order_acq_rel);
+            close(fd);
+            return;
+         }
+
+         bool changed = false;
+         bool localChanged = false;
+         bool featuresChanged = false;
+         for (char *ptr = buf; ptr < buf + len; )
+         {
+            const struct inotify_event *event = (const struct inotify_event *)ptr;
+            if (event->wd != wd && event->wd == localWd)
+            {
+               // Only the separate local store directory can report these.
+               if (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF))
+               {
+                  localChanged = true;
+                  localWd = -1;
+               }
+               else if (event->len > 0 && isLocalStoreFile(event->name))
+               {
+                  localChanged = true;
+               }
+            }
+            else if (event->mask & (IN_IGNORED | IN_DELETE_SELF | IN_MOVE_SELF | IN_Q_OVERFLOW))
+            {
+               changed = true;
+               localChanged = true;
+               featuresChanged = true;
+               if (event->wd == wd && !(event->mask & IN_Q_OVERFLOW))
+                  rewatch = true;
+            }
+            else if (event->len > 0 && isWatchedFile(event->name))
+            {
+               changed = true;
+            }
+            else if (event->len > 0 && isLocalStoreFile(event->name))
+            {
+               localChanged = true;
+            }
+            else if (event->len > 0 && isFeatureFile(event->name))
+            {
+               featuresChanged = true;
+            }
+            ptr += sizeof(struct inotify_event) + event->len;
+         }
+
+         if (rewatch)
+         {
+            watchArmed.store(false, std::memory_order_release);
+            inotify_rm_watch(fd, wd);
+            if (localWd >= 0 && localWd != wd)
+               inotify_rm_watch(fd, localWd);
+         }
+         if (changed)
+            bump(storeGeneration);
+         if (localChanged)
+            bump(localGeneration);
+         if (featuresChanged)
+            featureGeneration.fetch_add(1, std::memory_order_acq_rel);
+      }
+   }
+}
+
+/* Threads do not survive fork(): the child must not trust the parent's watch, and must not inherit a held lock. */
+static void prepareFork()
+{
+   startMutex.lock();
+   changeMutex.lock();
+}
+
+static void parentAfterFork()
+{
+   changeMutex.unlock();
+   startMutex.unlock();
+}
+
+static void childAfterFork()
+{
+   changeMutex.unlock();
+   startMutex.unlock();
+   changeCond = new std::condition_variable;
+   watchArmed.store(false, std::memory_order_release);
+   if (watchStarted.load(std::memory_order_acquire))
+   {
+      watchStarted.store(false, std::memory_order_release);
+      restartAfterFork.store(true, std::memory_order_release);
+   }
+}
+
+void rfcWatchStart()
+{
+   if (watchStarted.load(std::memory_order_acquire))
+      return;
+   std::lock_guard<std::mutex> lock(startMutex);
+   if (watchStarted.load(std::memory_order_acquire))
+      return;
+   static bool forkHandlersInstalled = false;
+   if (!forkHandlersInstalled)
+   {
+      pthread_atfork(prepareFork, parentAfterFork, childAfterFork);
+      forkHandlersInstalled = true;
+   }
+   // Set even if the thread cannot be started, so a failure is not retried on every call.
+   watchStarted.store(true, std::memory_order_release);
+   restartAfterFork.store(false, std::memory_order_release);
+   try
+   {
+      std::thread(watchLoop).detach();
+   }
+   catch (const std::exception &e)
+   {
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "rfcWatchStart: failed to start watcher thread: %s\n", e.what());
+   }
+}
+
+bool rfcWatchArmed()
+{
+   if (watchArmed.load(std::memory_order_acquire))
+      return true;
+   // A forked child starts its own watcher the first time a cache asks.
+   if (restartAfterFork.load(std::memory_order_acquire))
+      rfcWatchStart();
+   return false;
+}
+
+unsigned long rfcStoreGeneration()
+{
+   return storeGeneration.load(std::memory_order_acquire);
+}
+
+void rfcStoreChanged()
+{
+   bump(storeGeneration);
+}
+
+unsigned long rfcLocalStoreGeneration()
+{
+   return localGeneration.load(std::memory_order_acquire);
+}
+
+unsigned long rfcWatchWait(unsigned long sequence, unsigned int timeoutMs)
+{
+   std::unique_lock<std::mutex> lock(changeMutex);
+   changeCond->wait_for(lock, std::chrono::milliseconds(timeoutMs), [sequence]() {
+      return changeSequence.load(std::memory_order_acquire) != sequence;
+   });
+   return changeSequence.load(std::memory_order_acquire);
+}
+
+unsigned long getRFCStoreGeneration(void)
+{
+   rfcWatchStart();
+   if (!watchArmed.load(std::memory_order_acquire))
+      return 0;
+   return storeGeneration.load(std::memory_order_acquire);
+}
+
+unsigned long rfcFeatureGeneration()
+{
+   return featureGeneration.load(std::memory_order_acquire);
+}
@@ -0,0 +1,81 @@
+/**
+ * @file rfcapi_watch.h
+ * @brief Internal RFC store change watcher used by the librfcapi caches.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_WATCH_H_
+#define RFCAPI_WATCH_H_
+
+/**
+ * @brief Start the background inotify watcher on the RFC store directory.
+ *
+ * Safe to call repeatedly; only the first call spawns the watcher thread.
+ * A child forked from a process with a watcher starts without one: it is
+ * disarmed, and starts its own on the next call here or to rfcWatchArmed().
+ */
+void rfcWatchStart();
+
+/**
+ * @brief Whether the watcher currently has a live inotify watch.
+ *
+ * Caches must not serve entries while this is false, since store updates
+ * would go unnoticed.
+ */
+bool rfcWatchArmed();
+
+/**
+ * @brief Current store generation.
+ *
+ * Bumped whenever rfcMgr/hostif rewrite one of the RFC store files, and on
+ * any local invalidation. Reading it costs one atomic load.
+ */
+unsigned long rfcStoreGeneration();
+
+/** @brief Force a generation bump (e.g. after a local set). */
+void rfcStoreChanged();
+
+/**
+ * @brief Current local store generation.
+ *
+ * Bumped whenever tr181localstore.ini or its journal (setLocalParam()) changes,
+ * and whenever the watch is (re)armed. Independent of rfcStoreGeneration(),
+ * so local settings do not invalidate the parameter caches.
+ */
+unsigned long rfcLocalStoreGeneration();
+
+/**
+ * @brief Block until the store or local store generation moves.
+ *
+ * Passing 0 returns the current sequence at once.
+ * @param[in] sequence   Sequence returned by the previous call.
+ * @param[in] timeoutMs  Upper bound on the wait.
+ * @return Current change sequence; equal to @p sequence on timeout.
+ */
+unsigned long rfcWatchWait(unsigned long sequence, unsigned int timeoutMs);
+
+/**
+ * @brief Current feature generation.
+ *
+ * Bumped whenever a .RFC_<feature>.ini marker is created, removed or renamed,
+ * and whenever the watch is (re)armed.
+ */
+unsigned long rfcFeatureGeneration();
+
+#endif
@@ -0,0 +1,520 @@
+/**
+ * @file rfcapi_writebehind.cpp
+ * @brief Journal of sets made before hostif is ready, replayed as one batch once it is.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * The journal is one append-only file shared by every process, so sets keep
+ * their order across processes as well. Each record carries a checksum, and
+ * reading stops at the first record that does not check out: a write torn by
+ * a crash loses only its own records. An append first cuts such a tail off,
+ * so no set lands where it could not be read. Appends and replays take an exclusive
+ * flock(); a replay that must keep some records writes them to a new file
+ * and renames it over the journal, so lock holders check that the file they
+ * locked is still the journal.
+ */
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <errno.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/file.h>
+#include <sys/stat.h>
+#include "rfcapi_writebehind.h"
+#include "rfcapi_hostif.h"
+#include "rfcapi_internal.h"
+#include "rfcapi_ready.h"
+#include "rfcapi_stats.h"
+#include "rfcapi_watch.h"
+#include "rdk_debug.h"
+using namespace std;
+
+#define JOURNAL_MAGIC 0x52464a31u   /* "RFJ1" */
+/** Bound on a replayed batch, so a stuck hostif does not hold the journal lock for long. */
+#define REPLAY_DEADLINE_MS 30000
+/** How long the replay thread waits for hostif before checking again. */
+#define REPLAY_WAIT_MS 60000
+/** Pause before retrying a replay that could not reach hostif. */
+#define REPLAY_RETRY_MS 5000
+/** Sanity bound on one field; anything larger is treated as corruption. */
+#define JOURNAL_FIELD_MAX (1024 * 1024)
+
+/** @brief On-disk record header, followed by the caller ID, name and value bytes. */
+struct JournalHeader
+{
+   uint32_t magic;
+   uint32_t checksum;   /**< FNV-1a of the header (with this field 0) and the three strings. */
+   uint32_t callerLen;
+   uint32_t nameLen;
+   uint32_t valueLen;
+   int32_t type;
+};
+
+/** @brief One queued set. */
+struct JournalEntry
+{
+   string callerID;
+   string name;
+   string value;
+   DATA_TYPE type;
+};
+
+/** @brief Last queued value of each name, for reads before hostif is ready. */
+struct JournalView
+{
+   dev_t dev;
+   ino_t ino;
+   off_t size;
+   struct timespec mtime;
+   unordered_map<string, pair<string, DATA_TYPE> > values;
+
+   JournalView() : dev(0), ino(0), size(-1)
+   {
+      mtime.tv_sec = 0;
+      mtime.tv_nsec = 0;
+   }
+};
+
+static atomic<int> writeBehindState(-1);   /**< -1 = not decided yet, 0 = off, 1 = on. */
+static mutex journalMutex;                 /**< Serialises this process's journal access; flock() covers the others. */
+static mutex viewMutex;
+static JournalView view;   /**< Guarded by viewMutex. */
+
+static mutex replayMutex;
+/**
+ * Never destroyed: the replay thread may still wait on it at exit, and glibc's destructor would block until it returns.
+ * Replaced in a forked child, where the parent's thread would never leave it.
+ */
+static condition_variable *replayCond = new condition_variable;
+static unsigned long appendSequence = 0;   /**< Bumped per append; guarded by replayMutex. */
+static bool replayStarted = false;         /**< A replay thread was started in this process; guarded by replayMutex. */
+static atomic<bool> restartAfterFork(false);   /**< Forked from a process with a replay thread; start ours when asked. */
+
+static uint32_t recordChecksum(JournalHeader header, const char *caller, const char *name, const char *value)
+{
+   header.checksum = 0;
+   uint32_t h = rfcHash(&header, sizeof(header));
+   h = rfcHash(caller, header.callerLen, h);
+   h = rfcHash(name, header.nameLen, h);
+   return rfcHash(value, header.valueLen, h);
+}
+
+static void appendRecord(string &buf, const char *caller, const char *name, const char *value, DATA_TYPE type)
+{
+   JournalHeader header;
+   header.magic = JOURNAL_MAGIC;
+   header.callerLen = (uint32_t)strlen(caller);
+   header.nameLen = (uint32_t)strlen(name);
+   header.valueLen = (uint32_t)strlen(value);
+   header.type = (int32_t)type;
+   header.checksum = recordChecksum(header, caller, name, value);
+   buf.append((const char *)&header, sizeof(header));
+   buf.append(caller, header.callerLen);
+   buf.append(name, header.nameLen);
+   buf.append(value, header.valueLen);
+}
+
+/**
+ * @brief Decode @p data into @p entries, stopping at the first damaged record.
+ * @return Bytes of @p data taken by the records decoded.
+ */
+static size_t parseRecords(const string &data, vector<JournalEntry> &entries)
+{
+   size_t pos = 0;
+   while (data.size() - pos >= sizeof(JournalHeader))
+   {
+      JournalHeader header;
+      memcpy(&header, data.data() + pos, sizeof(header));
+      if (header.magic != JOURNAL_MAGIC || header.callerLen > JOURNAL_FIELD_MAX || header.nameLen > JOURNAL_FIELD_MAX ||
+          header.valueLen > JOURNAL_FIELD_MAX)
+         break;
+      size_t len = sizeof(header) + header.callerLen + header.nameLen + header.valueLen;
+      if (data.size() - pos < len)
+         break;
+      const char *caller = data.data() + pos + sizeof(header);
+      const char *name = caller + header.callerLen;
+      const char *value = name + header.nameLen;
+      if (recordChecksum(header, caller, name, value) != header.checksum)
+         break;
+      JournalEntry entry;
+      entry.callerID.assign(caller, header.callerLen);
+      entry.name.assign(name, header.nameLen);
+      entry.value.assign(value, header.valueLen);
+      entry.type = (DATA_TYPE)header.type;
+      entries.push_back(entry);
+      pos += len;
+   }
+   if (pos != data.size())
+      RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: ignoring %zu damaged bytes at offset %zu of %s\n", __FUNCTION__,
+              data.size() - pos, pos, RFC_WRITE_BEHIND_FILE);
+   return pos;
+}
+
+/**
+ * @brief Open and flock() the journal, retrying if it is replaced meanwhile.
+ * @return Locked descriptor, or -1 (errno set) if the journal cannot be opened.
+ */
+static int openJournal(int flags, int lockOp)
+{
+   for (;;)
+   {
+      int fd = open(RFC_WRITE_BEHIND_FILE, flags | O_CLOEXEC, 0600);
+      if (fd < 0)
+         return -1;
+      int rc;
+      while ((rc = flock(fd, lockOp)) != 0 && errno == EINTR)
+         ;
+      struct stat locked, current;
+      if (rc == 0 && fstat(fd, &locked) == 0 && stat(RFC_WRITE_BEHIND_FILE, &current) == 0 &&
+          locked.st_dev == current.st_dev && locked.st_ino == current.st_ino)
+         return fd;
+      int err = errno;
+      close(fd);
+      if (rc != 0)
+      {
+         errno = err;
+         return -1;
+      }
+      // Replaced by a replay while we waited for the lock.
+   }
+}
+
+static bool journalEmpty()
+{
+   struct stat st;
+   return stat(RFC_WRITE_BEHIND_FILE, &st) != 0 || st.st_size == 0;
+}
+
+/** @brief Replace the journal with @p entries from @p from on, then the unparsed @p tail. Caller holds the lock on the current journal. */
+static bool rewriteJournal(const vector<JournalEntry> &entries, size_t from, const string &tail)
+{
+   string buf;
+   for (size_t i = from; i < entries.size(); i++)
+      appendRecord(buf, entries[i].callerID.c_str(), entries[i].name.c_str(), entries[i].value.c_str(), entries[i].type);
+   buf += tail;
+   string tmp = string(RFC_WRITE_BEHIND_FILE) + ".tmp";
+   int fd = open(tmp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+   if (fd < 0)
+      return false;
+   bool ok = rfcWriteAll(fd, buf) && fsync(fd) == 0;
+   close(fd);
+   if (!ok || rename(tmp.c_str(), RFC_WRITE_BEHIND_FILE) != 0)
+   {
+      unlink(tmp.c_str());
+      return false;
+   }
+   return true;
+}
+
+/** @brief Replay thread: wait for queued sets and for hostif, then send them. */
+static void replayLoop()
+{
+   unsigned long replayed = 0;
+   for (;;)
+   {
+      unsigned long sequence;
+      {
+         unique_lock<mutex> lock(replayMutex);
+         replayCond->wait(lock, [&replayed]() { return appendSequence != replayed; });
+         sequence = appendSequence;
+      }
+      if (!waitForRFCHostifReady(REPLAY_WAIT_MS))
+         continue;
+      if (rfcWriteBehindReplay())
+      {
+         replayed = sequence;
+      }
+      else
+      {
+         unique_lock<mutex> lock(replayMutex);
+         replayCond->wait_for(lock, chrono::milliseconds(REPLAY_RETRY_MS));
+      }
+   }
+}
+
+/* Threads do not survive fork(): the child must not inherit a held lock. A replay holds journalMutex for at most REPLAY_DEADLINE_MS. */
+static void prepareFork()
+{
+   journalMutex.lock();
+   viewMutex.lock();
+   replayMutex.lock();
+}
+
+static void parentAfterFork()
+{
+   replayMutex.unlock();
+   viewMutex.unlock();
+   journalMutex.unlock();
+}
+
+static void childAfterFork()
+{
+   replayMutex.unlock();
+   viewMutex.unlock();
+   journalMutex.unlock();
+   // The parent's replay thread is gone; the next wakeReplay() starts ours.
+   if (replayStarted)
+   {
+      replayCond = new condition_variable;
+      replayStarted = false;
+      restartAfterFork.store(true, memory_order_release);
+   }
+}
+
+/** @brief Start the replay thread if needed, and tell it there is something to send. */
+static void wakeReplay()
+{
+   {
+      lock_guard<mutex> lock(replayMutex);
+      if (!replayStarted)
+      {
+         static bool forkHandlersInstalled = false;
+         if (!forkHandlersInstalled)
+         {
+            pthread_atfork(prepareFork, parentAfterFork, childAfterFork);
+            forkHandlersInstalled = true;
+         }
+         // Set even if the thread cannot be started, so a failure is not retried on every set.
+         replayStarted = true;
+         restartAfterFork.store(false, memory_order_release);
+         try
+         {
+            thread(replayLoop).detach();
+         }
+         catch (const exception &e)
+         {
+            RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "wakeReplay: failed to start replay thread: %s\n", e.what());
+         }
+      }
+      appendSequence++;
+   }
+   replayCond->notify_all();
+}
+
+bool rfcWriteBehindEnabled()
+{
+   int state = writeBehindState.load(memory_order_acquire);
+   if (state < 0)
+   {
+      const char *env = getenv("RFC_WRITE_BEHIND");
+      bool enable = env != NULL && strcmp(env, "1") == 0;
+      int expected = -1;
+      if (writeBehindState.compare_exchange_strong(expected, enable ? 1 : 0) && enable && !journalEmpty())
+         wakeReplay();
+      state = writeBehindState.load(memory_order_acquire);
+   }
+   // A forked child replays what its parent left queued, in case the parent exits first.
+   if (state == 1 && restartAfterFork.exchange(false, memory_order_acq_rel) && !journalEmpty())
+      wakeReplay();
+   return state == 1;
+}
+
+bool rfcWriteBehindAppend(const char *pcCallerID, const RFC_SetParamData_t *pstParams, const vector<size_t> &pending)
+{
+   string buf;
+   for (size_t j = 0; j < pending.size(); j++)
+   {
+      const RFC_SetParamData_t &param = pstParams[pending[j]];
+      appendRecord(buf, pcCallerID ? pcCallerID : "Unknown", param.name, param.value, param.type);
+   }
+
+   bool ok = false;
+   {
+      lock_guard<mutex> lock(journalMutex);
+      int fd = openJournal(O_RDWR | O_APPEND | O_CREAT, LOCK_EX);
+      if (fd < 0)
+      {
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot open %s, errno=%d\n", __FUNCTION__, RFC_WRITE_BEHIND_FILE, errno);
+         return false;
+      }
+      string data;
+      vector<JournalEntry> entries;
+      ok = rfcReadAll(fd, data);
+      size_t goodEnd = parseRecords(data, entries);
+      if (ok && goodEnd < data.size())
+      {
+         // A write torn by a crash; records after it would never be read.
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: dropping %zu damaged bytes at the end of %s\n", __FUNCTION__,
+                 data.size() - goodEnd, RFC_WRITE_BEHIND_FILE);
+         ok = ftruncate(fd, (off_t)goodEnd) == 0;
+      }
+      if (ok && !(rfcWriteAll(fd, buf) && fsync(fd) == 0))
+      {
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot write %s, errno=%d\n", __FUNCTION__, RFC_WRITE_BEHIND_FILE, errno);
+         // Do not leave part of the batch behind.
+         if (ftruncate(fd, (off_t)goodEnd) != 0)
+            RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot truncate %s, errno=%d\n", __FUNCTION__, RFC_WRITE_BEHIND_FILE, errno);
+         ok = false;
+      }
+      close(fd);
+   }
+   if (!ok)
+      return false;
+
+   rfcStatsNote(RFC_STATS_FROM_FILE);
+   RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: queued %zu set(s) until hostif is ready\n", __FUNCTION__, pending.size());
+   wakeReplay();
+   return true;
+}
+
+bool rfcWriteBehindReplay()
+{
+   if (!rfcHostifReady())
+      return false;
+   if (journalEmpty())
+      return true;
+
+   lock_guard<mutex> lock(journalMutex);
+   int fd = openJournal(O_RDWR, LOCK_EX);
+   if (fd < 0)
+      return errno == ENOENT;
+
+   string data;
+   vector<JournalEntry> entries;
+   size_t parsed = 0;
+   if (rfcReadAll(fd, data))
+      parsed = parseRecords(data, entries);
+
+   // One POST per run of sets from the same caller; normally the whole journal.
+   size_t sent = 0;
+   bool reached = true;
+   while (sent < entries.size() && reached)
+   {
+      size_t end = sent;
+      while (end < entries.size() && entries[end].callerID == entries[sent].callerID)
+         end++;
+      vector<RFC_SetParamData_t> params(end - sent);
+      vector<size_t> pending(end - sent);
+      vector<WDMP_STATUS> status(end - sent, WDMP_FAILURE);
+      for (size_t i = sent; i < end; i++)
+      {
+         params[i - sent].name = entries[i].name.c_str();
+         params[i - sent].value = entries[i].value.c_str();
+         params[i - sent].type = entries[i].type;
+         pending[i - sent] = i - sent;
+      }
+      RfcHostifResult res = rfcHostifSetRequest(entries[sent].callerID.c_str(), &params[0], pending, &status[0], REPLAY_DEADLINE_MS);
+      if (res == RFC_HOSTIF_UNREACHABLE || res == RFC_HOSTIF_TIMEOUT)
+      {
+         // Try again later; repeating a set that did arrive is harmless.
+         reached = false;
+         break;
+      }
+      for (size_t i = 0; i < params.size(); i++)
+      {
+         if (res != RFC_HOSTIF_OK || status[i] != WDMP_SUCCESS)
+            RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: queued set of %s from %s failed: request %d, status %d\n", __FUNCTION__,
+                    params[i].name, entries[sent].callerID.c_str(), res, status[i]);
+      }
+      sent = end;
+   }
+
+   if (sent > 0)
+   {
+      // Only what was parsed and sent goes; the next append drops a damaged tail, and says so.
+      bool ok = sent == entries.size() && parsed == data.size() ? ftruncate(fd, 0) == 0 && fsync(fd) == 0
+                                                                : rewriteJournal(entries, sent, data.substr(parsed));
+      if (!ok)
+         RDK_LOG(RDK_LOG_ERROR, LOG_RFCAPI, "%s: cannot update %s, errno=%d\n", __FUNCTION__, RFC_WRITE_BEHIND_FILE, errno);
+      RDK_LOG(RDK_LOG_INFO, LOG_RFCAPI, "%s: replayed %zu of %zu queued set(s)\n", __FUNCTION__, sent, entries.size());
+   }
+   close(fd);
+   if (sent > 0)
+      rfcStoreChanged();
+   return reached;
+}
+
+bool rfcWriteBehindLookupValue(const char *pcParameterName, char *pcValue, size_t capacity, size_t *pLength, DATA_TYPE *peType)
+{
+   if (!rfcWriteBehindEnabled())
+      return false;
+   struct stat st;
+   if (stat(RFC_WRITE_BEHIND_FILE, &st) != 0 || st.st_size == 0)
+      return false;
+
+   lock_guard<mutex> lock(viewMutex);
+   if (st.st_dev != view.dev || st.st_ino != view.ino || st.st_size != view.size ||
+       st.st_mtim.tv_sec != view.mtime.tv_sec || st.st_mtim.tv_nsec != view.mtime.tv_nsec)
+   {
+      view.values.clear();
+      view.size = -1;
+      int fd = openJournal(O_RDONLY, LOCK_SH);
+      if (fd < 0)
+         return false;
+      string data;
+      vector<JournalEntry> entries;
+      struct stat locked;
+      if (fstat(fd, &locked) == 0 && rfcReadAll(fd, data))
+      {
+         parseRecords(data, entries);
+         for (size_t i = 0; i < entries.size(); i++)
+            view.values[entries[i].name] = make_pair(entries[i].value, entries[i].type);
+         view.dev = locked.st_dev;
+         view.ino = locked.st_ino;
+         view.size = locked.st_size;
+         view.mtime = locked.st_mtim;
+      }
+      close(fd);
+   }
+
+   unordered_map<string, pair<string, DATA_TYPE> >::const_iterator it = view.values.find(pcParameterName);
+   if (it == view.values.end())
+      return false;
+   *pLength = rfcCopyValue(pcValue, capacity, it->second.first.c_str(), it->second.first.size());
+   *peType = it->second.second;
+   return true;
+}
+
+void setRFCWriteBehindEnabled(bool enable)
+{
+   writeBehindState.store(enable ? 1 : 0, memory_order_release);
+   if (enable && !journalEmpty())
+      wakeReplay();
+}
+
+size_t getRFCWriteBehindPending(void)
+{
+   lock_guard<mutex> lock(journalMutex);
+   int fd = openJournal(O_RDONLY, LOCK_SH);
+   if (fd < 0)
+      return 0;
+   string data;
+   vector<JournalEntry> entries;
+   if (rfcReadAll(fd, data))
+      parseRecords(data, entries);
+   close(fd);
+   return entries.size();
+}
+
+bool flushRFCWriteBehind(unsigned int timeoutMs)
+{
+   if (journalEmpty())
+      return true;
+   return waitForRFCHostifReady(timeoutMs) && rfcWriteBehindReplay();
+}
@@ -0,0 +1,69 @@
+/**
+ * @file rfcapi_writebehind.h
+ * @brief Internal journal of sets made before hostif is ready, replayed once it is.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef RFCAPI_WRITEBEHIND_H_
+#define RFCAPI_WRITEBEHIND_H_
+
+#include <vector>
+#include "rfcapi.h"
+
+/**
+ * @brief Whether sets are queued while hostif is not ready.
+ *
+ * Decided on first use from RFC_WRITE_BEHIND, or set with
+ * setRFCWriteBehindEnabled(). One atomic load afterwards.
+ */
+bool rfcWriteBehindEnabled();
+
+/**
+ * @brief Append sets to the journal, and have them replayed once hostif is ready.
+ * @param[in] pcCallerID  Caller identifier, sent with the replay.
+ * @param[in] pstParams   Parameters to set.
+ * @param[in] pending     Indexes into @p pstParams to queue.
+ * @retval true   Queued and synced to disk.
+ * @retval false  The journal could not be written; nothing was queued.
+ */
+bool rfcWriteBehindAppend(const char *pcCallerID, const RFC_SetParamData_t *pstParams, const std::vector<size_t> &pending);
+
+/**
+ * @brief Send queued sets to hostif, if it is ready.
+ *
+ * Called before a new set is sent, so that earlier sets are applied first.
+ * Costs one stat() when the journal is empty.
+ * @retval true   hostif is ready and the journal is empty.
+ * @retval false  hostif is not ready, or could not be reached; the journal is kept.
+ */
+bool rfcWriteBehindReplay();
+
+/**
+ * @brief Look up the last queued value of a parameter.
+ * @param[in]  pcParameterName  TR181 parameter name.
+ * @param[out] pcValue          Value, NUL-terminated and truncated to @p capacity.
+ * @param[in]  capacity         Size of @p pcValue.
+ * @param[out] pLength          Full value length, excluding the NUL.
+ * @param[out] peType           Type the value was set with.
+ * @retval true   A set of @p pcParameterName is waiting in the journal.
+ * @retval false  None is.
+ */
+bool rfcWriteBehindLookupValue(const char *pcParameterName, char *pcValue, size_t capacity, size_t *pLength, DATA_TYPE *peType);
+
+#endif
@@ -0,0 +1,315 @@
+/**
+ * @file rfcflag.h
+ * @brief Typed C++ accessors for RFC parameters, e.g. rfc::Flag<> and rfc::Param<int>.
+ *
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2026 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ * A parameter is fetched and parsed on first use, then again only after
+ * getRFCStoreGeneration() moves, or RFCFLAG_RETRY_INTERVAL after a failed
+ * read. Until then reading it costs one call that returns an integer, and
+ * one compare:
+ *
+ * @code
+ * static rfc::Flag<> airplay("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Airplay.Enable");
+ * static rfc::Param<int> retries("Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.Foo.Retries", 3);
+ * if (airplay) ...
+ * for (int i = 0; i < retries.get(); i++) ...
+ * @endcode
+ *
+ * Objects with static storage duration are constant-initialised, so the
+ * name hash is computed by the compiler. Header-only; needs C++11.
+ */
+
+#ifndef RFCFLAG_H_
+#define RFCFLAG_H_
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <errno.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <strings.h>
+#include "rfcapi.h"
+
+/** Delay before a parameter whose read failed is read again, in ms. */
+#define RFCFLAG_RETRY_INTERVAL 1000
+
+namespace rfc
+{
+
+/** @brief FNV-1a hash of a NUL-terminated string, usable in constant expressions. */
+constexpr uint32_t hash(const char *str, uint32_t h = 2166136261u)
+{
+   return *str ? hash(str + 1, (h ^ (uint32_t)(unsigned char)*str) * 16777619u) : h;
+}
+
+/** @brief A TR181 parameter name and its compile-time hash. */
+struct Name
+{
+   constexpr Name(const char *name) : str(name), key(hash(name)) {}
+   const char *str;
+   uint32_t key;
+};
+
+namespace detail
+{
+
+/** @brief Fetch @p name; returns false if it has no usable value. */
+inline bool fetch(const char *callerId, const char *name, std::string &value)
+{
+   char buf[MAX_PARAM_LEN];
+   size_t len = sizeof(buf);
+   WDMP_STATUS status = getRFCParameterValue(callerId, name, buf, &len, NULL);
+   if (status != WDMP_SUCCESS && status != WDMP_ERR_DEFAULT_VALUE)
+      return false;
+   value.assign(buf, len);
+   return true;
+}
+
+inline long long nowMs()
+{
+   return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+inline bool parse(const std::string &text, bool &out)
+{
+   if (strcasecmp(text.c_str(), "true") == 0 || text == "1")
+      out = true;
+   else if (strcasecmp(text.c_str(), "false") == 0 || text == "0")
+      out = false;
+   else
+      return false;
+   return true;
+}
+
+inline bool parse(const std::string &text, long long &out)
+{
+   char *end = NULL;
+   errno = 0;
+   long long v = strtoll(text.c_str(), &end, 0);
+   if (text.empty() || *end != '\0' || errno != 0)
+      return false;
+   out = v;
+   return true;
+}
+
+inline bool parse(const std::string &text, unsigned long long &out)
+{
+   char *end = NULL;
+   errno = 0;
+   unsigned long long v = strtoull(text.c_str(), &end, 0);
+   if (text.empty() || text[0] == '-' || *end != '\0' || errno != 0)
+      return false;
+   out = v;
+   return true;
+}
+
+inline bool parse(const std::string &text, double &out)
+{
+   char *end = NULL;
+   errno = 0;
+   double v = strtod(text.c_str(), &end);
+   if (text.empty() || *end != '\0' || errno != 0)
+      return false;
+   out = v;
+   return true;
+}
+
+/** @brief Parse an integer type through the widest type of its signedness, rejecting out-of-range values. */
+template <typename T>
+inline bool parseInt(const std::string &text, T &out, long long)
+{
+   long long v;
+   if (!parse(text, v) || v < (long long)std::numeric_limits<T>::min() || v > (long long)std::numeric_limits<T>::max())
+      return false;
+   out = (T)v;
+   return true;
+}
+
+template <typename T>
+inline bool parseInt(const std::string &text, T &out, unsigned long long)
+{
+   unsigned long long v;
+   if (!parse(text, v) || v > (unsigned long long)std::numeric_limits<T>::max())
+      return false;
+   out = (T)v;
+   return true;
+}
+
+template <typename T>
+inline bool parse(const std::string &text, T &out)
+{
+   static_assert(std::is_integral<T>::value, "rfc::Param supports bool, integer, floating point and std::string values");
+   typedef typename std::conditional<std::is_signed<T>::value, long long, unsigned long long>::type Wide;
+   return parseInt(text, out, Wide());
+}
+
+inline bool parse(const std::string &text, float &out)
+{
+   double v;
+   if (!parse(text, v))
+      return false;
+   out = (float)v;
+   return true;
+}
+
+} // namespace detail
+
+/**
+ * @class Param
+ * @brief Cached, typed view of one RFC parameter.
+ *
+ * Thread-safe. The fallback is returned while the parameter cannot be read
+ * or its value does not parse as @p T. A value that does not parse is kept
+ * until the store generation moves; a failed read is retried after
+ * RFCFLAG_RETRY_INTERVAL.
+ * @tparam T  bool, an integer type, float, double or std::string.
+ */
+template <typename T>
+class Param
+{
+public:
+   /**
+    * @param[in] name      TR181 parameter name; must outlive the object (normally a literal).
+    * @param[in] fallback  Value used when the parameter is missing or malformed.
+    * @param[in] callerId  Caller identifier passed to getRFCParameterValue().
+    */
+   constexpr Param(Name name, T fallback = T(), const char *callerId = "rfcflag")
+      : name_(name), fallback_(fallback), callerId_(callerId), generation_(0), value_(fallback), retryGeneration_(0), retryAt_(0) {}
+
+   /** @brief Current value. */
+   T get() const
+   {
+      unsigned long generation = getRFCStoreGeneration();
+      if (generation != 0 && generation_.load(std::memory_order_acquire) == generation)
+         return value_.load(std::memory_order_relaxed);
+      return refresh(generation);
+   }
+
+   operator T() const { return get(); }
+
+   const char *name() const { return name_.str; }
+
+   /** @brief Compile-time hash of name(). */
+   constexpr uint32_t key() const { return name_.key; }
+
+private:
+   Param(const Param &);
+   Param &operator=(const Param &);
+
+   T refresh(unsigned long generation) const
+   {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (generation != 0 && generation_.load(std::memory_order_relaxed) == generation)
+         return value_.load(std::memory_order_relaxed);
+      long long now = detail::nowMs();
+      if (retryGeneration_ == generation && now < retryAt_)
+         return fallback_;
+      std::string text;
+      T value = fallback_;
+      if (!detail::fetch(callerId_, name_.str, text))
+      {
+         // Not pinned to this generation: a timeout or a restarting hostif does not move it.
+         value_.store(value, std::memory_order_relaxed);
+         generation_.store(0, std::memory_order_release);
+         retryGeneration_ = generation;
+         retryAt_ = now + RFCFLAG_RETRY_INTERVAL;
+         return value;
+      }
+      detail::parse(text, value);
+      // Published after the value, so readers matching the generation see at least this value.
+      value_.store(value, std::memory_order_relaxed);
+      generation_.store(generation, std::memory_order_release);
+      return value;
+   }
+
+   const Name name_;
+   const T fallback_;
+   const char *callerId_;
+   mutable std::mutex mutex_;                       /**< Serialises refreshes. */
+   mutable std::atomic<unsigned long> generation_;  /**< Store generation value_ was read at; 0 = never. */
+   mutable std::atomic<T> value_;
+   mutable unsigned long retryGeneration_;          /**< Generation of the last failed read. */
+   mutable long long retryAt_;                      /**< Earliest retry of that read, from detail::nowMs(). */
+};
+
+/** @brief std::string values are copied out under the object's lock. */
+template <>
+class Param<std::string>
+{
+public:
+   Param(Name name, const std::string &fallback = std::string(), const char *callerId = "rfcflag")
+      : name_(name), fallback_(fallback), callerId_(callerId), generation_(0), value_(fallback), retryGeneration_(0), retryAt_(0) {}
+
+   std::string get() const
+   {
+      unsigned long generation = getRFCStoreGeneration();
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (generation == 0 || generation_ != generation)
+      {
+         long long now = detail::nowMs();
+         if (retryGeneration_ == generation && now < retryAt_)
+            return fallback_;
+         std::string text;
+         if (detail::fetch(callerId_, name_.str, text))
+         {
+            value_ = text;
+            generation_ = generation;
+         }
+         else
+         {
+            value_ = fallback_;
+            generation_ = 0;
+            retryGeneration_ = generation;
+            retryAt_ = now + RFCFLAG_RETRY_INTERVAL;
+         }
+      }
+      return value_;
+   }
+
+   operator std::string() const { return get(); }
+
+   const char *name() const { return name_.str; }
+
+   uint32_t key() const { return name_.key; }
+
+private:
+   Param(const Param &);
+   Param &operator=(const Param &);
+
+   const Name name_;
+   const std::string fallback_;
+   const char *callerId_;
+   mutable std::mutex mutex_;
+   mutable unsigned long generation_;
+   mutable std::string value_;
+   mutable unsigned long retryGeneration_;
+   mutable long long retryAt_;
+};
+
+/** @brief Boolean feature switch ("true"/"false", "1"/"0"). */
+template <typename T = bool>
+using Flag = Param<T>;
+
+} // namespace rfc
+
+#endif
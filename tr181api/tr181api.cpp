@@ -20,12 +20,13 @@
 #include "tr181api.h"
 #include <wdmp-c.h>
 #include "rfcapi.h"
-#include "semaphore.h"
+#include "rfcapi_localstore.h"
 #include <fcntl.h>
 #include <unistd.h>
 #include "rdk_debug.h"
 #include <fstream>
-#include <unordered_map>
+#include <map>
+#include <vector>
 
 #define TR181_CLEAR_PARAM "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.ClearParam"
 
@@ -38,7 +39,6 @@
 #define RFCDEFAULTS_ETC_DIR "/etc/rfcdefaults/"
 #define LOG_TR181API  "LOG.RDK.TR181API"
 using namespace std;
-const char *semName = "localstore";
 
 #ifdef TR181API_LOGGING
 static ofstream logofs;
@@ -59,6 +59,18 @@ static string prefix()
     strftime(buffer, 50, "rfcapi:%Y-%m-%d %H:%M:%S ", tm_info);
     return string(buffer);
 }
+
+static void logStoreContent()
+{
+    std::map<std::string, std::string> content;
+    rfcLocalStoreRead(&content);
+    logofs << prefix() << "store content after write:\n";
+    for (std::map<std::string, std::string>::const_iterator it = content.begin(); it != content.end(); ++it)
+        logofs << it->first << "=" << it->second << "\n";
+
+    logofs.flush();
+    logofs.close();
+}
 #endif
 
 TR181_PARAM_TYPE getType(DATA_TYPE type)
@@ -102,13 +114,15 @@ tr181ErrorCode_t getErrorCode(WDMP_STATUS status)
 
 tr181ErrorCode_t getParam(char *pcCallerID, const char* pcParameterName, TR181_ParamData_t *pstParamData)
 {
-   RFC_ParamData_t param;
-   WDMP_STATUS wdmpStatus = getRFCParameter(pcCallerID, pcParameterName, &param);
+   // Read straight into the caller's struct, without an intermediate RFC_ParamData_t.
+   size_t length = sizeof(pstParamData->value);
+   DATA_TYPE type = WDMP_NONE;
+   WDMP_STATUS wdmpStatus = getRFCParameterValue(pcCallerID, pcParameterName, pstParamData->value, &length, &type);
+   if (wdmpStatus == WDMP_STATUS_RESOURCES && length >= sizeof(pstParamData->value))
+      wdmpStatus = WDMP_SUCCESS; // Longer values are truncated to MAX_PARAM_LEN, as before.
    if (wdmpStatus == WDMP_SUCCESS || wdmpStatus == WDMP_ERR_DEFAULT_VALUE)
    {
-      pstParamData->type = getType(param.type);
-      strncpy(pstParamData->value, param.value, MAX_PARAM_LEN);
-      pstParamData->value[MAX_PARAM_LEN - 1] = '\0';
+      pstParamData->type = getType(type);
       return tr181Success;
    }
 
@@ -220,6 +234,22 @@ tr181ErrorCode_t getDefaultValue(char *pcCallerID, const char* pcParameterName,
        RDK_LOG (RDK_LOG_ERROR, LOG_TR181API, "%s: pcCallerID is NULL\n", __FUNCTION__);
        return tr181Failure;
    }
+   // Binary search in the compiled /etc/rfcdefaults snapshot instead of scanning the file.
+   RFC_ParamData_t param;
+   WDMP_STATUS wdmpStatus = getRFCDefaultValue(pcCallerID, pcParameterName, &param);
+   if (wdmpStatus == WDMP_SUCCESS)
+   {
+      strncpy(pstParamData->value, param.value, MAX_PARAM_LEN);
+      pstParamData->value[MAX_PARAM_LEN - 1] = '\0';
+      pstParamData->type = TR181_NONE; //The caller must know what type they are expecting
+      return tr181Success;
+   }
+   if (wdmpStatus == WDMP_ERR_VALUE_IS_EMPTY)
+      return tr181ValueIsEmpty;
+   if (wdmpStatus == WDMP_FAILURE)
+      return tr181Failure;
+
+   // No snapshot could be compiled, read the component file directly.
    char defaultsFilename[256] = RFCDEFAULTS_ETC_DIR;
    strncat(defaultsFilename, pcCallerID, sizeof(defaultsFilename) - strlen(RFCDEFAULTS_ETC_DIR) - 5);
    strncat(defaultsFilename, ".ini", sizeof(defaultsFilename) - strlen(defaultsFilename) - 1);
@@ -228,166 +258,172 @@ tr181ErrorCode_t getDefaultValue(char *pcCallerID, const char* pcParameterName,
 
 tr181ErrorCode_t setValue(const char* pcParameterName, const char* pcParamValue)
 {
-    string key(pcParameterName), value(pcParamValue);
-
-    std::unordered_map<std::string, std::string> m_dict;
-
 #ifdef TR181API_LOGGING
    openLogFile();
-
-    logofs << prefix() << "paramName=" << key << " value=" << value << "\n";
-    std::ifstream f1(TR181_LOCAL_STORE_FILE);
-    if (f1.is_open())
-        logofs << prefix() << "file content before write:\n" << f1.rdbuf();
+    logofs << prefix() << "paramName=" << pcParameterName << " value=" << pcParamValue << "\n";
 #endif
 
-    ifstream ifs_tr181(TR181_LOCAL_STORE_FILE);
-    if (!ifs_tr181.is_open()) {
-        RDK_LOG (RDK_LOG_INFO, LOG_TR181API, "%s: Trying to open a non-existent file [%s] \n", __FUNCTION__, TR181_LOCAL_STORE_FILE);
-    }
-    else
-    {
-        string line;
-        while (getline(ifs_tr181, line)) {
-            size_t splitterPos = line.find('=');
-            if (splitterPos < line.length()) {
-                string key = line.substr(0, splitterPos);
-                string value = line.substr(splitterPos+1, line.length());
-                m_dict[key] = value;
-                RDK_LOG(RDK_LOG_INFO, LOG_TR181API, "Key = %s : Value = %s\n", key.c_str(), value.c_str());
-            }
-        }
-        ifs_tr181.close();
-    }
-
-    if (!key.compare(TR181_CLEAR_PARAM))
-    {
-        bool foundInLocalStore = false;
-        unordered_map<string, string> temp_local_dict(m_dict);
-
-        for (unordered_map<string, string>::iterator it=temp_local_dict.begin(); it!=temp_local_dict.end(); ++it)
-        {
-            //Check if the param to be cleared is present in tr181localstore.ini
-            //(Or) if the param to be cleared is a wild card, clear all the params from local store that match with the wild card.
-            if(!it->first.compare(value) ||  (value.back() == '.' && it->first.find(value) != string::npos) )
-            {
-                RDK_LOG(RDK_LOG_INFO, LOG_TR181API, "Clearing param: %s\n", it->first.c_str());
-                m_dict.erase(it->first);
-                foundInLocalStore = true;
-            }
-        }
-        if (!foundInLocalStore)
-        {
-            RDK_LOG(RDK_LOG_INFO, LOG_TR181API, "Key %s not present. Nothing to clear.\n", value.c_str());
-            return tr181Success;
-        }
-    }
+    // Appended to the local store journal; the whole file is only rewritten on compaction.
+    bool ok;
+    if (!strcmp(pcParameterName, TR181_CLEAR_PARAM))
+        ok = rfcLocalStoreClear(pcParamValue, NULL);
     else
+        ok = rfcLocalStoreSet(pcParameterName, pcParamValue);
+    if (!ok)
     {
-        m_dict[key] = std::move(value);
-    }
-
-    FILE *f = fopen(TR181_LOCAL_STORE_FILE, "w");
-    if (f == NULL)
-    {
-        RDK_LOG (RDK_LOG_ERROR, LOG_TR181API, "Failed to open : %s \n", TR181_LOCAL_STORE_FILE);
+        RDK_LOG (RDK_LOG_ERROR, LOG_TR181API, "Failed to update : %s \n", TR181_LOCAL_STORE_FILE);
         return tr181Failure;
     }
 
-    for (unordered_map<string, string>::iterator it=m_dict.begin(); it!=m_dict.end(); ++it)
-    {
-        fprintf(f, "%s=%s\n", it->first.c_str(), it->second.c_str());
-    }
-    fflush(f);
-    fsync(fileno(f));
-    fclose(f);
-
 #ifdef TR181API_LOGGING
-    std::ifstream f2(TR181_LOCAL_STORE_FILE);
-    if (f2.is_open())
-        logofs << prefix() << "file content after write:\n" << f2.rdbuf()  << "\n";
-
-    logofs.flush();
-    logofs.close();
+    logStoreContent();
 #endif
 
     return tr181Success;
 }
 
-tr181ErrorCode_t getLocalParam(char *pcCallerID, const char* pcParameterName, TR181_ParamData_t *pstParamData)
+/** @brief Copy a value found in the local store, with getValue()'s results. */
+static tr181ErrorCode_t copyLocalValue(const char* pcParameterName, const string &value, TR181_ParamData_t *pstParam)
 {
-    tr181ErrorCode_t status = tr181Failure;
-    sem_t *sem_id = sem_open(semName, O_CREAT, 0600, 1);
-    if (sem_id == SEM_FAILED){
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_open failed \n", __FUNCTION__);
-        return tr181Failure;
-    }
+    RDK_LOG(RDK_LOG_INFO, LOG_TR181API, "Found Key = %s : Value = %s\n", pcParameterName, value.c_str());
+    if (value.empty())
+        return tr181ValueIsEmpty;
+    pstParam->type = TR181_NONE; //The caller must know what type they are expecting
+    strncpy(pstParam->value, value.c_str(), MAX_PARAM_LEN);
+    pstParam->value[MAX_PARAM_LEN - 1] = '\0';
+    return tr181Success;
+}
 
-    if (sem_wait(sem_id) < 0)
-    {
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_wait failed \n", __FUNCTION__);
-    }
+/** @brief Look up a parameter in the local store, with getValue()'s results. */
+static tr181ErrorCode_t getLocalValue(const char* pcParameterName, TR181_ParamData_t *pstParam)
+{
+    string value;
+    if (!rfcLocalStoreGet(pcParameterName, &value))
+        return tr181Failure;
+    return copyLocalValue(pcParameterName, value, pstParam);
+}
 
-    status = getValue(TR181_LOCAL_STORE_FILE, pcParameterName, pstParamData);
+tr181ErrorCode_t getLocalParam(char *pcCallerID, const char* pcParameterName, TR181_ParamData_t *pstParamData)
+{
+    // Lock-free: the local store never shows a half-written change.
+    tr181ErrorCode_t status = getLocalValue(pcParameterName, pstParamData);
     if (status != tr181Success)
         status = getDefaultValue(pcCallerID, pcParameterName, pstParamData);
+    return status;
+}
 
-    if (sem_post(sem_id) < 0)
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_post failed \n", __FUNCTION__);
+tr181ErrorCode_t setLocalParam(char *pcCallerID, const char* pcParameterName, const char* pcParameterValue)
+{
+    // Writers are serialized by the local store's own lock.
+    return setValue(pcParameterName, pcParameterValue);
+}
 
-    if (sem_close(sem_id) != 0){
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_close failed \n", __FUNCTION__);
-    }
-   return status;
+tr181ErrorCode_t clearLocalParam(char *pcCallerID, const char* pcParameterName)
+{
+    return setValue(TR181_CLEAR_PARAM, pcParameterName);
 }
 
-tr181ErrorCode_t setLocalParam(char *pcCallerID, const char* pcParameterName, const char* pcParameterValue)
+tr181ErrorCode_t getLocalParams(char *pcCallerID, const char** ppcParameterNames, size_t count, TR181_ParamData_t *pstParamData, tr181ErrorCode_t *peStatus)
 {
-    tr181ErrorCode_t status = tr181Failure;
-    sem_t *sem_id = sem_open(semName, O_CREAT, 0600, 1);
-    if (sem_id == SEM_FAILED){
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_open failed \n", __FUNCTION__);
+    if (count > 0 && (ppcParameterNames == NULL || pstParamData == NULL || peStatus == NULL))
+    {
+        RDK_LOG (RDK_LOG_ERROR, LOG_TR181API, "%s: invalid arguments\n", __FUNCTION__);
         return tr181Failure;
     }
-
-    if (sem_wait(sem_id) < 0)
-    { 
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_wait failed \n", __FUNCTION__);
+    // One look at the store for every name; only the misses go to the defaults.
+    vector<string> values;
+    vector<bool> found;
+    rfcLocalStoreGetMany(ppcParameterNames, count, &values, &found);
+    tr181ErrorCode_t ret = tr181Success;
+    for (size_t i = 0; i < count; i++)
+    {
+        if (ppcParameterNames[i] == NULL)
+            peStatus[i] = tr181InvalidParameterName;
+        else
+        {
+            peStatus[i] = found[i] ? copyLocalValue(ppcParameterNames[i], values[i], &pstParamData[i]) : tr181Failure;
+            if (peStatus[i] != tr181Success)
+                peStatus[i] = getDefaultValue(pcCallerID, ppcParameterNames[i], &pstParamData[i]);
+        }
+        if (ret == tr181Success)
+            ret = peStatus[i];
     }
+    return ret;
+}
 
-    status = setValue(pcParameterName, pcParameterValue);
-
-    if (sem_post(sem_id) < 0)
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_post failed \n", __FUNCTION__);
-
-    if (sem_close(sem_id) != 0){
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_close failed \n", __FUNCTION__);
+tr181ErrorCode_t getLocalParamTree(char *pcCallerID, const char* pcPrefix, TR181_ParamCallback_t callback, void *pUserData)
+{
+    if (pcPrefix == NULL || callback == NULL)
+    {
+        RDK_LOG (RDK_LOG_ERROR, LOG_TR181API, "%s: invalid arguments\n", __FUNCTION__);
+        return tr181Failure;
+    }
+    // Only the subtree is read, found by binary search in the local store.
+    std::map<std::string, std::string> content;
+    rfcLocalStoreReadTree(pcPrefix, &content);
+    TR181_ParamData_t param;
+    param.type = TR181_NONE; //The caller must know what type they are expecting
+    for (std::map<std::string, std::string>::const_iterator it = content.begin(); it != content.end(); ++it)
+    {
+        strncpy(param.value, it->second.c_str(), MAX_PARAM_LEN);
+        param.value[MAX_PARAM_LEN - 1] = '\0';
+        callback(it->first.c_str(), &param, pUserData);
     }
-   return status;
+    RDK_LOG(RDK_LOG_INFO, LOG_TR181API, "%s: %zu parameter(s) under %s\n", __FUNCTION__, content.size(), pcPrefix);
+    return content.empty() ? tr181Failure : tr181Success;
 }
 
-tr181ErrorCode_t clearLocalParam(char *pcCallerID, const char* pcParameterName)
+tr181ErrorCode_t syncLocalParams(char *pcCallerID)
 {
-    tr181ErrorCode_t status = tr181Failure;
-    sem_t *sem_id = sem_open(semName, O_CREAT, 0600, 1);
-    if (sem_id == SEM_FAILED){
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_open failed \n", __FUNCTION__);
+    if (!rfcLocalStoreCompact())
+    {
+        RDK_LOG (RDK_LOG_ERROR, LOG_TR181API, "%s: could not write %s, changes stay in the journal\n", __FUNCTION__, TR181_LOCAL_STORE_FILE);
         return tr181Failure;
     }
+    return tr181Success;
+}
 
-    if (sem_wait(sem_id) < 0)
-    { 
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_wait failed \n", __FUNCTION__);
+tr181ErrorCode_t setLocalParams(char *pcCallerID, const char** ppcParameterNames, const char** ppcParameterValues, size_t count)
+{
+    if (count > 0 && (ppcParameterNames == NULL || ppcParameterValues == NULL))
+    {
+        RDK_LOG (RDK_LOG_ERROR, LOG_TR181API, "%s: invalid arguments\n", __FUNCTION__);
+        return tr181Failure;
+    }
+    vector<RfcLocalChange> changes(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        if (ppcParameterNames[i] == NULL || ppcParameterValues[i] == NULL)
+        {
+            RDK_LOG (RDK_LOG_ERROR, LOG_TR181API, "%s: entry %zu is NULL, nothing set\n", __FUNCTION__, i);
+            return tr181Failure;
+        }
+#ifdef TR181API_LOGGING
+        openLogFile();
+        logofs << prefix() << "paramName=" << ppcParameterNames[i] << " value=" << ppcParameterValues[i] << "\n";
+#endif
+        // Same meaning as in setValue(): the value names what to clear.
+        if (!strcmp(ppcParameterNames[i], TR181_CLEAR_PARAM))
+        {
+            changes[i].name = ppcParameterValues[i];
+            changes[i].value = NULL;
+        }
+        else
+        {
+            changes[i].name = ppcParameterNames[i];
+            changes[i].value = ppcParameterValues[i];
+        }
+    }
+    // All or nothing, with one journal append and one fsync; tr181localstore.ini is only rewritten at compaction.
+    if (count > 0 && !rfcLocalStoreUpdate(&changes[0], count))
+    {
+        RDK_LOG (RDK_LOG_ERROR, LOG_TR181API, "Failed to update : %s \n", TR181_LOCAL_STORE_FILE);
+        return tr181Failure;
     }
 
-    status = setValue(TR181_CLEAR_PARAM, pcParameterName);
-
-    if (sem_post(sem_id) < 0)
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_post failed \n", __FUNCTION__);
+#ifdef TR181API_LOGGING
+    logStoreContent();
+#endif
 
-    if (sem_close(sem_id) != 0){
-        RDK_LOG(RDK_LOG_ERROR, LOG_TR181API, "%s: sem_close failed \n", __FUNCTION__);
-    }
-   return status;
+    return tr181Success;
 }
-
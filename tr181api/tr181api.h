@@ -87,6 +87,20 @@ tr181ErrorCode_t setLocalParam(char *pcCallerID, const char* pcParameterName, co
 //NOTE: To clear whole domain/feature, pass the wild card parameter to pcParameterName. eg. clearParam("sysint", "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.TelemetryEndpoint.");
 tr181ErrorCode_t clearLocalParam(char *pcCallerID, const char* pcParameterName);
 
+//NOTE: setLocalParams applies all count name/value pairs as one change: readers, and a restart after a crash, see all of them or none.
+//      getLocalParams resolves each name like getLocalParam, filling pstParamData[i] and peStatus[i]; it returns tr181Success or the first failing status.
+tr181ErrorCode_t setLocalParams(char *pcCallerID, const char** ppcParameterNames, const char** ppcParameterValues, size_t count);
+tr181ErrorCode_t getLocalParams(char *pcCallerID, const char** ppcParameterNames, size_t count, TR181_ParamData_t *pstParamData, tr181ErrorCode_t *peStatus);
+
+//NOTE: getLocalParamTree reports every local store parameter under pcPrefix (e.g. "Device.DeviceInfo.X_RDKCENTRAL-COM_RFC.Feature.MyApp."), in name order.
+//      Defaults are not consulted and values may be empty. It returns tr181Success if at least one parameter was reported.
+typedef void (*TR181_ParamCallback_t)(const char *pcParameterName, const TR181_ParamData_t *pstParamData, void *pUserData);
+tr181ErrorCode_t getLocalParamTree(char *pcCallerID, const char* pcPrefix, TR181_ParamCallback_t callback, void *pUserData);
+
+//NOTE: Local sets and clears are journaled; tr181localstore.ini itself only catches up when the journal is compacted, or when a process that wrote exits.
+//      syncLocalParams compacts now, for scripts that read the file directly. The tr181 utility calls it after each localOnly set.
+tr181ErrorCode_t syncLocalParams(char *pcCallerID);
+
 tr181ErrorCode_t getDefaultValue(char *pcCallerID, const char* pcParameterName, TR181_ParamData_t *pstParamData);
 #if defined(GTEST_ENABLE)
 tr181ErrorCode_t setValue(const char* pcParameterName, const char* pcParamValue);
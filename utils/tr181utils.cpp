@@ -35,6 +35,7 @@
 #include <iostream>
 #include <string>
 #include <fstream>
+#include <vector>
 #include "rfcapi.h"
 #include "tr181api.h"
 #include "trsetutils.h"
@@ -49,6 +50,7 @@ static char * key = NULL;
 static char * id = NULL;
 static REQ_TYPE mode = GET;
 static bool silent = true;
+static bool stats = false;
 
 inline bool legacyRfcEnabled() {
     ifstream f("/opt/RFC/.RFC_LegacyRFCEnabled.ini");
@@ -179,6 +181,9 @@ static int setAttribute(char * const paramName  ,char type, char * value)
 {
    if (id && !strncmp(id, "localOnly", 9)) {
       int status = setLocalParam(id, paramName, value);
+      // Scripts read tr181localstore.ini directly; do not leave this set only in the journal.
+      if(status == 0)
+         status = syncLocalParams(id);
       if(status == 0)
       {
          cout << __FUNCTION__ << " >> Set Local Param success! " << endl;
@@ -227,13 +232,70 @@ static int clearAttribute(char * const paramName)
    return status;
 }
 
+#if !defined(RDKB_SUPPORT) && !defined(RDKC)
+static void collectStats(const RFC_CallerStats_t *pstStats, void *pUserData)
+{
+   ((vector<RFC_CallerStats_t> *)pUserData)->push_back(*pstStats);
+}
+
+static bool moreCalls(const RFC_CallerStats_t &a, const RFC_CallerStats_t &b)
+{
+   return a.calls > b.calls;
+}
+
+/**
+* Upper bound, in microseconds, of the latency bucket holding a percentile
+* @param [in] entry counters of one caller and operation
+* @param [in] percent percentile to look up
+*/
+static unsigned long long latencyPercentile(const RFC_CallerStats_t &entry, unsigned percent)
+{
+   unsigned long long target = (entry.calls * percent + 99) / 100;
+   unsigned long long seen = 0;
+   for (int i = 0; i < RFC_STATS_LATENCY_BUCKETS; i++)
+   {
+      seen += entry.latency[i];
+      if (seen >= target)
+         return 2ULL << i;
+   }
+   return 2ULL << (RFC_STATS_LATENCY_BUCKETS - 1);
+}
+
+/**
+* Prints the librfcapi call statistics of all processes, busiest callers first
+* @return 0 if statistics were found, 1 otherwise
+*/
+static int showStats()
+{
+   vector<RFC_CallerStats_t> entries;
+   if (getRFCCallerStats(collectStats, &entries) != WDMP_SUCCESS)
+   {
+      cout << "No RFC call statistics. Export RFC_STATS=1 or create /opt/rfcapi_stats.enable, then restart the callers." << endl;
+      return 1;
+   }
+   sort(entries.begin(), entries.end(), moreCalls);
+   printf("%-32s %-9s %10s %10s %8s %8s %8s %10s %10s %10s\n",
+          "CallerID", "Operation", "Calls", "Hostif", "File", "Memory", "Errors", "Avg(us)", "p50(us)", "p99(us)");
+   for (size_t i = 0; i < entries.size(); i++)
+   {
+      const RFC_CallerStats_t &e = entries[i];
+      printf("%-32s %-9s %10llu %10llu %8llu %8llu %8llu %10llu %10llu %10llu\n",
+             e.callerID, getRFCStatsOpName(e.op), e.calls, e.hostif, e.file, e.memory, e.errors,
+             e.calls ? e.totalUs / e.calls : 0, latencyPercentile(e, 50), latencyPercentile(e, 99));
+   }
+   return 0;
+}
+#endif
+
 /**
 * Prints the usage of this app
 */
 static void showusage(const char *exename)
 {
    cout << "Usage : " << exename << "[-d] [-g] [-s] [-v value] ParamName\n" <<
+      "       " << exename << " --stats\n" <<
       "-d debug enable\n-g get operation\n-s set operation\n-v value of parameter\n" <<
+      "--stats print RFC API call statistics per caller\n" <<
       "If -s option is set -v is mandatory, otherwise -g option is default\n" <<
       "eg:\n" << exename << " Device.DeviceInfo.X_RDKCENTRAL-COM_xBlueTooth.Enabled\n" <<
       exename << " -s -v XG1 Device.DeviceInfo.X_RDKCENTRAL-COM_PreferredGatewayType\n" <<
@@ -245,7 +307,12 @@ static int parseargs(int argc, char * argv[])
     int i = 1;
     while ( i < argc )
     {
-        if(strncasecmp(argv[i], "-s", 2) == 0)
+        if(strcasecmp(argv[i], "--stats") == 0)
+        {
+            stats = true;
+            i ++;
+        }
+        else if(strncasecmp(argv[i], "-s", 2) == 0)
         {
             mode = SET;
             i ++;
@@ -297,6 +364,14 @@ static int parseargs(int argc, char * argv[])
 #ifndef GTEST_ENABLE
 int main(int argc, char *argv [])
 {
+   parseargs(argc,argv);
+#if !defined(RDKB_SUPPORT) && !defined(RDKC)
+   if(stats)
+   {
+      return showStats();
+   }
+#endif
+
    if(legacyRfcEnabled() == true)
    {
       return trsetutil(argc,argv);
@@ -306,8 +381,6 @@ int main(int argc, char *argv [])
    ofstream void_file;
    int retcode = 1;
 
-   parseargs(argc,argv);
-
    if(NULL == key || (mode == SET && NULL == value))
    {
       showusage(argv[0]);
@@ -384,5 +457,10 @@ int (*getparseargsFunc())(int argc, char * argv[])
     return &parseargs;
 }
 
+int (*getShowStatsFunc())()
+{
+    return &showStats;
+}
+
 #endif
 